@@ -29,6 +29,8 @@
 "        Performs plastic sideband scaling, subtracts backgrounds, performs unfolding, applies efficiency x \n"\
 "        acceptance correction, divides by flux and number of nucleons and if option is selected .\n"\
 "        Writes a .root file with the cross section histograms\n"\
+"        Also saves the histogram from each step in <target>_extractionPlots.root.  Run PlotExtractionSteps on it to\n"\
+"        draw them.\n"\
 "        To run for a single playlist (for example 1A) simply pass /path/to/dirs/1A as the directory path\n\n"\
 " Usage: Extract1DCrossSectionTargets_ByTargetNew <unfolding iterations> <directory> <target> <pdg>\n"\
 "        e.g:   Extract1DCrossSectionTargets_ByTargetNew 5 /path/to/dirs 2026 14 -- to extract xsecs for target 2 Iron over neutrino-mode playlists with 5 iterations\n"\
@@ -36,13 +38,17 @@
 "        e.g:   Extract1DCrossSectionTargets_ByTargetNew 10 /path/to/dirs iron -14 -- to extract xsecs for the combined iron targets over the antineutrino-mode playlists with 10 iterations\n"\
 "        e.g:   Extract1DCrossSectionTargets_ByTargetNew 5 /path/to/dirs all 14 -- to extract xsecs for all targets over the neutrino-mode playlists with 5 iterations\n"\
 "        e.g:   Extract1DCrossSectionTargets_ByTargetNew 10 /path/to/dirs WaterFull -14 -- to extract xsecs for the water target over the antineutrino-mode playlists with the water target filled with 10 iterations\n"\
-"        e.g:   Extract1DCrossSectionTargets_ByTargetNew 10 /path/to/dirs WaterEmpty -14 -- to extract xsecs for the water target over the antineutrino-mode playlists with the water target empty with 10 iterations\n\n"\
+"        e.g:   Extract1DCrossSectionTargets_ByTargetNew 10 /path/to/dirs WaterEmpty -14 -- to extract xsecs for the water target over the antineutrino-mode playlists with the water target empty with 10 iterations\n"\
+"        e.g:   Extract1DCrossSectionTargets_ByTargetNew 5,1-20 /path/to/dirs 2026 14 -- as above with 5 iterations, but also writes the cross sections for 1 to 20 iterations\n"\
+"               to <target><prefix>_iterationScan.root. The file loading, sideband fit and background subtraction are only done once.\n\n"\
 
 // Author: Akeem Hart a.l.hart@qmul.ac.uk based on original ExtractCrossSection.cpp by Andrew Olivier aolivier@ur.rochester.edu
 
 
 // util includes
 #include "util/GetIngredient.h"
+#include "util/SparseMigration.h"
+#include "util/ScaledChi2.h"
 
 // UnfoldUtils includes
 #pragma GCC diagnostic push
@@ -61,6 +67,7 @@
 // ROOT includes
 #include "TH1D.h"
 #include "TFile.h"
+#include "TROOT.h"
 #include "TKey.h"
 #include "TParameter.h"
 #include "TCanvas.h"
@@ -82,6 +89,7 @@
 #include <exception>
 #include <algorithm>
 #include <numeric>
+#include <memory>
 #include <filesystem>
 
 // Convince the STL to talk to TIter so I can use std::find_if()
@@ -133,18 +141,13 @@ double GetTotalScatteringCenters(int targetZ, bool isMC)
 }
 
 
-PlotUtils::MnvH1D *g_combinedMCHist, *g_dataHist;
+// Same chi2 as MnvPlotter::Chi2DataMC(data, mc, ndof, scale, true, true), but the covariance is only factored once per sideband
+std::unique_ptr<util::ScaledChi2> g_sidebandChi2;
 
 
 double getChi2( const double * val )
 {
-    double scale  = val[0];
-    int ndof;
-    PlotUtils::MnvPlotter plotter;
-    plotter.ApplyStyle(PlotUtils::kCCQENuInclusiveStyle);
-    auto tmpHist = g_dataHist->Clone();
-    double chiSq = plotter.Chi2DataMC(tmpHist, g_combinedMCHist, ndof, scale, true, true);
-    return chiSq;
+    return (*g_sidebandChi2)(val[0]);
 }
 
 bool isNumber(const std::string& str) {
@@ -157,24 +160,13 @@ bool isNumber(const std::string& str) {
 }
 
 // Plot a step in cross section extraction.
+// Snapshots of each step's histograms for PlotExtractionSteps to draw later.  Drawing them here took longer than
+// extracting the cross sections.
+std::unique_ptr<TFile> g_plotSnapshots;
+
 void Plot(PlotUtils::MnvH1D &hist, const std::string &stepName, const std::string &prefix, const std::string &target)
 {
-  //return;
-  bool plotpngs = true;
-  TCanvas can(stepName.c_str());
-  hist.GetCVHistoWithError().Clone()->Draw();
-  if (plotpngs) can.Print((target + "_" + prefix + "_" + stepName + ".png").c_str());
-
-  // Uncertainty summary
-  PlotUtils::MnvPlotter plotter;
-  plotter.ApplyStyle(PlotUtils::kCCQENuInclusiveStyle);
-  plotter.axis_maximum = 0.4;
-
-  plotter.DrawErrorSummary(&hist);
-  if (plotpngs) can.Print((target + "_" + prefix + "_" + stepName + "_uncertaintySummary.png").c_str());
-
-  plotter.DrawErrorSummary(&hist, "TR", true, true, 1e-5, false, "Other");
-  if (plotpngs) can.Print((target + "_" + prefix + "_" + stepName + "_otherUncertainties.png").c_str());
+  if (g_plotSnapshots) g_plotSnapshots->WriteTObject(&hist, (target + "_" + prefix + "_" + stepName).c_str());
 }
 
 // Unfolding function from Aaron Bercelle
@@ -239,6 +231,49 @@ PlotUtils::MnvH1D *normalize(PlotUtils::MnvH1D *efficiencyCorrected, PlotUtils::
   return efficiencyCorrected;
 }
 
+// Unfold the same background subtracted distributions with each requested number of iterations and write the
+// resulting cross sections side by side. Everything upstream of the unfolding is shared with the nominal extraction,
+// and the nominal cross sections are written as they are instead of being unfolded again.  MnvUnfold doesn't give
+// back the intermediate Bayesian iterations, so every other number of iterations is its own unfolding.
+void ScanIterations(const std::vector<int> &iterations, PlotUtils::MnvH1D *bkgSubtracted, PlotUtils::MnvH1D *bkgScaledSubtracted, PlotUtils::MnvH2D *migration,
+                    PlotUtils::MnvH1D *efficiency, PlotUtils::MnvH1D *fluxIntegral, const double nNucleons, const double POT, const std::string &outFileName,
+                    PlotUtils::MnvH1D *nominalCrossSection, PlotUtils::MnvH1D *nominalCrossSectionTuned)
+{
+  auto scanFile = TFile::Open(outFileName.c_str(), "RECREATE");
+  if (!scanFile)
+    throw std::runtime_error("Could not create a file called " + outFileName + " for the iteration scan");
+
+  scanFile->cd();
+  const std::string nominalSuffix = "_" + std::to_string(iterations.front()) + "Iterations";
+  nominalCrossSection->Write(("crossSection" + nominalSuffix).c_str());
+  nominalCrossSectionTuned->Write(("crossSectionTuned" + nominalSuffix).c_str());
+
+  for (const int iter : iterations)
+  {
+    if (iter == iterations.front()) continue;
+    std::cout << "Iteration scan: unfolding with " << iter << " iterations\n";
+    auto unfolded = UnfoldHist(bkgSubtracted, migration, iter);
+    auto unfolded_tuned = UnfoldHist(bkgScaledSubtracted, migration, iter);
+    if (!unfolded || !unfolded_tuned)
+      throw std::runtime_error(std::string("Failed to unfold with ") + std::to_string(iter) + " iterations using " + migration->GetName());
+
+    unfolded->Divide(unfolded, efficiency);
+    unfolded_tuned->Divide(unfolded_tuned, efficiency);
+
+    scanFile->cd();
+    const std::string suffix = "_" + std::to_string(iter) + "Iterations";
+    normalize(unfolded, fluxIntegral, nNucleons, POT)->Write(("crossSection" + suffix).c_str());
+    normalize(unfolded_tuned, fluxIntegral, nNucleons, POT)->Write(("crossSectionTuned" + suffix).c_str());
+    delete unfolded;
+    delete unfolded_tuned;
+  }
+
+  TParameter<int> nominal("nIterationsNominal", iterations.front());
+  nominal.Write();
+  scanFile->Close();
+  delete scanFile;
+}
+
 int main(const int argc, const char **argv)
 {
 #ifndef NCINTEX
@@ -252,10 +287,31 @@ int main(const int argc, const char **argv)
     std::cerr << "Expected 4 arguments, but I got " << argc - 1 << ".\n" << HELP << std::endl;
     return 1;
   }
-  const int nIterations = std::stoi(argv[1]);
+  //The first number of iterations is the nominal one. Any others are only used for the iteration scan.
+  std::vector<int> iterations;
+  try
+  {
+    iterations = util::parseIterationList(std::string(argv[1]));
+  }
+  catch (const std::invalid_argument &e)
+  {
+    std::cerr << e.what() << ".\n" << HELP << std::endl;
+    return 1;
+  }
+  if (iterations.empty())
+  {
+    std::cerr << "Expected at least 1 number of unfolding iterations, but I got \"" << argv[1] << "\".\n" << HELP << std::endl;
+    return 1;
+  }
+  const int nIterations = iterations.front();
   std::string indir = std::string(argv[2]);
   std::string intgt = std::string(argv[3]);
   int pdg = std::stoi(argv[4]);
+
+  const std::string plotSnapshotName = intgt + "_extractionPlots.root";
+  g_plotSnapshots.reset(TFile::Open(plotSnapshotName.c_str(), "RECREATE"));
+  if (!g_plotSnapshots) std::cerr << "Failed to create " << plotSnapshotName << ", so there will be nothing to plot.\n";
+  gROOT->cd(); // Nothing else goes in the snapshot file
   
   std::vector<std::string> dirs = util::findContainingDirectories(indir, "Targets", true);
 
@@ -471,7 +527,7 @@ int main(const int argc, const char **argv)
 
             util::AddHist(*flux,util::GetIngredient<PlotUtils::MnvH1D>(*mcFile, (std::string("reweightedflux_integrated")), prefix), mcscale);
             util::AddHist(*folded,util::GetIngredient<PlotUtils::MnvH1D>(*dataFile, (std::string("data")), prefix), datascale);
-            util::AddHist(*migration,util::GetIngredient<PlotUtils::MnvH2D>(*mcFile, (std::string("migration")), prefix), mcscale);
+            util::AddHist(*migration,util::GetMigration(*mcFile, (std::string("migration")), prefix), mcscale);
             util::AddHist(*effNum,util::GetIngredient<PlotUtils::MnvH1D>(*mcFile, (std::string("efficiency_numerator")), prefix), mcscale);
             util::AddHist(*effDenom,util::GetIngredient<PlotUtils::MnvH1D>(*mcFile, (std::string("efficiency_denominator")), prefix), mcscale);
             util::AddHist(*effDenom2P2H,util::GetIngredient<PlotUtils::MnvH1D>(*mcFile, (std::string("efficiency_denominator_intChannels_2p2h")), prefix), mcscale);
@@ -683,8 +739,7 @@ int main(const int argc, const char **argv)
           combinedDS->Add(DSSidebandOther);
           combinedDS->Scale(dataPOT/mcPOT);
 
-          g_combinedMCHist = combinedUS;
-          g_dataHist = DataUSSideband;
+          g_sidebandChi2.reset(new util::ScaledChi2(*DataUSSideband, *combinedUS, true));
 
           //Plot(*combinedUS, "combinedUS", prefix, tgtname);
           //Plot(*DataUSSideband, "DataUSSideband", prefix, tgtname);
@@ -705,8 +760,7 @@ int main(const int argc, const char **argv)
             std::cout<<"Minised chisq for USSideband. Scale factor: " << USScaleFactor << " best chisq: " << bestChiSq << std::endl;
           }
 
-          g_combinedMCHist = combinedDS;
-          g_dataHist = DataDSSideband;
+          g_sidebandChi2.reset(new util::ScaledChi2(*DataDSSideband, *combinedDS, true));
           {          //DS Sideband
             ROOT::Math::Minimizer* minimizer = ROOT::Math::Factory::CreateMinimizer("Minuit2");
             minimizer->SetMaxFunctionCalls(1000000);
@@ -794,7 +848,8 @@ int main(const int argc, const char **argv)
         Plot(*bkgScaledSubtracted, "backgroundSubtractedScaled", prefix, tgtname);
         Plot(*sidebandScaledSubtracted, "sidebandScaledSubtracted", prefix, tgtname);
 
-        auto outFile = TFile::Open((tgtname + prefix + "_crossSection.root").c_str(), "RECREATE");
+        const std::string outFileBase = tgtname + prefix;
+        auto outFile = TFile::Open((outFileBase + "_crossSection.root").c_str(), "RECREATE");
         if (!outFile)
         {
           std::cerr << "Could not create a file called " << prefix + "_crossSection.root" << ".  Does it already exist?\n";
@@ -1020,6 +1075,12 @@ int main(const int argc, const char **argv)
         auto crossSectionTuned = normalize(unfolded_tuned, fluxIntReweighted, nnucleonsData, dataPOT);
         Plot(*crossSectionTuned, "crossSectionTuned", prefix, tgtname);
         crossSectionTuned->Write("crossSectionTuned");
+
+        if (iterations.size() > 1)
+        {
+          ScanIterations(iterations, bkgSubtracted, bkgScaledSubtracted, migration, effNum, fluxIntReweighted, nnucleonsData, dataPOT, outFileBase + "_iterationScan.root", crossSection, crossSectionTuned);
+          outFile->cd();
+        }
         simEventRate->Write("simulatedEventRate");
         fluxIntReweighted->Write("fluxIntReweighted");
 
@@ -2066,5 +2127,6 @@ int main(const int argc, const char **argv)
       delete MCDataOther;
     }
   }
+  g_plotSnapshots.reset(); // Close it before ROOT cleans up
   return 0;
 }
@@ -37,13 +37,17 @@
 "        e.g:   Extract1DCrossSectionTargets_ByTargetNew 10 /path/to/dirs iron -14 -- to extract xsecs for the combined iron targets over the antineutrino-mode playlists with 10 iterations\n"\
 "        e.g:   Extract1DCrossSectionTargets_ByTargetNew 5 /path/to/dirs all 14 -- to extract xsecs for all targets over the neutrino-mode playlists with 5 iterations\n"\
 "        e.g:   Extract1DCrossSectionTargets_ByTargetNew 10 /path/to/dirs WaterFull -14 -- to extract xsecs for the water target over the antineutrino-mode playlists with the water target filled with 10 iterations\n"\
-"        e.g:   Extract1DCrossSectionTargets_ByTargetNew 10 /path/to/dirs WaterEmpty -14 -- to extract xsecs for the water target over the antineutrino-mode playlists with the water target empty with 10 iterations\n\n"\
+"        e.g:   Extract1DCrossSectionTargets_ByTargetNew 10 /path/to/dirs WaterEmpty -14 -- to extract xsecs for the water target over the antineutrino-mode playlists with the water target empty with 10 iterations\n"\
+"        e.g:   Extract1DCrossSectionTargets_ByTargetNew 5,1-20 /path/to/dirs 2026 14 -- as above with 5 iterations, but also writes the cross sections for 1 to 20 iterations\n"\
+"               to <target><prefix>_iterationScan.root. The file loading, sideband fit and background subtraction are only done once.\n\n"\
 
 // Author: Akeem Hart a.l.hart@qmul.ac.uk based on original ExtractCrossSection.cpp by Andrew Olivier aolivier@ur.rochester.edu
 
 
 // util includes
 #include "util/GetIngredient.h"
+#include "util/SparseMigration.h"
+#include "util/ScaledChi2.h"
 
 // UnfoldUtils includes
 #pragma GCC diagnostic push
@@ -84,6 +88,7 @@
 #include <exception>
 #include <algorithm>
 #include <numeric>
+#include <memory>
 #include <filesystem>
 
 // Convince the STL to talk to TIter so I can use std::find_if()
@@ -135,18 +140,13 @@ double GetTotalScatteringCenters(int targetZ, bool isMC)
 }
 
 
-PlotUtils::MnvH1D *g_combinedMCHist, *g_dataHist;
+// Same chi2 as MnvPlotter::Chi2DataMC(data, mc, ndof, scale, true, true), but the covariance is only factored once per sideband
+std::unique_ptr<util::ScaledChi2> g_sidebandChi2;
 
 
 double getChi2( const double * val )
 {
-    double scale  = val[0];
-    int ndof;
-    PlotUtils::MnvPlotter plotter;
-    plotter.ApplyStyle(PlotUtils::kCCQENuInclusiveStyle);
-    auto tmpHist = g_dataHist->Clone();
-    double chiSq = plotter.Chi2DataMC(tmpHist, g_combinedMCHist, ndof, scale, true, true);
-    return chiSq;
+    return (*g_sidebandChi2)(val[0]);
 }
 
 
@@ -232,6 +232,50 @@ PlotUtils::MnvH2D *normalize(PlotUtils::MnvH2D *efficiencyCorrected, PlotUtils::
   return efficiencyCorrected;
 }
 
+// Unfold the same background subtracted distributions with each requested number of iterations and write the
+// resulting cross sections side by side. Everything upstream of the unfolding is shared with the nominal extraction,
+// and the nominal cross sections are written as they are instead of being unfolded again.  MnvUnfold doesn't give
+// back the intermediate Bayesian iterations, so every other number of iterations is its own unfolding.
+void ScanIterations(const std::vector<int> &iterations, PlotUtils::MnvH2D *bkgSubtracted, PlotUtils::MnvH2D *bkgScaledSubtracted, PlotUtils::MnvH2D *migration,
+                    PlotUtils::MnvH2D *migration_reco, PlotUtils::MnvH2D *migration_truth, PlotUtils::MnvH2D *efficiency, PlotUtils::MnvH2D *fluxIntegral,
+                    const double nNucleons, const double POT, const std::string &outFileName,
+                    PlotUtils::MnvH2D *nominalCrossSection, PlotUtils::MnvH2D *nominalCrossSectionTuned)
+{
+  auto scanFile = TFile::Open(outFileName.c_str(), "RECREATE");
+  if (!scanFile)
+    throw std::runtime_error("Could not create a file called " + outFileName + " for the iteration scan");
+
+  scanFile->cd();
+  const std::string nominalSuffix = "_" + std::to_string(iterations.front()) + "Iterations";
+  nominalCrossSection->Write(("crossSection" + nominalSuffix).c_str());
+  nominalCrossSectionTuned->Write(("crossSectionTuned" + nominalSuffix).c_str());
+
+  for (const int iter : iterations)
+  {
+    if (iter == iterations.front()) continue;
+    std::cout << "Iteration scan: unfolding with " << iter << " iterations\n";
+    auto unfolded = UnfoldHist(bkgSubtracted, migration, migration_reco, migration_truth, iter);
+    auto unfolded_tuned = UnfoldHist(bkgScaledSubtracted, migration, migration_reco, migration_truth, iter);
+    if (!unfolded || !unfolded_tuned)
+      throw std::runtime_error(std::string("Failed to unfold with ") + std::to_string(iter) + " iterations using " + migration->GetName());
+
+    unfolded->Divide(unfolded, efficiency);
+    unfolded_tuned->Divide(unfolded_tuned, efficiency);
+
+    scanFile->cd();
+    const std::string suffix = "_" + std::to_string(iter) + "Iterations";
+    normalize(unfolded, fluxIntegral, nNucleons, POT)->Write(("crossSection" + suffix).c_str());
+    normalize(unfolded_tuned, fluxIntegral, nNucleons, POT)->Write(("crossSectionTuned" + suffix).c_str());
+    delete unfolded;
+    delete unfolded_tuned;
+  }
+
+  TParameter<int> nominal("nIterationsNominal", iterations.front());
+  nominal.Write();
+  scanFile->Close();
+  delete scanFile;
+}
+
 int main(const int argc, const char **argv)
 {
 #ifndef NCINTEX
@@ -245,7 +289,23 @@ int main(const int argc, const char **argv)
     std::cerr << "Expected 4 arguments, but I got " << argc - 1 << ".\n" << HELP << std::endl;
     return 1;
   }
-  const int nIterations = std::stoi(argv[1]);
+  //The first number of iterations is the nominal one. Any others are only used for the iteration scan.
+  std::vector<int> iterations;
+  try
+  {
+    iterations = util::parseIterationList(std::string(argv[1]));
+  }
+  catch (const std::invalid_argument &e)
+  {
+    std::cerr << e.what() << ".\n" << HELP << std::endl;
+    return 1;
+  }
+  if (iterations.empty())
+  {
+    std::cerr << "Expected at least 1 number of unfolding iterations, but I got \"" << argv[1] << "\".\n" << HELP << std::endl;
+    return 1;
+  }
+  const int nIterations = iterations.front();
   std::string indir = std::string(argv[2]);
   std::string intgt = std::string(argv[3]);
   int pdg = std::stoi(argv[4]);
@@ -472,9 +532,10 @@ int main(const int argc, const char **argv)
 
 
             PlotUtils::MnvH2D* tmpfolded = util::GetIngredient<PlotUtils::MnvH2D>(*dataFile, (std::string("data")), prefix);
-            PlotUtils::MnvH2D* tmpmigration = util::GetIngredient<PlotUtils::MnvH2D>(*migFile, (std::string("migration")), prefix);
-            PlotUtils::MnvH2D* tmpmigration_reco = util::GetIngredient<PlotUtils::MnvH2D>(*migFile, (std::string("reco")), prefix);
-            PlotUtils::MnvH2D* tmpmigration_truth = util::GetIngredient<PlotUtils::MnvH2D>(*migFile, (std::string("truth")), prefix);
+            PlotUtils::MnvH2D* tmpmigration = nullptr;
+            PlotUtils::MnvH2D* tmpmigration_reco = nullptr;
+            PlotUtils::MnvH2D* tmpmigration_truth = nullptr;
+            util::GetMigrationObjects(*migFile, prefix, tmpmigration, tmpmigration_reco, tmpmigration_truth);
             PlotUtils::MnvH2D* tmpeffNum = util::GetIngredient<PlotUtils::MnvH2D>(*mcFile, (std::string("efficiency_numerator")), prefix);
             PlotUtils::MnvH2D* tmpeffDenom = util::GetIngredient<PlotUtils::MnvH2D>(*mcFile, (std::string("efficiency_denominator")), prefix);
             PlotUtils::MnvH2D* tmpeffDenom2P2H = util::GetIngredient<PlotUtils::MnvH2D>(*mcFile, (std::string("efficiency_denominator_intChannels_2p2h")), prefix);
@@ -662,8 +723,7 @@ int main(const int argc, const char **argv)
           combinedDS->Add(DSSidebandOther);
           combinedDS->Scale(dataPOT/mcPOT);
 
-          g_combinedMCHist = combinedUS;
-          g_dataHist = DataUSSideband;
+          g_sidebandChi2.reset(new util::ScaledChi2(*DataUSSideband, *combinedUS, true));
 
           //Plot(*combinedUS, "combinedUS", prefix, tgt);
           //Plot(*DataUSSideband, "DataUSSideband", prefix, tgt);
@@ -684,8 +744,7 @@ int main(const int argc, const char **argv)
             std::cout<<"Minised chisq for USSideband. Scale factor: " << USScaleFactor << " best chisq: " << bestChiSq << std::endl;
           }
 
-          g_combinedMCHist = combinedDS;
-          g_dataHist = DataDSSideband;
+          g_sidebandChi2.reset(new util::ScaledChi2(*DataDSSideband, *combinedDS, true));
           {          //DS Sideband
             ROOT::Math::Minimizer* minimizer = ROOT::Math::Factory::CreateMinimizer("Minuit2");
             minimizer->SetMaxFunctionCalls(1000000);
@@ -988,6 +1047,12 @@ int main(const int argc, const char **argv)
         auto crossSectionTuned = normalize(unfolded_tuned, fluxIntReweighted, nnucleonsData, dataPOT);
         Plot(*crossSectionTuned, "crossSectionTuned", prefix, tgt);
         crossSectionTuned->Write("crossSectionTuned");
+
+        if (iterations.size() > 1)
+        {
+          ScanIterations(iterations, bkgSubtracted, bkgScaledSubtracted, migration, migration_reco, migration_truth, effNum, fluxIntReweighted, nnucleonsData, dataPOT, tgt + prefix + "_iterationScan.root", crossSection, crossSectionTuned);
+          outFile->cd();
+        }
         simEventRate->Write("simulatedEventRate");
         fluxIntReweighted->Write("fluxIntReweighted");
 
@@ -0,0 +1,161 @@
+#define HELP \
+"\n*** Help: ***\n"\
+" File: MakeDerivedKinematics.cpp\n"\
+" Brief: Works out quantities that every event loop would otherwise recalculate from raw branches once per AnaTuple\n"\
+"        file and saves them as friend trees: Bjorken x and y, the ANN muon pT, the ANN segment Z positions, and\n"\
+"        target codes with and without the extended targets.  The kinematics are for the CV, and universes that\n"\
+"        don't shift the muon or recoil share them.  Lateral universes still calculate their own.\n"\
+"        runEventLoopTargets --derived-mc and --derived-data read them instead of recalculating.\n\n"\
+" Usage: MakeDerivedKinematics <playlist.txt> <output file> [reco tree name]\n"\
+"        e.g:   MakeDerivedKinematics PlaylistFiles/MC/1A.txt derivedMC1A.root\n"\
+"        The reco tree name is MasterAnaDev by default.  MC playlists also get the Truth tree's target codes.\n"\
+"        Friend files made from a playlist work for any subset of its files, like grid subruns.  Remake them\n"\
+"        when the AnaTuples change.\n\n"
+
+// Includes from this package
+#include "event/CVUniverse.h"
+#include "util/NukeUtils.h"
+#include "util/GetPlaylist.h"
+#include "util/InputFiles.h"
+#include "util/DerivedKinematics.h"
+
+// PlotUtils includes
+#include "PlotUtils/ChainWrapper.h"
+
+// ROOT includes
+#include "TFile.h"
+#include "TTree.h"
+
+// c++ includes
+#include <iostream>
+#include <memory>
+#include <vector>
+#include <string>
+#include <stdexcept>
+
+// Number of entries in treeName in each file.  Files without it contribute 0 entries just like they would to a chain.
+std::vector<Long64_t> countEntries(const std::vector<std::string> &files, const std::string &treeName)
+{
+  std::vector<Long64_t> entries;
+  for (const auto &fileName : files)
+  {
+    std::unique_ptr<TFile> file(TFile::Open(fileName.c_str(), "READ"));
+    auto tree = file ? dynamic_cast<TTree *>(file->Get(treeName.c_str())) : nullptr;
+    entries.push_back(tree ? tree->GetEntries() : 0);
+  }
+  return entries;
+}
+
+// Fills the friend trees for one AnaTuple tree.  Reco trees get every quantity, and trees with truth information also get
+// the truth target codes.
+void makeFriend(TFile &outFile, const std::vector<std::string> &files, const std::vector<Long64_t> &entries, const std::string &treeName,
+                const bool isReco, const bool hasTruth)
+{
+  PlotUtils::ChainWrapper chain(treeName.c_str());
+  for (const auto &fileName : files) chain.Add(fileName);
+  CVUniverse universe(&chain);
+
+  outFile.cd();
+  util::DerivedValues values;
+  auto tree = new TTree((treeName + util::derivedTreeSuffix).c_str(), ("Quantities derived from " + treeName).c_str()); // Owned by outFile
+  std::vector<util::DerivedBranch> branches;
+  if (isReco) branches = util::derivedRecoBranches(values);
+  if (hasTruth)
+  {
+    const auto truthBranches = util::derivedTruthBranches(values);
+    branches.insert(branches.end(), truthBranches.begin(), truthBranches.end());
+  }
+  for (const auto &branch : branches) tree->Branch(branch.name.c_str(), branch.address, (branch.name + "/" + branch.type).c_str());
+
+  const Long64_t nEntries = chain.GetEntries();
+  for (Long64_t i = 0; i < nEntries; ++i)
+  {
+    if (i % 1000 == 0) std::cout << treeName << ": " << i << " / " << nEntries << "\r" << std::flush;
+    universe.SetEntry(i);
+    if (isReco)
+    {
+      values.bjorkenX = universe.GetBjorkenX();
+      values.bjorkenY = universe.GetBjorkenY();
+      values.annMuonPTGeV = universe.GetANNMuonPTGeV();
+      values.annTgtCode = util::getTgtCode(&universe, false, false);
+      values.annTgtCodeExtended = util::getTgtCode(&universe, false, true);
+      const auto zPosScan = universe.GetANNSegmentsZPosScan();
+      values.annZPosSegment0 = zPosScan.zPosSegment0;
+      values.annZPosWeighted = zPosScan.zPosWeighted;
+      values.annFirstWeightedCutoff = zPosScan.firstWeightedCutoff;
+    }
+    if (hasTruth)
+    {
+      values.truthTgtCode = util::getTgtCode(&universe, true, false);
+      values.truthTgtCodeExtended = util::getTgtCode(&universe, true, true);
+    }
+    tree->Fill();
+  }
+  std::cout << treeName << ": " << nEntries << " / " << nEntries << "\n";
+
+  // Which files the entries came from so that a chain of any subset of them can find its entries
+  outFile.cd();
+  std::string file;
+  Long64_t fileEntries = 0;
+  auto filesTree = new TTree((treeName + util::derivedFilesTreeSuffix).c_str(), ("Entries in each file's " + treeName + " tree").c_str());
+  filesTree->Branch("file", &file);
+  filesTree->Branch("entries", &fileEntries, "entries/L");
+  for (size_t whichFile = 0; whichFile < files.size(); ++whichFile)
+  {
+    file = files[whichFile];
+    fileEntries = entries[whichFile];
+    filesTree->Fill();
+  }
+
+  tree->Write();
+  filesTree->Write();
+}
+
+int main(const int argc, const char **argv)
+{
+  if (argc < 3 || argc > 4)
+  {
+    std::cerr << "Expected a playlist file, an output file, and optionally a reco tree name.\n" << HELP << std::endl;
+    return 1;
+  }
+
+  const std::string recoTreeName = (argc == 4) ? argv[3] : "MasterAnaDev";
+  std::vector<std::string> files;
+  try
+  {
+    files = util::readPlaylistFiles(argv[1]);
+  }
+  catch (const std::runtime_error &e)
+  {
+    std::cerr << e.what() << "\n" << HELP << std::endl;
+    return 1;
+  }
+
+  const auto recoEntries = countEntries(files, recoTreeName), truthEntries = countEntries(files, "Truth");
+  bool isMC = false;
+  for (auto entries : truthEntries) isMC = isMC || entries > 0;
+
+  std::unique_ptr<TFile> outFile(TFile::Open(argv[2], "RECREATE"));
+  if (!outFile)
+  {
+    std::cerr << "Failed to create " << argv[2] << "\n";
+    return 4;
+  }
+
+  {
+    PlotUtils::ChainWrapper chain(recoTreeName.c_str());
+    for (const auto &fileName : files) chain.Add(fileName);
+    if (chain.GetEntries() == 0)
+    {
+      std::cerr << "No " << recoTreeName << " entries in " << argv[1] << "\n";
+      return 3;
+    }
+    PlotUtils::MinervaUniverse::SetPlaylist(util::GetPlaylist(chain, isMC));
+  }
+
+  makeFriend(*outFile, files, recoEntries, recoTreeName, true, isMC);
+  if (isMC) makeFriend(*outFile, files, truthEntries, "Truth", false, true);
+  outFile->Close();
+
+  return 0;
+}
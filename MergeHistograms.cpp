@@ -0,0 +1,162 @@
+#define HELP \
+"\n*** Help: ***\n"\
+" File: MergeHistograms.cpp\n"\
+" Brief: Merges the output files from runEventLoopTargets and friends like hadd does, but with a multithreaded tree\n"\
+"        reduction.  Input files are merged in fixed groups of 8 into temporary files, those are merged in groups of 8,\n"\
+"        and so on until one file is left.  The groups don't depend on --jobs, so neither do the sums.\n"\
+"        Only one object from each input file is in memory at a time.\n"\
+"        MnvH1Ds and MnvH2Ds are added with all of their error band universes.  TParameters like POTUsed are summed.\n"\
+"        TTrees are concatenated.  Anything else, like the playlist name, is copied from the first file that has it.\n"\
+"        Objects are written in the order they first appear in the input files.\n"\
+"        With --band-shards, the input files instead come from jobs that ran over the same AnaTuples with different\n"\
+"        runEventLoopTargets --bands.  The output gets the first file's CV, POT, and everything else along with\n"\
+"        every error band from any of the input files.  Merge band shards like this before merging across AnaTuples.\n"\
+"        Only the MC files are sharded.  The one job that ran with --data writes data files without the band groups\n"\
+"        in their names.\n\n"\
+" Usage: MergeHistograms [--jobs <N>] [--band-shards] <output file> <input file> [more input files...]\n"\
+"        e.g:   MergeHistograms --jobs 8 runEventLoopTargetsMCLead.root runEventLoopTargetsMC2082.root runEventLoopTargetsMC3082.root\n"\
+"        --jobs of 0, the default, uses every core on the machine.\n"\
+"        e.g:   MergeHistograms --band-shards runEventLoopTargetsMC2026.root runEventLoopTargetsMC2026_flux.root runEventLoopTargetsMC2026_genie.root\n\n"
+
+// PlotUtils includes
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Woverloaded-virtual"
+#include "PlotUtils/MnvH1D.h"
+#include "PlotUtils/MnvH2D.h"
+#pragma GCC diagnostic pop
+
+// util includes
+#include "util/MergeFiles.h"
+#include "util/MergeBandShards.h"
+
+// ROOT includes
+#include "TH1.h"
+#include "TROOT.h"
+
+#ifndef NCINTEX
+#include "Cintex/Cintex.h"
+#endif
+
+// c++ includes
+#include <iostream>
+#include <exception>
+#include <algorithm>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <vector>
+#include <string>
+#include <cstdio>
+
+// Number of files merged together at each level of the reduction
+const size_t fanIn = 8;
+
+int main(const int argc, const char **argv)
+{
+#ifndef NCINTEX
+  ROOT::Cintex::Cintex::Enable(); // Needed to look up dictionaries for PlotUtils classes like MnvH1D
+#else
+  ROOT::EnableThreadSafety(); // Every thread opens its own files
+#endif
+
+  TH1::AddDirectory(kFALSE);
+
+  size_t nThreads = 0;
+  bool bandShards = false;
+  std::vector<std::string> files;
+  for (int whichArg = 1; whichArg < argc; ++whichArg)
+  {
+    if (std::string(argv[whichArg]) == "--jobs" && whichArg + 1 < argc)
+      nThreads = std::stoul(argv[++whichArg]);
+    else if (std::string(argv[whichArg]) == "--band-shards")
+      bandShards = true;
+    else
+      files.push_back(argv[whichArg]);
+  }
+
+  if (files.size() < 2)
+  {
+    std::cerr << "Expected an output file and at least 1 input file.\n" << HELP << std::endl;
+    return 1;
+  }
+  if (nThreads == 0) nThreads = std::max(1u, std::thread::hardware_concurrency());
+#ifndef NCINTEX
+  nThreads = 1; // ROOT 5 can't open files from more than one thread at a time
+#endif
+
+  const std::string outputName = files.front();
+  std::vector<std::string> toMerge(files.begin() + 1, files.end());
+
+  // There are only ever a few band shards, and they can't be merged in pieces anyway
+  if (bandShards)
+  {
+    try
+    {
+      util::MergeBandShards(toMerge, outputName);
+    }
+    catch (const std::exception &e)
+    {
+      std::cerr << "Failed to merge band shards into " << outputName << ": " << e.what() << "\n";
+      std::remove(outputName.c_str());
+      return 2;
+    }
+    return 0;
+  }
+
+  // Each level merges groups of fanIn files in parallel until only one group is left.
+  // That last group goes straight to the output file.
+  std::vector<std::string> temporaries;
+  for (int level = 0; ; ++level)
+  {
+    const size_t nGroups = (toMerge.size() + fanIn - 1) / fanIn;
+    std::vector<std::string> merged(nGroups);
+    for (size_t group = 0; group < nGroups; ++group)
+      merged[group] = (nGroups == 1) ? outputName : outputName + ".level" + std::to_string(level) + "_" + std::to_string(group) + ".root";
+
+    std::atomic<size_t> nextGroup(0);
+    std::mutex errorMutex;
+    std::string firstError;
+    auto worker = [&]()
+    {
+      for (size_t group = nextGroup++; group < nGroups; group = nextGroup++)
+      {
+        try
+        {
+          const auto begin = toMerge.begin() + group * fanIn;
+          util::MergeFiles(std::vector<std::string>(begin, begin + std::min(fanIn, toMerge.size() - group * fanIn)), merged[group]);
+        }
+        catch (const std::exception &e)
+        {
+          std::lock_guard<std::mutex> lock(errorMutex);
+          if (firstError.empty()) firstError = e.what();
+          return;
+        }
+      }
+    };
+
+    std::cout << "Merging " << toMerge.size() << " files into " << nGroups << " on " << std::min(nThreads, nGroups) << " threads\n";
+    std::vector<std::thread> threads;
+    for (size_t whichThread = 0; whichThread < std::min(nThreads, nGroups); ++whichThread)
+      threads.emplace_back(worker);
+    for (auto &thread : threads)
+      thread.join();
+
+    for (const auto &temporary : temporaries)
+      std::remove(temporary.c_str());
+    temporaries.clear();
+
+    if (!firstError.empty())
+    {
+      std::cerr << "Failed to merge into " << outputName << ": " << firstError << "\n";
+      for (const auto &partial : merged)
+        if (partial != outputName) std::remove(partial.c_str());
+      return 2;
+    }
+
+    if (nGroups == 1) break;
+    temporaries = merged;
+    toMerge = merged;
+  }
+
+  return 0;
+}
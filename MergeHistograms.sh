@@ -1,4 +1,7 @@
 #!/bin/bash
+#Set MERGE_JOBS to limit how many threads each merge uses.  The default uses every core.
+merge="MergeHistograms --jobs ${MERGE_JOBS:-0}"
+
 declare -a nufilled=()
 
 declare -a nuplaylistall=(
@@ -46,12 +49,12 @@ declare -a runtypes=(
 for dir in ${1}/*; do 
     if [ -d "$dir" ]; then 
         cd $dir
-        hadd -f runEventLoopTargetsMCLead.root runEventLoopTargetsMC2082.root runEventLoopTargetsMC3082.root runEventLoopTargetsMC4082.root runEventLoopTargetsMC5082.root
-        hadd -f runEventLoopTargetsMCIron.root runEventLoopTargetsMC2026.root runEventLoopTargetsMC3026.root  runEventLoopTargetsMC5026.root
-        hadd -f runEventLoopTargetsMCCarbon.root runEventLoopTargetsMC3006.root
-        hadd -f runEventLoopTargetsDataLead.root runEventLoopTargetsData2082.root runEventLoopTargetsData3082.root runEventLoopTargetsData4082.root runEventLoopTargetsData5082.root
-        hadd -f runEventLoopTargetsDataIron.root runEventLoopTargetsData2026.root runEventLoopTargetsData3026.root  runEventLoopTargetsData5026.root
-        hadd -f runEventLoopTargetsDataCarbon.root runEventLoopTargetsData3006.root
+        ${merge} runEventLoopTargetsMCLead.root runEventLoopTargetsMC2082.root runEventLoopTargetsMC3082.root runEventLoopTargetsMC4082.root runEventLoopTargetsMC5082.root
+        ${merge} runEventLoopTargetsMCIron.root runEventLoopTargetsMC2026.root runEventLoopTargetsMC3026.root  runEventLoopTargetsMC5026.root
+        ${merge} runEventLoopTargetsMCCarbon.root runEventLoopTargetsMC3006.root
+        ${merge} runEventLoopTargetsDataLead.root runEventLoopTargetsData2082.root runEventLoopTargetsData3082.root runEventLoopTargetsData4082.root runEventLoopTargetsData5082.root
+        ${merge} runEventLoopTargetsDataIron.root runEventLoopTargetsData2026.root runEventLoopTargetsData3026.root  runEventLoopTargetsData5026.root
+        ${merge} runEventLoopTargetsDataCarbon.root runEventLoopTargetsData3006.root
     fi 
 done
 
@@ -70,7 +73,7 @@ fi
 #==========================
 for rt in ${runtypes[@]}; do   
     for mat in ${materials[@]}; do   
-        base="hadd -f ${combinednudir}/runEventLoopTargets${rt}${mat}.root"
+        base="${merge} ${combinednudir}/runEventLoopTargets${rt}${mat}.root"
         for dir in ${nuplaylistall[@]}; do   
             #echo -e $dir
             base="${base} ${1}/${dir}/runEventLoopTargets${rt}${mat}.root"
@@ -81,7 +84,7 @@ done
 #Adding Water
 for rt in ${runtypes[@]}; do   
     for mat in ${materials[@]}; do   
-        base="hadd -f ${combinednudir}/runEventLoopTargets${rt}${mat}.root"
+        base="${merge} ${combinednudir}/runEventLoopTargets${rt}${mat}.root"
         for dir in ${nufilled[@]}; do   
             #echo -e $dir
             base="${base} ${1}/${dir}/runEventLoopTargets${rt}${mat}.root"
@@ -93,7 +96,7 @@ done
 #==========================
 for rt in ${runtypes[@]}; do   
     for mat in ${materials[@]}; do   
-        base="hadd -f ${combinednudir}/runEventLoopTargets${rt}${mat}.root"
+        base="${merge} ${combinednudir}/runEventLoopTargets${rt}${mat}.root"
         for dir in ${nuplaylistall[@]}; do   
             #echo -e $dir
             base="${base} ${1}/${dir}/runEventLoopTargets${rt}${mat}.root"
@@ -104,7 +107,7 @@ done
 #Adding Water
 for rt in ${runtypes[@]}; do   
     for mat in ${materials[@]}; do   
-        base="hadd -f ${combinednudir}/runEventLoopTargets${rt}${mat}.root"
+        base="${merge} ${combinednudir}/runEventLoopTargets${rt}${mat}.root"
         for dir in ${anufilled[@]}; do   
             #echo -e $dir
             base="${base} ${1}/${dir}/runEventLoopTargets${rt}${mat}.root"
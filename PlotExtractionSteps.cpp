@@ -0,0 +1,164 @@
+#define HELP \
+"\n*** Help: ***\n"\
+" File: PlotExtractionSteps.cpp\n"\
+" Brief: Draws the histograms that Extract1DCrossSectionTargets saves from each step of the cross section extraction\n"\
+"        in <target>_extractionPlots.root.  Each histogram gets a PNG of its CV with errors, its uncertainty summary,\n"\
+"        and its other uncertainties, named after the target, variable, and step like the extraction used to make them.\n"\
+"        Plots are split between --jobs processes.  Rendering doesn't hold up the extraction this way, and it can\n"\
+"        be skipped or rerun without extracting the cross sections again.\n\n"\
+" Usage: PlotExtractionSteps [--jobs <N>] <snapshot file> [more snapshot files...]\n"\
+"        e.g:   PlotExtractionSteps --jobs 8 2026_extractionPlots.root\n"\
+"        --jobs of 0, the default, uses every core on the machine.\n\n"
+
+// PlotUtils includes
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Woverloaded-virtual"
+#include "PlotUtils/MnvH1D.h"
+#include "PlotUtils/MnvPlotter.h"
+#pragma GCC diagnostic pop
+
+// ROOT includes
+#include "TH1.h"
+#include "TROOT.h"
+#include "TFile.h"
+#include "TKey.h"
+#include "TCanvas.h"
+
+#ifndef NCINTEX
+#include "Cintex/Cintex.h"
+#endif
+
+// c++ includes
+#include <iostream>
+#include <memory>
+#include <vector>
+#include <string>
+#include <set>
+#include <utility>
+#include <thread>
+#include <algorithm>
+
+// POSIX includes
+#include <unistd.h>
+#include <sys/wait.h>
+
+// Same plots that Extract1DCrossSectionTargets used to make for each step
+void Plot(PlotUtils::MnvH1D &hist, const std::string &name)
+{
+  TCanvas can(name.c_str());
+  hist.GetCVHistoWithError().Clone()->Draw();
+  can.Print((name + ".png").c_str());
+
+  // Uncertainty summary
+  PlotUtils::MnvPlotter plotter;
+  plotter.ApplyStyle(PlotUtils::kCCQENuInclusiveStyle);
+  plotter.axis_maximum = 0.4;
+
+  plotter.DrawErrorSummary(&hist);
+  can.Print((name + "_uncertaintySummary.png").c_str());
+
+  plotter.DrawErrorSummary(&hist, "TR", true, true, 1e-5, false, "Other");
+  can.Print((name + "_otherUncertainties.png").c_str());
+}
+
+// Draws every nWorkers-th plot starting with worker.  Returns the number of plots that couldn't be drawn.
+int DrawPlots(const std::vector<std::pair<std::string, std::string>> &plots, const size_t worker, const size_t nWorkers)
+{
+  int nFailed = 0;
+  std::string openFileName;
+  std::unique_ptr<TFile> file;
+  for (size_t whichPlot = worker; whichPlot < plots.size(); whichPlot += nWorkers)
+  {
+    const auto &fileName = plots[whichPlot].first;
+    const auto &name = plots[whichPlot].second;
+    if (fileName != openFileName)
+    {
+      file.reset(TFile::Open(fileName.c_str(), "READ"));
+      openFileName = fileName;
+    }
+
+    std::unique_ptr<PlotUtils::MnvH1D> hist(file ? dynamic_cast<PlotUtils::MnvH1D *>(file->Get(name.c_str())) : nullptr);
+    if (!hist)
+    {
+      std::cerr << "Failed to read an MnvH1D named " << name << " from " << fileName << "\n";
+      ++nFailed;
+      continue;
+    }
+    Plot(*hist, name);
+  }
+  return nFailed;
+}
+
+int main(const int argc, const char **argv)
+{
+#ifndef NCINTEX
+  ROOT::Cintex::Cintex::Enable(); // Needed to look up dictionaries for PlotUtils classes like MnvH1D
+#endif
+
+  TH1::AddDirectory(kFALSE);
+  gROOT->SetBatch(kTRUE);
+
+  size_t nWorkers = 0;
+  std::vector<std::string> files;
+  for (int whichArg = 1; whichArg < argc; ++whichArg)
+  {
+    if (std::string(argv[whichArg]) == "--jobs" && whichArg + 1 < argc)
+      nWorkers = std::stoul(argv[++whichArg]);
+    else
+      files.push_back(argv[whichArg]);
+  }
+
+  if (files.empty())
+  {
+    std::cerr << "Expected at least 1 snapshot file.\n" << HELP << std::endl;
+    return 1;
+  }
+  if (nWorkers == 0) nWorkers = std::max(1u, std::thread::hardware_concurrency());
+
+  // Only list the plots here.  Each worker process reads its own histograms.
+  std::vector<std::pair<std::string, std::string>> plots;
+  for (const auto &fileName : files)
+  {
+    std::unique_ptr<TFile> file(TFile::Open(fileName.c_str(), "READ"));
+    if (!file)
+    {
+      std::cerr << "Failed to open " << fileName << "\n";
+      return 2;
+    }
+
+    std::set<std::string> seen; // Only the latest cycle of each key
+    TIter nextKey(file->GetListOfKeys());
+    while (auto key = static_cast<TKey *>(nextKey()))
+    {
+      if (seen.insert(key->GetName()).second)
+        plots.emplace_back(fileName, key->GetName());
+    }
+  }
+
+  nWorkers = std::min(nWorkers, std::max<size_t>(1, plots.size()));
+  std::cout << "Drawing " << plots.size() << " plots in " << nWorkers << " processes\n";
+
+  // ROOT graphics aren't thread-safe, so each worker is its own process
+  std::vector<pid_t> children;
+  for (size_t worker = 1; worker < nWorkers; ++worker)
+  {
+    const pid_t child = fork();
+    if (child == 0) _exit(DrawPlots(plots, worker, nWorkers) == 0 ? 0 : 3);
+    if (child < 0)
+    {
+      std::cerr << "Failed to start worker process " << worker << "\n";
+      return 4;
+    }
+    children.push_back(child);
+  }
+
+  bool failed = (DrawPlots(plots, 0, nWorkers) != 0);
+  for (auto child : children)
+  {
+    int status = 0;
+    if (waitpid(child, &status, 0) < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0)
+      failed = true;
+  }
+
+  return failed ? 3 : 0;
+}
@@ -0,0 +1,179 @@
+#define HELP \
+"\n*** Help: ***\n"\
+" File: RehistogramWeights.cpp\n"\
+" Brief: Makes CV histograms for other tunes and warps from the reweighter factors that runEventLoopTargets\n"\
+"        --reweight-tree saves in runEventLoopTargetsReweight<target>.root.  Each model's CV weight is the product\n"\
+"        of its reweighters' factors, so this only reads the small factor trees instead of the AnaTuples.\n"\
+"        The histograms are the same as runEventLoopTargets --model makes: <model>_<variable>_selected_mc_reco,\n"\
+"        _selected_signal_reco, _efficiency_numerator, _efficiency_denominator, and _migration.\n\n"\
+" Usage: RehistogramWeights <reweight file> <output file> <name>=<tune>[,<warp>...] [more models...]\n"\
+"        e.g:   RehistogramWeights runEventLoopTargetsReweight2026.root warps2026.root nominal=431 SuSA=431,SUSA_2P2H_WARP\n"\
+"        <tune> is like MnvTune, and each <warp> is NO_2P2H_WARP, AMU_DIS_WARP, LOW_Q2_PION_WARP, or SUSA_2P2H_WARP.\n"\
+"        The factors were calculated with the event loop's tune v4 universe settings or without them, so only\n"\
+"        use v4 models with files made with MnvTune v4 and vice versa.\n\n"
+
+// Includes from this package
+#include "util/AlternateModels.h"
+#include "util/ReweightTree.h"
+
+// ROOT includes
+#include "TH1.h"
+#include "TFile.h"
+#include "TKey.h"
+#include "TTree.h"
+#include "TVectorD.h"
+#include "TParameter.h"
+#include "TNamed.h"
+
+// c++ includes
+#include <iostream>
+#include <memory>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <stdexcept>
+
+// Each model's weight for the current tree entry
+void CalculateWeights(const std::vector<std::vector<size_t>> &modelComponents, const std::vector<Float_t> &factors, std::vector<double> &weights)
+{
+  for (size_t whichModel = 0; whichModel < modelComponents.size(); ++whichModel)
+  {
+    weights[whichModel] = 1;
+    for (auto component : modelComponents[whichModel]) weights[whichModel] *= factors[component];
+  }
+}
+
+int main(const int argc, const char **argv)
+{
+  TH1::AddDirectory(kFALSE);
+
+  if (argc < 4)
+  {
+    std::cerr << "Expected a reweight file, an output file, and at least 1 model.\n" << HELP << std::endl;
+    return 1;
+  }
+
+  std::vector<std::string> modelNames, descriptions;
+  std::vector<std::vector<size_t>> modelComponents; // Indices in util::reweighterComponents
+  try
+  {
+    for (int whichArg = 3; whichArg < argc; ++whichArg)
+    {
+      const auto model = util::ModelConfig::Parse(argv[whichArg]);
+      modelNames.push_back(model.name);
+      modelComponents.emplace_back();
+      std::string description = "MnvTune " + model.TuneName() + " with";
+      for (const auto &component : model.Components())
+      {
+        const auto found = std::find(util::reweighterComponents.begin(), util::reweighterComponents.end(), component);
+        modelComponents.back().push_back(found - util::reweighterComponents.begin());
+        description += " " + component;
+      }
+      descriptions.push_back(description);
+    }
+  }
+  catch (const std::runtime_error &e)
+  {
+    std::cerr << e.what() << "\n" << HELP << std::endl;
+    return 1;
+  }
+
+  std::unique_ptr<TFile> inFile(TFile::Open(argv[1], "READ"));
+  if (!inFile)
+  {
+    std::cerr << "Failed to open " << argv[1] << "\n";
+    return 2;
+  }
+
+  // Every Variable saved its binning
+  std::vector<std::string> varNames;
+  std::vector<std::vector<double>> bins;
+  TIter nextKey(inFile->GetListOfKeys());
+  while (auto key = static_cast<TKey *>(nextKey()))
+  {
+    const std::string name = key->GetName();
+    const auto suffix = name.rfind(util::reweightBinsSuffix);
+    if (suffix == std::string::npos || suffix + util::reweightBinsSuffix.size() != name.size()) continue;
+    if (std::find(varNames.begin(), varNames.end(), name.substr(0, suffix)) != varNames.end()) continue; // Only the latest cycle
+
+    std::unique_ptr<TVectorD> edges(dynamic_cast<TVectorD *>(key->ReadObj()));
+    if (!edges) continue;
+    varNames.push_back(name.substr(0, suffix));
+    bins.emplace_back(edges->GetMatrixArray(), edges->GetMatrixArray() + edges->GetNoElements());
+  }
+
+  auto selected = dynamic_cast<TTree *>(inFile->Get(util::reweightSelectedTreeName.c_str()));
+  auto effDenom = dynamic_cast<TTree *>(inFile->Get(util::reweightEffDenomTreeName.c_str()));
+  auto pot = dynamic_cast<TParameter<double> *>(inFile->Get("POTUsed"));
+  auto sampleWeight = dynamic_cast<TParameter<double> *>(inFile->Get("sampleWeight"));
+  auto playlist = dynamic_cast<TNamed *>(inFile->Get("PlaylistUsed"));
+  if (!selected || !effDenom || !pot || !sampleWeight || !playlist || varNames.empty())
+  {
+    std::cerr << argv[1] << " isn't a file from runEventLoopTargets --reweight-tree\n";
+    return 3;
+  }
+
+  util::AlternateModelHists hists(modelNames, descriptions, varNames, bins);
+  std::vector<Float_t> factors(util::reweighterComponents.size()), reco(varNames.size()), truth(varNames.size());
+  std::vector<double> recoValues(varNames.size()), trueValues(varNames.size()), weights(modelNames.size());
+  Bool_t isSignal = false;
+
+  // Only read the branches that the histograms need
+  for (auto tree : {selected, effDenom})
+  {
+    tree->SetBranchStatus("*", 0);
+    for (size_t whichVar = 0; whichVar < varNames.size(); ++whichVar)
+    {
+      tree->SetBranchStatus((varNames[whichVar] + "_true").c_str(), 1);
+      tree->SetBranchAddress((varNames[whichVar] + "_true").c_str(), &truth[whichVar]);
+    }
+    for (const auto &model : modelComponents)
+    {
+      for (auto component : model)
+      {
+        tree->SetBranchStatus(util::reweighterComponents[component].c_str(), 1);
+        tree->SetBranchAddress(util::reweighterComponents[component].c_str(), &factors[component]);
+      }
+    }
+  }
+  selected->SetBranchStatus("isSignal", 1);
+  selected->SetBranchAddress("isSignal", &isSignal);
+  for (size_t whichVar = 0; whichVar < varNames.size(); ++whichVar)
+  {
+    selected->SetBranchStatus((varNames[whichVar] + "_reco").c_str(), 1);
+    selected->SetBranchAddress((varNames[whichVar] + "_reco").c_str(), &reco[whichVar]);
+  }
+
+  const Long64_t nSelected = selected->GetEntries();
+  for (Long64_t entry = 0; entry < nSelected; ++entry)
+  {
+    selected->GetEntry(entry);
+    CalculateWeights(modelComponents, factors, weights);
+    std::copy(reco.begin(), reco.end(), recoValues.begin());
+    std::copy(truth.begin(), truth.end(), trueValues.begin());
+    hists.FillSelected(recoValues, trueValues, weights, isSignal);
+  }
+
+  const Long64_t nEffDenom = effDenom->GetEntries();
+  for (Long64_t entry = 0; entry < nEffDenom; ++entry)
+  {
+    effDenom->GetEntry(entry);
+    CalculateWeights(modelComponents, factors, weights);
+    std::copy(truth.begin(), truth.end(), trueValues.begin());
+    hists.FillEffDenom(trueValues, weights, sampleWeight->GetVal());
+  }
+  std::cout << "Reweighted " << nSelected << " selected and " << nEffDenom << " efficiency denominator events for " << modelNames.size() << " models\n";
+
+  std::unique_ptr<TFile> outFile(TFile::Open(argv[2], "RECREATE"));
+  if (!outFile)
+  {
+    std::cerr << "Failed to create " << argv[2] << "\n";
+    return 4;
+  }
+  hists.Write(*outFile);
+  playlist->Write();
+  pot->Write();
+  outFile->Close();
+
+  return 0;
+}
@@ -15,6 +15,8 @@ namespace reco
     public:
       ANNConfidenceCut(const double conf): PlotUtils::Cut<UNIVERSE, EVENT>(std::string("ANN confidence > ") + std::to_string(conf)), fConf(conf) {}
 
+      double GetThreshold() const { return fConf; }
+
     private:
       bool checkCut(const UNIVERSE& univ, EVENT& /*evt*/) const override
       {
@@ -20,6 +20,7 @@
 #include "utilities/PhysicsVariables.h"
 #include "Math/Vector3D.h"
 #include "PlotUtils/CaloCorrection.h"
+#include "util/DerivedKinematics.h"
 
 class CVUniverse : public PlotUtils::MinervaUniverse {
 
@@ -30,10 +31,28 @@ class CVUniverse : public PlotUtils::MinervaUniverse {
   // Constructor/Destructor
   // ========================================================================
   CVUniverse(PlotUtils::ChainWrapper* chw, double nsigma = 0)
-      : PlotUtils::MinervaUniverse(chw, nsigma) {}
+      : PlotUtils::MinervaUniverse(chw, nsigma), m_derived(util::DerivedKinematics::For(chw)) {}
 
   virtual ~CVUniverse() {}
 
+  // ========================================================================
+  // Values from MakeDerivedKinematics' friend trees for this entry, or
+  // nullptr when this universe's chain doesn't have them.  Lateral
+  // systematics shift the muon and recoil, so pass kinematics = true to only
+  // get values for universes that share the CV's kinematics.
+  // ========================================================================
+  const util::DerivedValues* GetDerivedReco(const bool kinematics = false) const
+  {
+    if (!m_derived || !m_derived->HasReco() || (kinematics && !SharesCVKinematics())) return nullptr;
+    return &m_derived->Get(m_entry);
+  }
+
+  const util::DerivedValues* GetDerivedTruth() const
+  {
+    if (!m_derived || !m_derived->HasTruth()) return nullptr;
+    return &m_derived->Get(m_entry);
+  }
+
   // ========================================================================
   // Quantities defined here as constants for the sake of below. Definition
   // matched to Dan's CCQENuInclusiveME variables from:
@@ -88,6 +107,7 @@ class CVUniverse : public PlotUtils::MinervaUniverse {
 
   double GetANNMuonPTGeV() const //GeV/c
   {
+    if (const auto derived = GetDerivedReco(true)) return derived->annMuonPTGeV;
     return GetANNMuonPT()/1000;
   }
 
@@ -647,6 +667,7 @@ double GetDiffractiveUncWeight() const {
 
     double GetBjorkenX() const
     {
+        if (const auto derived = GetDerivedReco(true)) return derived->bjorkenX;
         double Emu = GetANNEmuGeV();
         double mu_massGev = MinervaUnits::M_mu/1000;
         double qsquared =  2.0 * (GetANNRecoilEGeV()+Emu) * (Emu - GetANNPmuGeV() * cos(GetThetamu())) - (mu_massGev*mu_massGev);
@@ -672,6 +693,7 @@ double GetDiffractiveUncWeight() const {
 
     double GetBjorkenY() const
     {
+        if (const auto derived = GetDerivedReco(true)) return derived->bjorkenY;
         return GetANNRecoilE()/GetANNEnu();
     }
 
@@ -750,6 +772,30 @@ double GetDiffractiveUncWeight() const {
     else return zPosFromSegment0;
   }
 
+  //GetANNSegmentsZPosWeighted2() only ever returns one of two Z positions: the confidence weighted one when the ANN segments
+  //are closer together than cutoff and segment 0's otherwise.  Works both out once for scans over many cutoffs.
+  struct ANNSegmentsZPosScan
+  {
+    double zPosSegment0;
+    double zPosWeighted;
+    int firstWeightedCutoff; //Smallest cutoff for which GetANNSegmentsZPosWeighted2() returns zPosWeighted
+
+    double at(int cutoff) const { return (cutoff >= firstWeightedCutoff) ? zPosWeighted : zPosSegment0; }
+  };
+
+  ANNSegmentsZPosScan GetANNSegmentsZPosScan() const
+  {
+    if (const auto derived = GetDerivedReco()) return {derived->annZPosSegment0, derived->annZPosWeighted, derived->annFirstWeightedCutoff};
+    if (GetInt("hasMLPrediction")!=1) return {-999, -999, 0};
+    const int segment0 = GetVecElemInt("ANN_segments", 0);
+    const int segment1 = GetVecElemInt("ANN_segments", 1);
+    double zPosFromSegment0 = getZPosFromSegment(segment0);
+    double zPosFromSegment1 = getZPosFromSegment(segment1);
+    double conf0 = GetVecElem("ANN_plane_probs", 0);
+    double conf1 = GetVecElem("ANN_plane_probs", 1);
+    return {zPosFromSegment0, (zPosFromSegment0*conf0+zPosFromSegment1*conf1)/(conf0+conf1), std::abs(segment0-segment1) + 1};
+  }
+
 
     // ========================================================================
     //  ENERGY FUNCTIONS
@@ -1174,6 +1220,16 @@ double GetDiffractiveUncWeight() const {
 
   int GetMultiplicity() const {return GetInt("multiplicity");}
 
+  private:
+  const util::DerivedKinematics* m_derived; //Kept alive by util::DerivedKinematics::Attach()
+  mutable int m_sharesCVKinematics = -1; //ShortName() isn't the derived class's until after construction, so look it up lazily
+
+  bool SharesCVKinematics() const
+  {
+    if (m_sharesCVKinematics < 0) m_sharesCVKinematics = (IsVerticalOnly() || ShortName() == "cv");
+    return m_sharesCVKinematics;
+  }
+
   //Still needed for some systematics to compile, but shouldn't be used for reweighting anymore.
   protected:
   #include "PlotUtils/WeightFunctions.h" // Get*Weight
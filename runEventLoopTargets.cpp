@@ -1,6 +1,13 @@
 #define MC_OUT_FILE_NAME_BASE "runEventLoopTargetsMC"
 #define DATA_OUT_FILE_NAME_BASE "runEventLoopTargetsData"
 #define MIGRATION_2D_OUT_FILE_NAME_BASE "runEventLoopTargets2DMigration"
+#define TRACKER_MC_OUT_FILE_NAME_BASE "runEventLoopTrackerMC"
+#define TRACKER_DATA_OUT_FILE_NAME_BASE "runEventLoopTrackerData"
+#define TRACKER_MIGRATION_2D_OUT_FILE_NAME_BASE "runEventLoopTracker2DMigration"
+#define VALIDATIONS_OUT_FILE_NAME_BASE "VertexValidations"
+#define CUT_SCAN_OUT_FILE_NAME_BASE "runEventLoopTargetsCutScan"
+#define MODELS_OUT_FILE_NAME_BASE "runEventLoopTargetsModels"
+#define REWEIGHT_OUT_FILE_NAME_BASE "runEventLoopTargetsReweight"
 
 #define USAGE                                                                                                           \
   "\n*** USAGE ***\n"                                                                                                   \
@@ -13,6 +20,48 @@
   "E.G. for water target: runEventLoop <dataPlaylist.txt> <mcPlaylist.txt> 6000.\n"                                     \
   "E.G. for pseudotarget 8: runEventLoop <dataPlaylist.txt> <mcPlaylist.txt> 8.\n"                                      \
   "If target code is not provided, default behaviour is to run over everything, this can be very memory intensive\n"    \
+  "Add --memory-budget <MB> to fill several targets in each pass over the input files while keeping the job's\n"        \
+  "memory use under <MB>.  Otherwise each target gets its own pass.\n"                                                  \
+  "Add --incremental to only process the files in the playlists that aren't in this directory's output files yet\n"     \
+  "and add the results to those output files.  Histograms and POT are summed.  Every target must already have\n"        \
+  "outputs made from the same files.  Can't be used with NumGridSubruns.\n"                                             \
+  "Add --sample <N> for a quick preview that only processes every Nth cluster of 1000 entries in each playlist.\n"      \
+  "POTUsed is scaled down to match, so the outputs can go through the cross section extraction as usual.\n"             \
+  "Can't be used with --incremental.\n"                                                                                 \
+  "Add --bands <groups> to only fill the error bands in a comma-separated list of groups of systematics from\n"         \
+  "systematics/Systematics.h, like flux,genie.  Output file names end with the groups.  Run a job for each group\n"     \
+  "over the same playlists, and then combine their MC files with MergeHistograms --band-shards.  Data has no\n"         \
+  "error bands, so only the job that also gets --data loops over the data playlist.  Its data files' names don't\n"     \
+  "end with the groups.  --validations and --scan need --data too in a job with --bands.\n"                             \
+  "Add --tracker <petals> to also run runEventLoopTracker's analysis of the active tracker in the same reads of the\n"  \
+  "playlists.  <petals> is a comma-separated list of daisy petals from -1 to 11, or all.  Its outputs are the same\n"   \
+  "files runEventLoopTracker would write.  All of the petals are filled in the first pass on top of --memory-budget.\n" \
+  "Can't be used with --incremental.\n"                                                                                 \
+  "Add --validations to also fill runEventLoopValidations' vertex validation histograms in the first pass and\n"        \
+  "write them to the same " VALIDATIONS_OUT_FILE_NAME_BASE ".root it would.  Only the CV is filled.\n"                  \
+  "Can't be used with --incremental.\n"                                                                                 \
+  "Add --scan <cut>=<thresholds> to also fill copies of the 1D selected and data histograms for each of a\n"            \
+  "comma-separated list of thresholds of a cut in the same reads of the playlists.  <cut> is ANNConfidence,\n"          \
+  "Apothem, CurveSignificance, ZMin, or ZMax.  Repeat --scan to scan more cuts.  Each cut is scanned with the\n"        \
+  "others at their nominal thresholds.  Only the CV is filled.\n"                                                       \
+  "Each target's scan goes in " CUT_SCAN_OUT_FILE_NAME_BASE "<target>.root.  Turns off the result cache.\n"             \
+  "Can't be used with --incremental.\n"                                                                                 \
+  "Add --model <name>=<tune>[,<warp>...] to also fill CV histograms of the 1D variables reweighted to another tune\n"   \
+  "and warps in the same reads of the playlists, like --model SuSA=431,SUSA_2P2H_WARP.  <tune> is like MnvTune.\n"      \
+  "Each <warp> is NO_2P2H_WARP, AMU_DIS_WARP, LOW_Q2_PION_WARP, or SUSA_2P2H_WARP like the environment variables.\n"    \
+  "Repeat --model for more models.  Reweighters that models share are only evaluated once per entry.\n"                 \
+  "Each target's models go side by side in " MODELS_OUT_FILE_NAME_BASE "<target>.root.  Turns off the result cache.\n"  \
+  "Can't be used with --incremental.\n"                                                                                 \
+  "Add --reweight-tree to also save every reweighter's factor for each event that a target selects or puts in its\n"    \
+  "efficiency denominator to " REWEIGHT_OUT_FILE_NAME_BASE "<target>.root.  RehistogramWeights makes CV\n"              \
+  "histograms for any tune and warps from it without reading the playlists again.  Turns off the result cache.\n"       \
+  "Can't be used with --incremental.\n"                                                                                 \
+  "Add --derived-mc <file> and/or --derived-data <file> to read Bjorken x and y, the ANN muon pT, segment Z\n"          \
+  "positions, and target codes from the friend trees that MakeDerivedKinematics made for the MC or data playlist\n"     \
+  "instead of recalculating them for every entry.  They also work for grid subruns and --incremental.\n"                \
+  "MC entries that fail every target's and the tracker's vertex and muon angle cuts by more than any lateral\n"         \
+  "systematic can shift them are skipped before the universe loop.  The cut summaries don't count them.  Add\n"         \
+  "--no-prefilter to go through every universe for every entry anyway, like for full cut summaries.\n"                  \
   "Additionally, if running on the grid, it is possibly more time efficient to only run 1 or a small number of\n"       \
   "targets here and distribute the targets you're interested in over several nodes\n\n"                                 \
   "*** Explanation ***\n"                                                                                               \
@@ -33,7 +82,11 @@
   "MPARAMFILESROOT, and MPARAMFILES must be set according to the setup scripts in\n"                                    \
   "those packages for systematics and flux reweighters to function.\n"                                                  \
   "If MNV101_SKIP_SYST is defined at all, output histograms will have no error bands.\n"                                \
-  "This is useful for debugging the CV and running warping studies.\n\n"                                                \
+  "This is useful for debugging the CV and running warping studies.\n"                                                  \
+  "If MNV_EVENTLOOP_CACHE is set to a directory, each target's output files are stored there under a hash of the\n"     \
+  "playlists, this executable, and the tune, warp and systematics environment variables.  A later run with the\n"       \
+  "same hash copies them from there instead of running the event loop for that target.  Each output file has\n"         \
+  "the hash in a TNamed called ConfigHash either way.\n\n"                                                              \
   "*** Return Codes ***\n"                                                                                              \
   "0 indicates success.  All histograms are valid only in this case.  Any other\n"                                      \
   "return code indicates that histograms should not be used.  Error messages\n"                                         \
@@ -70,7 +123,18 @@ enum ErrorCodes
 #include "studies/Study.h"
 #include "studies/PerEventVarByGENIELabel2D.h"
 #include "studies/WaterTargetIntOrigin2D.h"
+#include "studies/VertexValidations.h"
+#include "studies/CutScan.h"
 #include "util/NukeUtils.h"
+#include "util/InputFiles.h"
+#include "util/MergeFiles.h"
+#include "util/ResultCache.h"
+#include "util/EntrySampler.h"
+#include "util/TrackerAnalysis.h"
+#include "util/AlternateModels.h"
+#include "util/ReweightTree.h"
+#include "util/DerivedKinematics.h"
+#include "util/ShiftPreFilter.h"
 // #include "Binning.h" //TODO: Fix me
 
 // PlotUtils includes
@@ -103,6 +167,7 @@ enum ErrorCodes
 
 // ROOT includes
 #include "TParameter.h"
+#include "TNamed.h"
 #include "fstream"
 
 #include "Math/Vector3D.h"
@@ -110,7 +175,11 @@ enum ErrorCodes
 
 // c++ includes
 #include <iostream>
+#include <memory> //std::unique_ptr
 #include <cstdlib> //getenv()
+#include <algorithm> //std::replace()
+#include <sstream> //std::getline() for --tracker
+#include <cmath> //std::floor() for --memory-budget
 
 bool usingExtendedTargetDefintion = true; // To exlclude the plane immediately after either end of a nuclear target //Used if using extended target definiton
 bool verbose = false;
@@ -311,34 +380,85 @@ int getSidebandTgtCode(CVUniverse *universe, int mode /*mc = 0, ANN = 1, TB = 2*
   return -1;
 }
 
+// Everything needed to fill one target's histograms.  All of the TargetSelections in a pass share each read of the chains.
+struct TargetSelection
+{
+  int targetCode;
+  std::unique_ptr<PlotUtils::Cutter<CVUniverse, MichelEvent>> cuts;
+  std::vector<Variable1DNuke *> vars;
+  std::vector<Variable2DNuke *> vars2D;
+  std::shared_ptr<CutScan> scan; // Only with --scan
+  std::unique_ptr<util::AlternateModelHists> modelHists; // Only with --model
+  std::unique_ptr<util::ReweightTrees> reweightTrees; // Only with --reweight-tree
+};
+
+// runEventLoopTracker's cuts and histograms for each daisy petal, filled from the same reads of the chains as the targets
+struct TrackerSelection
+{
+  std::unique_ptr<PlotUtils::Cutter<CVUniverse, MichelEvent>> cuts;
+  std::map<int, std::unique_ptr<util::TrackerHists>> petals;
+};
+
+// Split targets, in order, into as few passes over the chains as fit in memoryBudgetMB.
+// A budget of 0 means 1 target per pass.  A pass always gets at least 1 target even if it's over budget.
+std::vector<std::vector<int>> groupTargetsIntoPasses(const std::vector<int> &targets, const double bytesPerTarget, const double memoryBudgetMB)
+{
+  size_t targetsPerPass = 1;
+  if (memoryBudgetMB > 0)
+  {
+    // Chains, universes, and reweighters are already loaded, so only what's left of the budget can go to histograms
+    const double availableMB = memoryBudgetMB - util::getResidentMemoryMB();
+    const double targetMB = bytesPerTarget / 1024. / 1024.;
+    // Clamp while it's still a double.  availableMB is negative when the job is already over budget, and a
+    // targetMB of 0 means there are no histograms to fit, so every target goes in one pass.
+    const double fitTargets = (targetMB > 0) ? std::floor(availableMB / targetMB) : targets.size();
+    targetsPerPass = static_cast<size_t>(std::max(1., std::min(fitTargets, static_cast<double>(targets.size()))));
+    std::cout << "Estimated " << targetMB << " MB of histograms per target with " << availableMB << " MB of the " << memoryBudgetMB << " MB budget left.\n";
+    if (availableMB < targetMB) std::cerr << "Memory budget of " << memoryBudgetMB << " MB is too small for even 1 target.  Running 1 target at a time anyway.\n";
+  }
+
+  std::vector<std::vector<int>> passes;
+  for (size_t whichTarget = 0; whichTarget < targets.size(); ++whichTarget)
+  {
+    if (whichTarget % targetsPerPass == 0) passes.emplace_back();
+    passes.back().push_back(targets[whichTarget]);
+  }
+  std::cout << "Running " << targets.size() << " targets in " << passes.size() << " passes over the input files.\n";
+  return passes;
+}
+
 //==============================================================================
 // Loop and Fill
 //==============================================================================
 void LoopAndFillEventSelection(
     PlotUtils::ChainWrapper *chain,
     std::map<std::string, std::vector<CVUniverse *>> error_bands,
-    std::vector<Variable1DNuke *> vars,
-    std::vector<Variable2DNuke *> vars2D,
+    std::vector<TargetSelection> &targets,
+    TrackerSelection *tracker, // nullptr if the tracker analysis isn't in this pass
+    util::AlternateModels *models, // nullptr without --model
+    util::ShiftPreFilter *preFilter, // nullptr with --no-prefilter
     std::vector<Study *> studies,
-    PlotUtils::Cutter<CVUniverse, MichelEvent> &michelcuts,
+    std::vector<Study *> everyEventStudies, // Studies with their own cuts, like VertexValidationStudy
     PlotUtils::Model<CVUniverse, MichelEvent> &model,
-    int targetCode)
+    const util::EntrySampler &sampler)
 {
   assert(!error_bands["cv"].empty() && "\"cv\" error band is empty!  Can't set Model weight.");
   auto &cvUniv = error_bands["cv"].front();
 
   std::cout << "Starting MC reco loop...\n";
   const int nEntries = chain->GetEntries();
-  //const int nEntries = 10000;
   for (int i = 0; i < nEntries; ++i)
   {
     if (i % 1000 == 0)
       std::cout << i << " / " << nEntries << "\r" << std::flush;
+    if (!sampler.Keep(i)) continue;
     // std::cout<<"Here2\n";
     MichelEvent cvEvent;
     cvUniv->SetEntry(i);
+    if (preFilter && !preFilter->Keep(*cvUniv)) continue; // No universe could select this entry
     model.SetEntry(*cvUniv, cvEvent);
     const double cvWeight = model.GetWeight(*cvUniv, cvEvent);
+    if (models) models->SetEntry();
     //=========================================
     //  Systematics loop(s)
     //=========================================
@@ -349,7 +469,7 @@ void LoopAndFillEventSelection(
       for (auto universe : error_band_universes)
       {
         univCount++;         // Put the iterator right at the start so it's executed even in paths that lead to a continue, don't forget to subtract by 1 when we use it
-        MichelEvent myevent; // make sure your event is inside the error band loop.
+        MichelEvent weightEvent; // make sure your event is inside the error band loop.
         // Tell the Event which entry in the TChain it's looking at
         universe->SetEntry(i);
 
@@ -369,125 +489,150 @@ void LoopAndFillEventSelection(
         //This comment is repeated below in another relevant location for the benefit of those skimming through this code in the future
 
         // Nuke Target Study
-        const double weight = model.GetWeight(*universe, myevent); // Only calculate the per-universe weight for events that will actually use it.
-        // Checking if events that are reconstructed outside of our targets of interest occur in our sideband region, which we are also interested in
-
-        if (util::isTargetSideband(universe, 1, targetCode, 1, true)) // Get true origins of the events reconstructed in the upstream region of tgt x
-        {
-          int USbandcode = -1; //US, DS, Signal
-          if (util::isTargetSideband(universe, 0, targetCode, 1, false)) USbandcode = 0; // If the event truly occurred in the US region of tgt x
-          else if (util::isTargetSideband(universe, 0, targetCode, 0, false)) USbandcode = 1; // If the event truly occurred in the DS region of tgt x
-          else if (truthcode == targetCode) USbandcode = 2; // If the event truly occurred in the signal region (inside) of tgt x
-          for (auto &var : vars)
-            (*var->m_sidebandHistSetUSMC)[USbandcode].FillUniverse(universe, var->GetRecoValue(*universe), weight);
-          for (auto &var : vars2D)
-            (*var->m_sidebandHistSetUSMC)[USbandcode].FillUniverse(universe, var->GetRecoValueX(*universe), var->GetRecoValueY(*universe), weight);
-        }
-        else if (util::isTargetSideband(universe, 1, targetCode, 0, true)) // Get true origins of the events reconstructed in the downstream region of tgt x
+        const double weight = model.GetWeight(*universe, weightEvent); // Only calculate the per-universe weight for events that will actually use it.
+        for (auto &study : everyEventStudies) study->Selected(*universe, weightEvent, weight);
+        for (auto &target : targets) // Every target in this pass shares the chain read and the weight
         {
-          int DSbandcode = -1; //US, DS, Signal
+          const int targetCode = target.targetCode;
+          auto &vars = target.vars;
+          auto &vars2D = target.vars2D;
+          auto &michelcuts = *target.cuts;
+          MichelEvent myevent = weightEvent; // Each target's cuts get their own copy of the event
 
-          if (util::isTargetSideband(universe, 0, targetCode, 1, false)) DSbandcode = 0; // If the event truly occurred in the US region of tgt x
-          else if (util::isTargetSideband(universe, 0, targetCode, 0, false)) DSbandcode = 1; // If the event truly occurred in the DS region of tgt x
-          else if (truthcode == targetCode) DSbandcode = 2; // If the event truly occurred in the signal region (inside) of tgt x
-          for (auto &var : vars)
-            (*var->m_sidebandHistSetDSMC)[DSbandcode].FillUniverse(universe, var->GetRecoValue(*universe), weight);
-          for (auto &var : vars2D)
-            (*var->m_sidebandHistSetDSMC)[DSbandcode].FillUniverse(universe, var->GetRecoValueX(*universe), var->GetRecoValueY(*universe), weight);
-        }
-        //End - Capturing sidebands ------------------------------
+          // Checking if events that are reconstructed outside of our targets of interest occur in our sideband region, which we are also interested in
 
-        // This is where you would Access/create a Michel
-        // weight is ignored in isMCSelected() for all but the CV Universe.
-        if (!michelcuts.isMCSelected(*universe, myevent, cvWeight).all())
-          continue; // all is another function that will later help me with sidebands
+          if (util::isTargetSideband(universe, 1, targetCode, 1, true)) // Get true origins of the events reconstructed in the upstream region of tgt x
+          {
+            int USbandcode = -1; //US, DS, Signal
+            if (util::isTargetSideband(universe, 0, targetCode, 1, false)) USbandcode = 0; // If the event truly occurred in the US region of tgt x
+            else if (util::isTargetSideband(universe, 0, targetCode, 0, false)) USbandcode = 1; // If the event truly occurred in the DS region of tgt x
+            else if (truthcode == targetCode) USbandcode = 2; // If the event truly occurred in the signal region (inside) of tgt x
+            for (auto &var : vars)
+              (*var->m_sidebandHistSetUSMC)[USbandcode].FillUniverse(universe, var->GetRecoValue(*universe), weight);
+            for (auto &var : vars2D)
+              (*var->m_sidebandHistSetUSMC)[USbandcode].FillUniverse(universe, var->GetRecoValueX(*universe), var->GetRecoValueY(*universe), weight);
+          }
+          else if (util::isTargetSideband(universe, 1, targetCode, 0, true)) // Get true origins of the events reconstructed in the downstream region of tgt x
+          {
+            int DSbandcode = -1; //US, DS, Signal
+
+            if (util::isTargetSideband(universe, 0, targetCode, 1, false)) DSbandcode = 0; // If the event truly occurred in the US region of tgt x
+            else if (util::isTargetSideband(universe, 0, targetCode, 0, false)) DSbandcode = 1; // If the event truly occurred in the DS region of tgt x
+            else if (truthcode == targetCode) DSbandcode = 2; // If the event truly occurred in the signal region (inside) of tgt x
+            for (auto &var : vars)
+              (*var->m_sidebandHistSetDSMC)[DSbandcode].FillUniverse(universe, var->GetRecoValue(*universe), weight);
+            for (auto &var : vars2D)
+              (*var->m_sidebandHistSetDSMC)[DSbandcode].FillUniverse(universe, var->GetRecoValueX(*universe), var->GetRecoValueY(*universe), weight);
+          }
+          //End - Capturing sidebands ------------------------------
+
+          // This is where you would Access/create a Michel
+          // weight is ignored in isMCSelected() for all but the CV Universe.
+          if (!michelcuts.isMCSelected(*universe, myevent, cvWeight).all())
+            continue; // all is another function that will later help me with sidebands
 
-        for (auto &var : vars)
-        {
-          (*var->selectedMCReco).FillUniverse(universe, var->GetRecoValue(*universe), weight);
-          (*var->m_interactionTypeHists)[universe->GetInteractionType()].FillUniverse(universe, var->GetRecoValue(*universe), weight);
-          //(*var->m_originHists)[origin].FillUniverse(universe, var->GetRecoValue(*universe), weight);
-        }
-        for (auto &var : vars2D)
-        {
-          (*var->selectedMCReco).FillUniverse(universe, var->GetRecoValueX(*universe), var->GetRecoValueY(*universe), weight);
-          (*var->m_interactionTypeHists)[universe->GetInteractionType()].FillUniverse(universe, var->GetRecoValueX(*universe), var->GetRecoValueY(*universe), weight);
-          //(*var->m_originHists)[origin].FillUniverse(universe, var->GetRecoValueX(*universe), var->GetRecoValueY(*universe), weight);
-        }
-        /* if (origin == -1)
-        {
-          std::cout<< "Found \"other\" origin event. Event # " << i << " targetCode: " << targetCode << " code: " << code<<" truthcode: " << truthcode << " USTargetCodeTruthFull: " << USTargetCodeTruthFull <<  " DSTargetCodeTruthFull: " << DSTargetCodeTruthFull <<std::endl;
-        } */
-        const bool isSignal = michelcuts.isSignal(*universe, weight);
-        if (isSignal) // If it is signal
-        {
-          for (auto &study : studies)
-            study->SelectedSignal(*universe, myevent, weight);
           for (auto &var : vars)
           {
-            // Cross section components
-            (*var->efficiencyNumerator).FillUniverse(universe, var->GetTrueValue(*universe), weight);
-            (*var->migration).FillUniverse(universe, var->GetRecoValue(*universe), var->GetTrueValue(*universe), weight);
-            (*var->selectedSignalReco).FillUniverse(universe, var->GetRecoValue(*universe), weight);
+            (*var->selectedMCReco).FillUniverse(universe, var->GetRecoValue(*universe), weight);
+            (*var->m_interactionTypeHists)[universe->GetInteractionType()].FillUniverse(universe, var->GetRecoValue(*universe), weight);
+            //(*var->m_originHists)[origin].FillUniverse(universe, var->GetRecoValue(*universe), weight);
           }
           for (auto &var : vars2D)
           {
-            // Cross section components
-            (*var->efficiencyNumerator).FillUniverse(universe, var->GetTrueValueX(*universe), var->GetTrueValueY(*universe), weight);
-            (*var->migration).Fill(var->GetRecoValueX(*universe), var->GetRecoValueY(*universe), var->GetTrueValueX(*universe), var->GetTrueValueY(*universe), weight);
-            (*var->selectedSignalReco).FillUniverse(universe, var->GetRecoValueX(*universe), var->GetRecoValueY(*universe), weight);
+            (*var->selectedMCReco).FillUniverse(universe, var->GetRecoValueX(*universe), var->GetRecoValueY(*universe), weight);
+            (*var->m_interactionTypeHists)[universe->GetInteractionType()].FillUniverse(universe, var->GetRecoValueX(*universe), var->GetRecoValueY(*universe), weight);
+            //(*var->m_originHists)[origin].FillUniverse(universe, var->GetRecoValueX(*universe), var->GetRecoValueY(*universe), weight);
           }
-        }
-        //------------------------------------------------------
-        // Backgrounds
-        //------------------------------------------------------
-        else
-        {
-          int bkgd_ID = -1;
-          if (util::isTargetSideband(universe, 0, targetCode, 1, false)) bkgd_ID = 2; //US
-          else if (util::isTargetSideband(universe, 0, targetCode, 0, false)) bkgd_ID = 3; //DS
-          else if (universe->GetCurrent() == 2) bkgd_ID = 0;
-          else if (universe->GetTruthNuPDG() == -14) bkgd_ID = 1;
-          else //Experimental - not sure if this will work, we'll see
+          /* if (origin == -1)
           {
-            ROOT::Math::XYZTVector trueVec = universe->GetTrueVertex();
-            int tmpTruthCode = util::getTgtCode(universe, true, false);
-            /* if (trueVec.Z()>5153.77 && trueVec.Z()<5456.74) //Using this as an apporoximate way of getting events MC tells us it reconstructed on water tank/apparatus
+            std::cout<< "Found \"other\" origin event. Event # " << i << " targetCode: " << targetCode << " code: " << code<<" truthcode: " << truthcode << " USTargetCodeTruthFull: " << USTargetCodeTruthFull <<  " DSTargetCodeTruthFull: " << DSTargetCodeTruthFull <<std::endl;
+          } */
+          const bool isSignal = michelcuts.isSignal(*universe, weight);
+          if (target.modelHists && band.first == "cv") target.modelHists->FillSelected(*universe, models->Weights(*universe, myevent), isSignal);
+          if (target.reweightTrees && band.first == "cv") target.reweightTrees->FillSelected(i, *universe, myevent, isSignal);
+          if (isSignal) // If it is signal
+          {
+            for (auto &study : studies)
+              study->SelectedSignal(*universe, myevent, weight);
+            for (auto &var : vars)
             {
-              if (verbose)
-              {
-                std::cout<<"Water event of interest. Reconstructed in water but actually truthfully in target: " << tmpTruthCode << "\tEvent information: mc_run: " << universe->GetInt("mc_run") << " mc_subrun: " << universe->GetInt("mc_subrun")  << " mc_nthEvtInSpill: " << universe->GetInt("mc_nthEvtInSpill") << " mc_nthEvtInFile: " << universe->GetInt("mc_nthEvtInFile") << " ev_global_gate: " << universe->GetInt("ev_global_gate")  << std::endl;
-                std::string ArachneLink = "https://mnvevdgpvm02.fnal.gov/Arachne/?det=SIM_minerva&recoVer=v22r1p1&run="+std::to_string(universe->GetInt("mc_run"))+"&subrun="+std::to_string(universe->GetInt("mc_subrun"))+"&gate="+std::to_string(universe->GetInt("mc_nthEvtInFile")+1)+"&slice=-1";
-                std::cout<<"Arachne Link: " << ArachneLink << std::endl;
-                ROOT::Math::XYZTVector Vtx = universe->GetTrueVertex();
-                ROOT::Math::XYZVector ANNVtx = universe->GetANNVertex();
-                double vtx_x = Vtx.X();
-                double vtx_y = Vtx.Y();
-                double vtx_z = Vtx.Z();
-                std::cout<<"vtx_x: "<< Vtx.X() << " vtx_y " << Vtx.Y() << " vtx_z " << Vtx.Z() <<std::endl;
-                std::cout<<"reco: vtx_x: "<< ANNVtx.X() << " vtx_y " << ANNVtx.Y() << " vtx_z " << ANNVtx.Z() <<std::endl;
-                std::cout<<"event i: " << i << std::endl;
-              }
-              bkgd_ID = 4;
-            } */
-            //else if (tmpTruthCode != targetCode)
-            if (tmpTruthCode != targetCode)
+              // Cross section components
+              (*var->efficiencyNumerator).FillUniverse(universe, var->GetTrueValue(*universe), weight);
+              (*var->migration).FillUniverse(universe, var->GetRecoValue(*universe), var->GetTrueValue(*universe), weight);
+              (*var->selectedSignalReco).FillUniverse(universe, var->GetRecoValue(*universe), weight);
+            }
+            for (auto &var : vars2D)
             {
-              if (tmpTruthCode > 1000)
+              // Cross section components
+              (*var->efficiencyNumerator).FillUniverse(universe, var->GetTrueValueX(*universe), var->GetTrueValueY(*universe), weight);
+              (*var->migration).Fill(var->GetRecoValueX(*universe), var->GetRecoValueY(*universe), var->GetTrueValueX(*universe), var->GetTrueValueY(*universe), weight);
+              (*var->selectedSignalReco).FillUniverse(universe, var->GetRecoValueX(*universe), var->GetRecoValueY(*universe), weight);
+            }
+          }
+          //------------------------------------------------------
+          // Backgrounds
+          //------------------------------------------------------
+          else
+          {
+            int bkgd_ID = -1;
+            if (util::isTargetSideband(universe, 0, targetCode, 1, false)) bkgd_ID = 2; //US
+            else if (util::isTargetSideband(universe, 0, targetCode, 0, false)) bkgd_ID = 3; //DS
+            else if (universe->GetCurrent() == 2) bkgd_ID = 0;
+            else if (universe->GetTruthNuPDG() == -14) bkgd_ID = 1;
+            else //Experimental - not sure if this will work, we'll see
+            {
+              ROOT::Math::XYZTVector trueVec = universe->GetTrueVertex();
+              int tmpTruthCode = util::getTgtCode(universe, true, false);
+              /* if (trueVec.Z()>5153.77 && trueVec.Z()<5456.74) //Using this as an apporoximate way of getting events MC tells us it reconstructed on water tank/apparatus
               {
                 if (verbose)
                 {
-                  std::cout<<"Reconstructed in target:  " <<  targetCode<< "\tBut truly in target: " << tmpTruthCode << "\tEvent information: mc_run: " << universe->GetInt("mc_run") << " mc_subrun: " << universe->GetInt("mc_subrun")  << " mc_nthEvtInSpill: " << universe->GetInt("mc_nthEvtInSpill") << " mc_nthEvtInFile: " << universe->GetInt("mc_nthEvtInFile") << " ev_global_gate: " << universe->GetInt("ev_global_gate")  << std::endl;
+                  std::cout<<"Water event of interest. Reconstructed in water but actually truthfully in target: " << tmpTruthCode << "\tEvent information: mc_run: " << universe->GetInt("mc_run") << " mc_subrun: " << universe->GetInt("mc_subrun")  << " mc_nthEvtInSpill: " << universe->GetInt("mc_nthEvtInSpill") << " mc_nthEvtInFile: " << universe->GetInt("mc_nthEvtInFile") << " ev_global_gate: " << universe->GetInt("ev_global_gate")  << std::endl;
                   std::string ArachneLink = "https://mnvevdgpvm02.fnal.gov/Arachne/?det=SIM_minerva&recoVer=v22r1p1&run="+std::to_string(universe->GetInt("mc_run"))+"&subrun="+std::to_string(universe->GetInt("mc_subrun"))+"&gate="+std::to_string(universe->GetInt("mc_nthEvtInFile")+1)+"&slice=-1";
                   std::cout<<"Arachne Link: " << ArachneLink << std::endl;
+                  ROOT::Math::XYZTVector Vtx = universe->GetTrueVertex();
+                  ROOT::Math::XYZVector ANNVtx = universe->GetANNVertex();
+                  double vtx_x = Vtx.X();
+                  double vtx_y = Vtx.Y();
+                  double vtx_z = Vtx.Z();
+                  std::cout<<"vtx_x: "<< Vtx.X() << " vtx_y " << Vtx.Y() << " vtx_z " << Vtx.Z() <<std::endl;
+                  std::cout<<"reco: vtx_x: "<< ANNVtx.X() << " vtx_y " << ANNVtx.Y() << " vtx_z " << ANNVtx.Z() <<std::endl;
+                  std::cout<<"event i: " << i << std::endl;
+                }
+                bkgd_ID = 4;
+              } */
+              //else if (tmpTruthCode != targetCode)
+              if (tmpTruthCode != targetCode)
+              {
+                if (tmpTruthCode > 1000)
+                {
+                  if (verbose)
+                  {
+                    std::cout<<"Reconstructed in target:  " <<  targetCode<< "\tBut truly in target: " << tmpTruthCode << "\tEvent information: mc_run: " << universe->GetInt("mc_run") << " mc_subrun: " << universe->GetInt("mc_subrun")  << " mc_nthEvtInSpill: " << universe->GetInt("mc_nthEvtInSpill") << " mc_nthEvtInFile: " << universe->GetInt("mc_nthEvtInFile") << " ev_global_gate: " << universe->GetInt("ev_global_gate")  << std::endl;
+                    std::string ArachneLink = "https://mnvevdgpvm02.fnal.gov/Arachne/?det=SIM_minerva&recoVer=v22r1p1&run="+std::to_string(universe->GetInt("mc_run"))+"&subrun="+std::to_string(universe->GetInt("mc_subrun"))+"&gate="+std::to_string(universe->GetInt("mc_nthEvtInFile")+1)+"&slice=-1";
+                    std::cout<<"Arachne Link: " << ArachneLink << std::endl;
+                  }
+                  bkgd_ID = 5;
                 }
-                bkgd_ID = 5;
+                else bkgd_ID = 6;
               }
-              else bkgd_ID = 6;
             }
+            for (auto &var : vars) (*var->m_backgroundHists)[bkgd_ID].FillUniverse(universe, var->GetRecoValue(*universe), weight);
+            for (auto &var : vars2D) (*var->m_backgroundHists)[bkgd_ID].FillUniverse(universe, var->GetRecoValueX(*universe), var->GetRecoValueY(*universe), weight);
+          }
+        } // End target loop
+
+        // The tracker analysis gets its own event and weight like it does in runEventLoopTracker
+        if (tracker)
+        {
+          MichelEvent trackerEvent;
+          if (tracker->cuts->isMCSelected(*universe, trackerEvent, cvWeight).all())
+          {
+            const double trackerWeight = model.GetWeight(*universe, trackerEvent);
+            const auto petal = tracker->petals.find(util::GetRecoDaisyPetal(*universe));
+            if (petal != tracker->petals.end())
+              petal->second->FillSelected(universe, tracker->cuts->isSignal(*universe, trackerWeight), trackerWeight);
           }
-          for (auto &var : vars) (*var->m_backgroundHists)[bkgd_ID].FillUniverse(universe, var->GetRecoValue(*universe), weight);
-          for (auto &var : vars2D) (*var->m_backgroundHists)[bkgd_ID].FillUniverse(universe, var->GetRecoValueX(*universe), var->GetRecoValueY(*universe), weight);
         }
       } // End band's universe loop
     } // End Band loop
@@ -497,52 +642,71 @@ void LoopAndFillEventSelection(
 
 void LoopAndFillData(PlotUtils::ChainWrapper *data,
                      std::vector<CVUniverse *> data_band,
-                     std::vector<Variable1DNuke *> vars,
-                     std::vector<Variable2DNuke *> vars2D,
+                     std::vector<TargetSelection> &targets,
+                     TrackerSelection *tracker,
                      std::vector<Study *> studies,
-                     PlotUtils::Cutter<CVUniverse, MichelEvent> &michelcuts,
-                     int targetCode)
+                     std::vector<Study *> everyEventStudies,
+                     const util::EntrySampler &sampler)
 {
   std::cout << "Starting data loop...\n";
-  //const int nEntries = 10000;
   const int nEntries = data->GetEntries();
   for (int i = 0; i < nEntries; ++i)
   {
+    if (!sampler.Keep(i)) continue;
     for (auto universe : data_band)
     {
       universe->SetEntry(i);
       if (i % 1000 == 0) std::cout << i << " / " << nEntries << "\r" << std::flush;
-      MichelEvent myevent;
-      for (auto &study : studies) study->Selected(*universe, myevent, 1);
-
-      //PROPOSAL!!!!!!!!!! - Extend the study class - Sidebands study, to have a method that is called pre-event selection to hide a lot of this sideband code - this comment is repeated above
-      //Capturing sidebands ------------------------------
-      //We want to do this before we perform our event selection cuts
-      // Checking if events that are reconstructed outside of our target of interest occur in our sideband region, which we are also interested in
-      //I.e this is the data event in the sideband region - to be later compared with the MC from the sideband region
-      if (util::isTargetSideband(universe, 1, targetCode, 1, true)) // Get true origins of the events reconstructed in the upstream region of tgt x
+      MichelEvent studyEvent;
+      for (auto &study : everyEventStudies) study->Selected(*universe, studyEvent, 1);
+      for (auto &study : studies) study->Selected(*universe, studyEvent, 1); // Once per entry, not once per target
+      for (auto &target : targets) // Every target in this pass shares the chain read
       {
+        const int targetCode = target.targetCode;
+        auto &vars = target.vars;
+        auto &vars2D = target.vars2D;
+        auto &michelcuts = *target.cuts;
+        MichelEvent myevent;
+
+        //PROPOSAL!!!!!!!!!! - Extend the study class - Sidebands study, to have a method that is called pre-event selection to hide a lot of this sideband code - this comment is repeated above
+        //Capturing sidebands ------------------------------
+        //We want to do this before we perform our event selection cuts
+        // Checking if events that are reconstructed outside of our target of interest occur in our sideband region, which we are also interested in
+        //I.e this is the data event in the sideband region - to be later compared with the MC from the sideband region
+        if (util::isTargetSideband(universe, 1, targetCode, 1, true)) // Get true origins of the events reconstructed in the upstream region of tgt x
+        {
+          for (auto &var : vars)
+            (*var->m_US_Sideband_Data).FillUniverse(universe, var->GetRecoValue(*universe), 1);
+          for (auto &var : vars2D)
+            (*var->m_US_Sideband_Data).FillUniverse(universe, var->GetRecoValueX(*universe), var->GetRecoValueY(*universe), 1);
+        }
+        else if (util::isTargetSideband(universe, 1, targetCode, 0, true)) // Get true origins of the events reconstructed in the downstream region of tgt x
+        {
+          for (auto &var : vars)
+            (*var->m_DS_Sideband_Data).FillUniverse(universe, var->GetRecoValue(*universe), 1);
+          for (auto &var : vars2D)
+            (*var->m_DS_Sideband_Data).FillUniverse(universe, var->GetRecoValueX(*universe), var->GetRecoValueY(*universe), 1);
+        }
+
+        //End - Capturing sidebands ------------------------------
+        if (!michelcuts.isDataSelected(*universe, myevent).all())
+          continue;
+
         for (auto &var : vars)
-          (*var->m_US_Sideband_Data).FillUniverse(universe, var->GetRecoValue(*universe), 1);
+          (*var->dataHist).FillUniverse(universe, var->GetRecoValue(*universe, myevent.m_idx), 1);
         for (auto &var : vars2D)
-          (*var->m_US_Sideband_Data).FillUniverse(universe, var->GetRecoValueX(*universe), var->GetRecoValueY(*universe), 1);
-      }
-      else if (util::isTargetSideband(universe, 1, targetCode, 0, true)) // Get true origins of the events reconstructed in the downstream region of tgt x
+          (*var->dataHist).FillUniverse(universe, var->GetRecoValueX(*universe), var->GetRecoValueY(*universe), 1);
+      } // End target loop
+
+      if (tracker)
       {
-        for (auto &var : vars)
-          (*var->m_DS_Sideband_Data).FillUniverse(universe, var->GetRecoValue(*universe), 1);
-        for (auto &var : vars2D)
-          (*var->m_DS_Sideband_Data).FillUniverse(universe, var->GetRecoValueX(*universe), var->GetRecoValueY(*universe), 1);
+        MichelEvent trackerEvent;
+        if (tracker->cuts->isDataSelected(*universe, trackerEvent).all())
+        {
+          const auto petal = tracker->petals.find(util::GetRecoDaisyPetal(*universe));
+          if (petal != tracker->petals.end()) petal->second->FillData(universe, trackerEvent);
+        }
       }
-
-      //End - Capturing sidebands ------------------------------
-      if (!michelcuts.isDataSelected(*universe, myevent).all())
-        continue;
-
-      for (auto &var : vars)
-        (*var->dataHist).FillUniverse(universe, var->GetRecoValue(*universe, myevent.m_idx), 1);
-      for (auto &var : vars2D)
-        (*var->dataHist).FillUniverse(universe, var->GetRecoValueX(*universe), var->GetRecoValueY(*universe), 1);
     }
   }
   std::cout << "Finished data loop.\n";
@@ -550,27 +714,29 @@ void LoopAndFillData(PlotUtils::ChainWrapper *data,
 
 void LoopAndFillEffDenom(PlotUtils::ChainWrapper *truth,
                          std::map<std::string, std::vector<CVUniverse *>> truth_bands,
-                         std::vector<Variable1DNuke *> vars,
-                         std::vector<Variable2DNuke *> vars2D,
-                         PlotUtils::Cutter<CVUniverse, MichelEvent> &michelcuts,
+                         std::vector<TargetSelection> &targets,
+                         TrackerSelection *tracker,
+                         util::AlternateModels *models,
                          PlotUtils::Model<CVUniverse, MichelEvent> &model,
-                         int targetCode)
+                         const util::EntrySampler &sampler,
+                         const double sampleWeight) // Corrects for sampling a slightly different fraction of the Truth tree than of the reco tree
 {
   assert(!truth_bands["cv"].empty() && "\"cv\" error band is empty!  Could not set Model entry.");
   auto &cvUniv = truth_bands["cv"].front();
 
   std::cout << "Starting efficiency denominator loop...\n";
   const int nEntries = truth->GetEntries();
-  //const int nEntries = 10000;
   for (int i = 0; i < nEntries; ++i)
   {
     if (i % 1000 == 0)
       std::cout << i << " / " << nEntries << "\r" << std::flush;
+    if (!sampler.Keep(i)) continue;
 
     MichelEvent cvEvent;
     cvUniv->SetEntry(i);
     model.SetEntry(*cvUniv, cvEvent);
     const double cvWeight = model.GetWeight(*cvUniv, cvEvent);
+    if (models) models->SetEntry();
 
     //=========================================
     // Systematics loop(s)
@@ -585,20 +751,44 @@ void LoopAndFillEffDenom(PlotUtils::ChainWrapper *truth,
 
         // Tell the Event which entry in the TChain it's looking at
         universe->SetEntry(i);
-        if (!michelcuts.isEfficiencyDenom(*universe, cvWeight))
-          continue;                                                // Weight is ignored for isEfficiencyDenom() in all but the CV universe
-        const double weight = model.GetWeight(*universe, myevent); // Only calculate the weight for events that will use it
-
-        // Fill efficiency denominator now:
-        for (auto var : vars)
+        double weight = 0;
+        bool weightIsSet = false; // Only calculate the weight for events that will use it, and only once for all targets
+        for (auto &target : targets) // Every target in this pass shares the chain read and the weight
         {
-          (*var->efficiencyDenominator).FillUniverse(universe, var->GetTrueValue(*universe), weight);
-          (*var->m_intChannelsEffDenom)[universe->GetInteractionType()].FillUniverse(universe, var->GetTrueValue(*universe), weight);
-        }
-        for (auto var : vars2D)
+          const auto &vars = target.vars;
+          const auto &vars2D = target.vars2D;
+          if (!target.cuts->isEfficiencyDenom(*universe, cvWeight))
+            continue; // Weight is ignored for isEfficiencyDenom() in all but the CV universe
+          if (!weightIsSet)
+          {
+            weight = sampleWeight * model.GetWeight(*universe, myevent);
+            weightIsSet = true;
+          }
+          if (target.modelHists && band.first == "cv") target.modelHists->FillEffDenom(*universe, models->Weights(*universe, myevent), sampleWeight);
+          if (target.reweightTrees && band.first == "cv") target.reweightTrees->FillEffDenom(i, *universe, myevent);
+
+          // Fill efficiency denominator now:
+          for (auto var : vars)
+          {
+            (*var->efficiencyDenominator).FillUniverse(universe, var->GetTrueValue(*universe), weight);
+            (*var->m_intChannelsEffDenom)[universe->GetInteractionType()].FillUniverse(universe, var->GetTrueValue(*universe), weight);
+          }
+          for (auto var : vars2D)
+          {
+            (*var->m_intChannelsEffDenom)[universe->GetInteractionType()].FillUniverse(universe, var->GetTrueValueX(*universe), var->GetTrueValueY(*universe), weight);
+            (*var->efficiencyDenominator).FillUniverse(universe, var->GetTrueValueX(*universe), var->GetTrueValueY(*universe), weight);
+          }
+        } // End target loop
+
+        if (tracker && tracker->cuts->isEfficiencyDenom(*universe, cvWeight))
         {
-          (*var->m_intChannelsEffDenom)[universe->GetInteractionType()].FillUniverse(universe, var->GetTrueValueX(*universe), var->GetTrueValueY(*universe), weight);
-          (*var->efficiencyDenominator).FillUniverse(universe, var->GetTrueValueX(*universe), var->GetTrueValueY(*universe), weight);
+          if (!weightIsSet)
+          {
+            weight = sampleWeight * model.GetWeight(*universe, myevent);
+            weightIsSet = true;
+          }
+          const auto petal = tracker->petals.find(util::GetTrueDaisyPetal(*universe));
+          if (petal != tracker->petals.end()) petal->second->FillEffDenom(universe, weight);
         }
       }
     }
@@ -698,6 +888,12 @@ std::string breakUpInputFileList(std::string inputFile, int numTotal, int thisNu
     return outfile;
 }
 
+// Output file name for one target.  Grid subruns get their process number so that they don't overwrite each other.
+std::string targetOutFileName(const std::string &base, const int tgt, const std::string &bandShardSuffix)
+{
+  return base + std::to_string(tgt) + bandShardSuffix + (nSubruns != 0 ? "_n" + std::to_string(nProcess) : "") + ".root";
+}
+
 //==============================================================================
 // Main
 //==============================================================================
@@ -721,6 +917,19 @@ int main(const int argc, const char **argv)
   std::string mc_file_list = argv[2],
                     data_file_list = argv[1];
   std::vector<int> targets = {};
+  double memoryBudgetMB = 0;
+  bool incremental = false;
+  int sampleEvery = 1;
+  std::string bandList; // Empty for every systematic
+  std::set<std::string> bandGroups;
+  bool bandShardData = false; // Whether a job with --bands loops over the data too
+  std::vector<int> trackerPetals; // Empty unless the tracker analysis runs too
+  bool doValidations = false;
+  CutScan::Points scanPoints; // Empty unless scanning cut thresholds
+  std::vector<util::ModelConfig> alternateModels; // Tunes and warps besides the nominal one
+  bool doReweightTrees = false;
+  std::string derivedMCFile, derivedDataFile; // Empty unless MakeDerivedKinematics' friend trees are used
+  bool usePreFilter = true;
   if (argc > 3)
   {
     for (int i = 3; i < argc; i++)
@@ -730,6 +939,99 @@ int main(const int argc, const char **argv)
         verbose = true;
         std::cout<<"Running in verbose mode\n";
       }
+      else if (std::string(argv[i])=="--incremental")
+      {
+        incremental = true;
+        std::cout<<"Only processing files that aren't in the existing output files yet\n";
+      }
+      else if (std::string(argv[i])=="--memory-budget" && i+1 < argc)
+      {
+        memoryBudgetMB = std::stod(argv[++i]);
+        std::cout<<"Filling as many targets at once as fit in " << memoryBudgetMB << " MB\n";
+      }
+      else if (std::string(argv[i])=="--bands" && i+1 < argc)
+      {
+        bandList = argv[++i];
+        try
+        {
+          bandGroups = ParseSystematicGroups(bandList);
+        }
+        catch (const std::runtime_error &e)
+        {
+          std::cerr << e.what() << "\n" << USAGE << "\n";
+          return badCmdLine;
+        }
+        std::cout<<"Only filling the error bands for " << bandList << "\n";
+      }
+      else if (std::string(argv[i])=="--data")
+      {
+        bandShardData = true;
+        std::cout<<"Looping over the data even if only filling some error bands\n";
+      }
+      else if (std::string(argv[i])=="--tracker" && i+1 < argc)
+      {
+        std::string petalList = argv[++i];
+        if (petalList == "all") petalList = "-1,0,1,2,3,4,5,6,7,8,9,10,11";
+        std::stringstream petals(petalList);
+        for (std::string petal; std::getline(petals, petal, ',');) trackerPetals.push_back(std::stoi(petal));
+        std::cout<<"Also running the tracker analysis for daisy petals " << petalList << "\n";
+      }
+      else if (std::string(argv[i])=="--validations")
+      {
+        doValidations = true;
+        std::cout<<"Also filling the vertex validation histograms\n";
+      }
+      else if (std::string(argv[i])=="--scan" && i+1 < argc)
+      {
+        try
+        {
+          CutScan::ParsePoints(argv[++i], scanPoints);
+        }
+        catch (const std::exception &e)
+        {
+          std::cerr << e.what() << "\n" << USAGE << "\n";
+          return badCmdLine;
+        }
+        std::cout<<"Also scanning " << argv[i] << "\n";
+      }
+      else if (std::string(argv[i])=="--model" && i+1 < argc)
+      {
+        try
+        {
+          alternateModels.push_back(util::ModelConfig::Parse(argv[++i]));
+        }
+        catch (const std::runtime_error &e)
+        {
+          std::cerr << e.what() << "\n" << USAGE << "\n";
+          return badCmdLine;
+        }
+        std::cout<<"Also filling histograms for model " << argv[i] << "\n";
+      }
+      else if (std::string(argv[i])=="--reweight-tree")
+      {
+        doReweightTrees = true;
+        std::cout<<"Also saving each reweighter's factor for every selected and efficiency denominator event\n";
+      }
+      else if (std::string(argv[i])=="--derived-mc" && i+1 < argc)
+      {
+        derivedMCFile = argv[++i];
+        std::cout<<"Reading derived kinematics for the MC from " << derivedMCFile << "\n";
+      }
+      else if (std::string(argv[i])=="--derived-data" && i+1 < argc)
+      {
+        derivedDataFile = argv[++i];
+        std::cout<<"Reading derived kinematics for the data from " << derivedDataFile << "\n";
+      }
+      else if (std::string(argv[i])=="--no-prefilter")
+      {
+        usePreFilter = false;
+        std::cout<<"Running every MC entry through every universe\n";
+      }
+      else if (std::string(argv[i])=="--sample" && i+1 < argc)
+      {
+        sampleEvery = std::stoi(argv[++i]);
+        std::cout<<"Only processing 1 in every " << sampleEvery << " clusters of entries\n";
+      }
       else
       {
         int tgtToAdd = std::stoi(argv[i]);
@@ -738,7 +1040,20 @@ int main(const int argc, const char **argv)
       }
     }
   }
-  else // If no argument is given, do all targets
+  // Band shards of the same job can share a directory
+  std::string bandShardSuffix = bandList.empty() ? "" : "_" + bandList;
+  std::replace(bandShardSuffix.begin(), bandShardSuffix.end(), ',', '-');
+
+  // Every band shard would fill the same data histograms, so only the one with --data does
+  const bool fillData = bandList.empty() || bandShardData;
+  if (!fillData && (doValidations || !scanPoints.empty()))
+  {
+    std::cerr << "--validations and --scan fill data histograms, so a job with --bands needs --data to use them.\n"
+              << USAGE << "\n";
+    return badCmdLine;
+  }
+
+  if (targets.empty()) // If no target is given, do all targets
   {
     for (auto code : util::TgtCodeLabelsNuke)
     {
@@ -789,9 +1104,148 @@ int main(const int argc, const char **argv)
     data_file_list= breakUpInputFileList(data_file_list, nSubruns , nProcess);
   }
 
+  // In incremental mode, only loop over the files that aren't in the existing outputs yet.  If only one playlist
+  // got new files, the other one's chain is still needed to set up the universes, but it isn't looped over.
+  bool doMC = true, doData = fillData;
+  if (incremental)
+  {
+    if (nSubruns != 0)
+    {
+      std::cerr << "--incremental can't be used with NumGridSubruns because new files change how the playlists are split up.\n"
+                << USAGE << "\n";
+      return badCmdLine;
+    }
+    if (!trackerPetals.empty())
+    {
+      std::cerr << "--incremental can't be used with --tracker because the tracker outputs don't record which files they used.\n"
+                << USAGE << "\n";
+      return badCmdLine;
+    }
+    if (doValidations)
+    {
+      std::cerr << "--incremental can't be used with --validations because the validation outputs don't record which files they used.\n"
+                << USAGE << "\n";
+      return badCmdLine;
+    }
+    if (!scanPoints.empty())
+    {
+      std::cerr << "--incremental can't be used with --scan because the scan outputs don't record which files they used.\n"
+                << USAGE << "\n";
+      return badCmdLine;
+    }
+    if (!alternateModels.empty())
+    {
+      std::cerr << "--incremental can't be used with --model because the model outputs don't record which files they used.\n"
+                << USAGE << "\n";
+      return badCmdLine;
+    }
+    if (doReweightTrees)
+    {
+      std::cerr << "--incremental can't be used with --reweight-tree because the reweighter factor trees can't be added together.\n"
+                << USAGE << "\n";
+      return badCmdLine;
+    }
+    if (sampleEvery != 1)
+    {
+      std::cerr << "--incremental can't be used with --sample because the output files would claim to have used every entry in the new files.\n"
+                << USAGE << "\n";
+      return badCmdLine;
+    }
+
+    std::vector<std::string> newMCFiles, newDataFiles;
+    try
+    {
+      std::set<std::string> usedMCFiles, usedDataFiles;
+      for (auto tgt : targets)
+      {
+        const auto mcFiles = util::readInputFiles(MC_OUT_FILE_NAME_BASE + std::to_string(tgt) + bandShardSuffix + ".root");
+        const auto dataFiles = fillData ? util::readInputFiles(DATA_OUT_FILE_NAME_BASE + std::to_string(tgt) + ".root") : std::set<std::string>();
+        if (tgt == targets.front())
+        {
+          usedMCFiles = mcFiles;
+          usedDataFiles = dataFiles;
+        }
+        else if (mcFiles != usedMCFiles || dataFiles != usedDataFiles)
+          throw std::runtime_error("Outputs for target " + std::to_string(tgt) + " were made from different files than target " + std::to_string(targets.front()) + ".  Run them separately.");
+      }
+
+      const auto newMCList = util::writeNewPlaylistFiles(mc_file_list, usedMCFiles, newMCFiles);
+      const auto newDataList = fillData ? util::writeNewPlaylistFiles(data_file_list, usedDataFiles, newDataFiles) : data_file_list;
+      if (!newMCFiles.empty()) mc_file_list = newMCList;
+      if (!newDataFiles.empty()) data_file_list = newDataList;
+    }
+    catch (const std::runtime_error &e)
+    {
+      std::cerr << "Can't run incrementally: " << e.what() << "\n";
+      return badInputFile;
+    }
+
+    std::cout << "Found " << newMCFiles.size() << " new MC files and " << newDataFiles.size() << " new data files\n";
+    doMC = !newMCFiles.empty();
+    doData = fillData && !newDataFiles.empty();
+    if (!doMC && !doData) return success;
+  }
+  const auto mcInputFiles = util::readPlaylistFiles(mc_file_list), dataInputFiles = util::readPlaylistFiles(data_file_list);
+
+  // Hash of everything the outputs depend on besides the target.  Incremental runs add to outputs with some other hash.
+  std::unique_ptr<util::ResultCache> results;
+  const char* cacheDir = getenv("MNV_EVENTLOOP_CACHE");
+  if (!incremental)
+  {
+    try
+    {
+      results.reset(new util::ResultCache(cacheDir ? cacheDir : "",
+                                          util::ResultCache::CodeVersion() + "\n" + util::ResultCache::DescribePlaylist(mc_file_list)
+                                          + util::ResultCache::DescribePlaylist(data_file_list)
+                                          + util::ResultCache::DescribeEnvironment({"MnvTune", "NO_2P2H_WARP", "AMU_DIS_WARP", "LOW_Q2_PION_WARP", "SUSA_2P2H_WARP",
+                                                                                    "MNV101_SKIP_SYST", "NumGridSubruns", "PROCESS",
+                                                                                    "PLOTUTILSROOT", "MPARAMFILESROOT", "MPARAMFILES"})
+                                          + "sample 1 in " + std::to_string(sampleEvery) + "\n" + "bands " + bandList + (fillData ? "" : " without data") + "\n"));
+    }
+    catch (const std::runtime_error &e)
+    {
+      std::cerr << "Can't hash this job's configuration, so output files won't have a ConfigHash and the result cache is off: " << e.what() << "\n";
+    }
+  }
+  const bool useCache = results && cacheDir != nullptr && scanPoints.empty() && alternateModels.empty() && !doReweightTrees; // A cached target wouldn't get its extra outputs
+
+  if (useCache)
+  {
+    std::vector<int> notCached;
+    try
+    {
+      for (auto tgt : targets)
+      {
+        if (results->Restore(tgt))
+          std::cout << "Reusing the outputs for target " << tgt << " from the result cache in " << cacheDir << "\n";
+        else
+          notCached.push_back(tgt);
+      }
+      targets = notCached;
+    }
+    catch (const std::runtime_error &e)
+    {
+      std::cerr << "Running every target because the result cache failed: " << e.what() << "\n";
+    }
+    if (targets.empty() && trackerPetals.empty() && !doValidations) return success;
+  }
+
   PlotUtils::MacroUtil options(reco_tree_name, mc_file_list, data_file_list, playlistname, true);
   options.m_plist_string = util::GetPlaylist(*options.m_mc, true); // TODO: Put GetPlaylist into PlotUtils::MacroUtil
 
+  // A sampled job's POT is the fraction of the POT that went into the entries it actually used.  The MC POT goes with
+  // the reco tree, so the Truth tree is reweighted if a slightly different fraction of it gets sampled.
+  const util::EntrySampler mcSampler(options.m_mc->GetEntries(), sampleEvery), truthSampler(options.m_truth->GetEntries(), sampleEvery),
+                           dataSampler(options.m_data->GetEntries(), sampleEvery);
+  const double truthSampleWeight = mcSampler.Fraction() / truthSampler.Fraction();
+  if (sampleEvery != 1)
+  {
+    options.m_mc_pot *= mcSampler.Fraction();
+    options.m_data_pot *= dataSampler.Fraction();
+    std::cout << "Sampling " << mcSampler.Fraction() << " of the MC and " << dataSampler.Fraction() << " of the data.  Scaled POT to "
+              << options.m_mc_pot << " for MC and " << options.m_data_pot << " for data.\n";
+  }
+
   // You're required to make some decisions
   PlotUtils::MinervaUniverse::SetNuEConstraint(true);
   PlotUtils::MinervaUniverse::SetPlaylist(options.m_plist_string); // TODO: Infer this from the files somehow?
@@ -808,145 +1262,46 @@ int main(const int argc, const char **argv)
 
   PlotUtils::MinervaUniverse::RPAMaterials(true);
 
-  const bool NO_2P2H_WARP = (getenv("NO_2P2H_WARP") != nullptr);
-  if (NO_2P2H_WARP)
-  {
-    std::cout << "Turning off LowRecoil2p2hReweighter because environment variable NO_2P2H_WARP is set.\n";
-  }
-  const bool AMU_DIS_WARP = (getenv("AMU_DIS_WARP") != nullptr);
-  if (AMU_DIS_WARP)
-  {
-    std::cout << "Turning on AMUDISReweighter because environment variable AMU_DIS_WARP is set.\n";
-  }
-  const bool LOW_Q2_PION_WARP = (getenv("LOW_Q2_PION_WARP") != nullptr);
-  if (LOW_Q2_PION_WARP)
-  {
-    std::cout << "Turning on LowQ2PiReweighter because environment variable LOW_Q2_PION_WARP is set.\n";
-  }
-  const bool SUSA_2P2H_WARP = (getenv("SUSA_2P2H_WARP") != nullptr);
-  if (SUSA_2P2H_WARP)
-  {
-    std::cout << "Replace LowRecoil2p2hReweighter with SuSAFromValencia2p2hReweighter because environment variable SUSA_2P2H_WARP is set.\n";
-  }
-
-  //Tune version vA.B.C
-  int tuneA = 1;
-  int tuneB = 0;
-  int tuneC = 0;
-  const char* mnvTuneIn =  getenv("MnvTune");
-  if (mnvTuneIn != nullptr)
-  {
-    std::string mnvTuneStr = std::string(mnvTuneIn);
-    if (mnvTuneStr.size()!=3 || !std::isdigit(mnvTuneStr[0]) || !std::isdigit(mnvTuneStr[1]) || !std::isdigit(mnvTuneStr[2])) "Unrecognised tune, using default";
-    else
-    { 
-      int tune = std::stoi(mnvTuneStr);
-      tuneC=tune%10;
-      tuneB = ((tune-tuneC)/10)%10;
-      tuneA = (tune -(tuneC + tuneB*10))/100;
-    }
-  }
-  std::cout<< "Using minerva tune v" << tuneA << "."<< tuneB << "."<< tuneC << "\n";
+  // The tune and warps come from the environment
+  const util::ModelConfig nominalModel = util::ModelConfig::FromEnvironment();
+  if (nominalModel.warps.count("NO_2P2H_WARP")) std::cout << "Turning off LowRecoil2p2hReweighter because environment variable NO_2P2H_WARP is set.\n";
+  if (nominalModel.warps.count("AMU_DIS_WARP")) std::cout << "Turning on AMUDISReweighter because environment variable AMU_DIS_WARP is set.\n";
+  if (nominalModel.warps.count("LOW_Q2_PION_WARP")) std::cout << "Turning on LowQ2PiReweighter because environment variable LOW_Q2_PION_WARP is set.\n";
+  if (nominalModel.warps.count("SUSA_2P2H_WARP")) std::cout << "Replace LowRecoil2p2hReweighter with SuSAFromValencia2p2hReweighter because environment variable SUSA_2P2H_WARP is set.\n";
+  std::cout<< "Using minerva tune " << nominalModel.TuneName() << "\n";
 
-  std::vector<std::unique_ptr<PlotUtils::Reweighter<CVUniverse, MichelEvent>>> MnvTune;
-  //Setting the A component of mnvtune vA.B.C
-  if (tuneA == 1)
-  {
-    MnvTune.emplace_back(new PlotUtils::FluxAndCVReweighter<CVUniverse, MichelEvent>());
-    MnvTune.emplace_back(new PlotUtils::GENIEReweighter<CVUniverse, MichelEvent>(true, false));
-    MnvTune.emplace_back(new PlotUtils::MINOSEfficiencyReweighter<CVUniverse, MichelEvent>());
-    MnvTune.emplace_back(new PlotUtils::RPAReweighter<CVUniverse, MichelEvent>());
-    MnvTune.emplace_back(new PlotUtils::LowRecoil2p2hReweighter<CVUniverse, MichelEvent>());
-  }
-  if (tuneA == 2)
-  {
-    MnvTune.emplace_back(new PlotUtils::FluxAndCVReweighter<CVUniverse, MichelEvent>());
-    MnvTune.emplace_back(new PlotUtils::GENIEReweighter<CVUniverse, MichelEvent>(true, false));
-    MnvTune.emplace_back(new PlotUtils::MINOSEfficiencyReweighter<CVUniverse, MichelEvent>());
-    MnvTune.emplace_back(new PlotUtils::RPAReweighter<CVUniverse, MichelEvent>());
-    MnvTune.emplace_back(new PlotUtils::LowRecoil2p2hReweighter<CVUniverse, MichelEvent>());
-    MnvTune.emplace_back(new PlotUtils::LowQ2PiReweighter<CVUniverse, MichelEvent>("JOINT")); //Is JOINT the correct option for mnvtune2?
-  }
-  if (tuneA == 3)
-  {
-    MnvTune.emplace_back(new PlotUtils::FluxAndCVReweighter<CVUniverse, MichelEvent>());
-    MnvTune.emplace_back(new PlotUtils::GENIEReweighter<CVUniverse, MichelEvent>(true, false));
-    MnvTune.emplace_back(new PlotUtils::MINOSEfficiencyReweighter<CVUniverse, MichelEvent>());
-    MnvTune.emplace_back(new PlotUtils::RPAReweighter<CVUniverse, MichelEvent>());
-    MnvTune.emplace_back(new PlotUtils::SuSAFromValencia2p2hReweighter<CVUniverse, MichelEvent>());
-    MnvTune.emplace_back(new PlotUtils::BodekRitchieReweighter<CVUniverse, MichelEvent>(2)); //Is 2 the right mode?
-  }
-  if (tuneA == 4)
+  if (nominalModel.tuneA == 4)
   {
     PlotUtils::MinervaUniverse::SetReadoutVolume("Nuke");
     PlotUtils::MinervaUniverse::SetMHRWeightNeutronCVReweight( true );
     PlotUtils::MinervaUniverse::SetMHRWeightElastics( true );
-    MnvTune.emplace_back(new PlotUtils::FluxAndCVReweighter<CVUniverse, MichelEvent>());
-    MnvTune.emplace_back(new PlotUtils::GENIEReweighter<CVUniverse, MichelEvent>(true, true));
-    MnvTune.emplace_back(new PlotUtils::MINOSEfficiencyReweighter<CVUniverse, MichelEvent>());
-    MnvTune.emplace_back(new PlotUtils::RPAReweighter<CVUniverse, MichelEvent>());
-    MnvTune.emplace_back(new PlotUtils::LowRecoil2p2hReweighter<CVUniverse, MichelEvent>());
-    //Other decisions to add for MnvTunev4.3.1
-  }
-  //Setting the B component of mnvtune vA.B.C
-  if (tuneB == 3)
-  {
-    MnvTune.emplace_back(new PlotUtils::LowQ2PiReweighter<CVUniverse, MichelEvent>("MENU1PI"));
-    MnvTune.emplace_back(new PlotUtils::DiffractiveReweighter<CVUniverse, MichelEvent>());
-    MnvTune.emplace_back(new PlotUtils::COHPionReweighter<CVUniverse, MichelEvent>());
-  }
-  //Setting the C component of mnvtune vA.B.C
-  if (tuneC == 1)
-  {
-    MnvTune.emplace_back(new PlotUtils::FSIReweighter<CVUniverse, MichelEvent>(true, true));
   }
 
+  std::vector<std::unique_ptr<PlotUtils::Reweighter<CVUniverse, MichelEvent>>> MnvTune;
+  for (const auto &component : nominalModel.Components()) MnvTune.push_back(util::MakeReweighter(component));
+  std::cout<<"Tune components applied:\n";
+  for (auto&& t : MnvTune) std::cout<< "\t"<< t->GetName() <<std::endl;
 
-  //Warps
-  if (SUSA_2P2H_WARP) //Replacing LowRecoil2p2hReweighter with SuSAFromValencia2p2hReweighter
+  // --model's tunes and warps get CV-only histograms.  Tune v4 changes how every universe is set up, so it can't mix with the others.
+  std::unique_ptr<util::AlternateModels> models;
+  std::shared_ptr<util::ReweighterFactors> reweighterFactors; // Shared by every target's ReweightTrees
+  if (doReweightTrees) reweighterFactors = std::make_shared<util::ReweighterFactors>();
+  if (!alternateModels.empty())
   {
-    auto it = find_if(MnvTune.begin(), MnvTune.end(), [] (auto& w) { return w->GetName() == "LowRecoil2p2hTune"; } );
-    if (it!=MnvTune.end())
-    {
-      std::cout<<"Applying SUSA_2P2H_WARP - replacing LowRecoil2p2hTune with SuSAFromValencia2p2hReweighter\n";
-      (*it) = std::unique_ptr<PlotUtils::Reweighter<CVUniverse, MichelEvent>>(new PlotUtils::SuSAFromValencia2p2hReweighter<CVUniverse, MichelEvent>());
-    }
-    else
+    for (const auto &alternate : alternateModels)
     {
-      auto it2 = find_if(MnvTune.begin(), MnvTune.end(), [] (auto& w) { return w->GetName() == "SuSA2p2h"; } );
-      if (it2==MnvTune.end())
-      {
-        std::cout<<"WARNING - SUSA_2P2H_WARP - no LowRecoil2p2hTune found to replace, applying SuSAFromValencia2p2hReweighter anyway\n";
-        MnvTune.emplace_back(new PlotUtils::SuSAFromValencia2p2hReweighter<CVUniverse, MichelEvent>());
-      }
-      else
+      if ((alternate.tuneA == 4) != (nominalModel.tuneA == 4))
       {
-        std::cout<<"WARNING - SUSA_2P2H_WARP - no LowRecoil2p2hTune found to replace and  SuSA2p2h already set, so I'm doing nothing\n";
+        std::cerr << "Model " << alternate.name << " uses tune " << alternate.TuneName() << ", but tune v4 can only be mixed with other v4 tunes, and MnvTune is "
+                  << nominalModel.TuneName() << ".\n" << USAGE << "\n";
+        return badCmdLine;
       }
     }
+    models.reset(new util::AlternateModels(alternateModels));
+    std::cout << "Also filling CV histograms for " << alternateModels.size() << " models from " << models->NComponents() << " distinct reweighters:\n";
+    for (size_t whichModel = 0; whichModel < alternateModels.size(); ++whichModel)
+      std::cout << "\t" << models->Names()[whichModel] << ": " << models->Descriptions()[whichModel] << "\n";
   }
-  if (NO_2P2H_WARP) //Removing LowRecoil2p2hReweighter
-  {
-    auto it = find_if(MnvTune.begin(), MnvTune.end(), [] (auto& w) { return w->GetName() == "LowRecoil2p2hTune"; } );
-    if (it!=MnvTune.end())
-    {
-      MnvTune.erase(it);
-      std::cout<<"Applying NO_2P2H_WARP - removing found LowRecoil2p2hReweighter\n";
-    }
-    else std::cout<<"Warning - NO_2P2H_WARP - Could not apply warp since there were no 2p2h reweighters found\n";
-  }
-  if (AMU_DIS_WARP)
-  {
-    std::cout<<"Applying no AMU_DIS_WARP - Applying AMUDISReweighter\n";
-    MnvTune.emplace_back(new PlotUtils::AMUDISReweighter<CVUniverse, MichelEvent>());
-  }
-  if (LOW_Q2_PION_WARP)  // Low Q2 pion suppression (mnvtunev2)
-  {
-    std::cout<<"Applying no LOW_Q2_PION_WARP - Applying LowQ2PiReweighter\n";
-    MnvTune.emplace_back(new PlotUtils::LowQ2PiReweighter<CVUniverse, MichelEvent>("JOINT"));
-  }
-  std::cout<<"Tune components applied:\n";
-  for (auto&& t : MnvTune) std::cout<< "\t"<< t->GetName() <<std::endl;
   //Do we need all this for v 4.3.1? I found it somewhere else but idk if I need it here
   //https://github.com/MinervaExpt/LowRecoilPions/blob/902f51bd72e1dff74d26e0df7158f27750947521/studies2DEventLoop.cpp
   //Could also wrap all v431 cuts in one reweighter like https://github.com/MinervaExpt/LowRecoilPions/blob/902f51bd72e1dff74d26e0df7158f27750947521/twoDEventLoopSide.cpp
@@ -967,9 +1322,26 @@ int main(const int argc, const char **argv)
     PlotUtils::MinervaUniverse::SetNFluxUniverses(2); // Necessary to get Flux integral later...  Doesn't work with just 1 flux universe though because _that_ triggers "spread errors".
   }
 
+  // Universes find their chain's friend trees when they're constructed
+  try
+  {
+    if (!derivedMCFile.empty())
+    {
+      util::DerivedKinematics::Attach(options.m_mc, std::make_shared<util::DerivedKinematics>(derivedMCFile, reco_tree_name, mcInputFiles, options.m_mc->GetEntries()));
+      util::DerivedKinematics::Attach(options.m_truth, std::make_shared<util::DerivedKinematics>(derivedMCFile, "Truth", mcInputFiles, options.m_truth->GetEntries()));
+    }
+    if (!derivedDataFile.empty())
+      util::DerivedKinematics::Attach(options.m_data, std::make_shared<util::DerivedKinematics>(derivedDataFile, reco_tree_name, dataInputFiles, options.m_data->GetEntries()));
+  }
+  catch (const std::runtime_error &e)
+  {
+    std::cerr << e.what() << "\n" << USAGE << "\n";
+    return badInputFile;
+  }
+
   std::map<std::string, std::vector<CVUniverse *>> error_bands;
   if (doSystematics)
-    error_bands = GetStandardSystematics(options.m_mc);
+    error_bands = GetStandardSystematics(options.m_mc, bandGroups);
   else
   {
     std::map<std::string, std::vector<CVUniverse *>> band_flux = PlotUtils::GetFluxSystematicsMap<CVUniverse>(options.m_mc, CVUniverse::GetNFluxUniverses());
@@ -978,12 +1350,9 @@ int main(const int argc, const char **argv)
   error_bands["cv"] = {new CVUniverse(options.m_mc)};
   std::map<std::string, std::vector<CVUniverse *>> truth_bands;
   if (doSystematics)
-    truth_bands = GetStandardSystematics(options.m_truth);
+    truth_bands = GetStandardSystematics(options.m_truth, bandGroups);
   truth_bands["cv"] = {new CVUniverse(options.m_truth)};
 
-  std::vector<Variable1DNuke *> nukeVars;
-  std::vector<Variable2DNuke *> nukeVars2D;
-
   std::vector<double> RecoilBins, segmentBins, angleBins;
   // const double RecoilBinWidth = 50; //MeV
   // for(int whichBin = 0; whichBin < 100 + 1; ++whichBin) RecoilBins.push_back(RecoilBinWidth * whichBin);
@@ -1001,49 +1370,30 @@ int main(const int argc, const char **argv)
   std::function<double(const CVUniverse &)> muonAngleDegrees = [](const CVUniverse &univ) { return (univ.GetThetamu() * 180 / M_PI); };
   std::function<double(const CVUniverse &)> muonAngleDegreesTruth = [](const CVUniverse &univ) { return (univ.GetDouble("truth_muon_theta")* 180 / M_PI); };
 
-  nukeVars.push_back(new Variable1DNuke("pTmu", "p_{T, #mu} [GeV/c]", util::PTBins, &CVUniverse::GetANNMuonPTGeV, &CVUniverse::GetMuonPTTrue));
-  nukeVars.push_back(new Variable1DNuke("pZmu", "p_{||, #mu} [GeV/c]", util::PzBins, &CVUniverse::GetANNMuonPzGeV, &CVUniverse::GetMuonPzTrue));
-  nukeVars.push_back(new Variable1DNuke("Emu", "E_{#mu} [GeV]", util::EmuBins, &CVUniverse::GetANNEmuGeV, &CVUniverse::GetElepTrueGeV));
-  nukeVars.push_back(new Variable1DNuke("Erecoil", "E_{recoil} [GeV]", util::Erecoilbins, &CVUniverse::GetANNRecoilEGeV, q0TrueGeV)); // TODO: q0 is not the same as recoil energy without a spline correction
-  nukeVars.push_back(new Variable1DNuke("BjorkenX", "X", util::bjorkenXbins, &CVUniverse::GetBjorkenX, &CVUniverse::GetBjorkenXTrue));
-  nukeVars.push_back(new Variable1DNuke("BjorkenY", "Y", util::bjorkenYbins, &CVUniverse::GetBjorkenY, &CVUniverse::GetBjorkenYTrue));
-  nukeVars.push_back(new Variable1DNuke("segment", "segmentNum", segmentBins, &CVUniverse::GetANNSegment, &CVUniverse::GetTruthSegment)); // Just used for plotting events by detector position tbh - not for any actual physics
-  nukeVars.push_back(new Variable1DNuke("beamAngle", "Angle", angleBins, muonAngleDegrees, muonAngleDegreesTruth));              // Neutrino angle 
-  nukeVars2D.push_back(new Variable2DNuke("pTmu_pZmu", *nukeVars[0], *nukeVars[1]));
-  nukeVars2D.push_back(new Variable2DNuke("Emu_Erecoil", *nukeVars[2], *nukeVars[3]));
-  nukeVars2D.push_back(new Variable2DNuke("BjorkenX_BjorkenY", *nukeVars[4], *nukeVars[5])); 
+  // Each target in a pass over the chains needs its own set of variables to hold its histograms
+  auto makeNukeVars = [&](std::vector<Variable1DNuke *> &nukeVars, std::vector<Variable2DNuke *> &nukeVars2D)
+  {
+    nukeVars.push_back(new Variable1DNuke("pTmu", "p_{T, #mu} [GeV/c]", util::PTBins, &CVUniverse::GetANNMuonPTGeV, &CVUniverse::GetMuonPTTrue));
+    nukeVars.push_back(new Variable1DNuke("pZmu", "p_{||, #mu} [GeV/c]", util::PzBins, &CVUniverse::GetANNMuonPzGeV, &CVUniverse::GetMuonPzTrue));
+    nukeVars.push_back(new Variable1DNuke("Emu", "E_{#mu} [GeV]", util::EmuBins, &CVUniverse::GetANNEmuGeV, &CVUniverse::GetElepTrueGeV));
+    nukeVars.push_back(new Variable1DNuke("Erecoil", "E_{recoil} [GeV]", util::Erecoilbins, &CVUniverse::GetANNRecoilEGeV, q0TrueGeV)); // TODO: q0 is not the same as recoil energy without a spline correction
+    nukeVars.push_back(new Variable1DNuke("BjorkenX", "X", util::bjorkenXbins, &CVUniverse::GetBjorkenX, &CVUniverse::GetBjorkenXTrue));
+    nukeVars.push_back(new Variable1DNuke("BjorkenY", "Y", util::bjorkenYbins, &CVUniverse::GetBjorkenY, &CVUniverse::GetBjorkenYTrue));
+    nukeVars.push_back(new Variable1DNuke("segment", "segmentNum", segmentBins, &CVUniverse::GetANNSegment, &CVUniverse::GetTruthSegment)); // Just used for plotting events by detector position tbh - not for any actual physics
+    nukeVars.back()->requireSidebands = true; // Extract*CrossSectionTargets and SidebandTuning.py read the segment sidebands for every target
+    nukeVars.push_back(new Variable1DNuke("beamAngle", "Angle", angleBins, muonAngleDegrees, muonAngleDegreesTruth));              // Neutrino angle 
+    nukeVars2D.push_back(new Variable2DNuke("pTmu_pZmu", *nukeVars[0], *nukeVars[1]));
+    nukeVars2D.push_back(new Variable2DNuke("Emu_Erecoil", *nukeVars[2], *nukeVars[3]));
+    nukeVars2D.push_back(new Variable2DNuke("BjorkenX_BjorkenY", *nukeVars[4], *nukeVars[5])); 
+  };
   //Probe some more variables?????
 
-  std::vector<Study *> studies;
-  std::function<double(const CVUniverse &, const MichelEvent &)> ptmu = [](const CVUniverse &univ, const MichelEvent & /* evt */)
-  { return univ.GetMuonPT(); };
-  std::function<double(const CVUniverse &, const MichelEvent &)> pzmu = [](const CVUniverse &univ, const MichelEvent & /* evt */)
-  { return univ.GetMuonPz(); };
-
-  // studies.push_back(new PerEventVarByGENIELabel2D(pzmu, ptmu, std::string("pzmu_vs_ptmu_GENIE_labels"), std::string("GeV/c"), dansPzBins, dansPTBins, error_bands));
-  // studies.push_back(new WaterTargetIntOrigin2D(pzmu, ptmu, std::string("pzmu_vs_ptmu_water_breakdown"), std::string("GeV/c"), dansPzBins, dansPTBins, error_bands));
-
-  CVUniverse *data_universe = new CVUniverse(options.m_data);
-  std::vector<CVUniverse *> data_band = {data_universe};
-  std::map<std::string, std::vector<CVUniverse *>> data_error_bands;
-  data_error_bands["cv"] = data_band;
-
-  std::vector<Study *> data_studies;
-  // data_studies.push_back(new PerEventVarByGENIELabel2D(ptmu, pzmu, std::string("ptmu_vs_pzmu"), std::string("GeV/c"), dansPTBins, dansPzBins, data_error_bands));
-  // Wouldn't make sense to do a PerEventVarByGENIELabel2D study for data since data wont have the GENIE simulation labels
-
-  for (auto tgt : targets)
+  // Each target's cuts.  --scan needs a second copy of them.
+  auto makeNukeCuts = [&](const int tgt, PlotUtils::Cutter<CVUniverse, MichelEvent>::reco_t &nukePreCut,
+                          PlotUtils::Cutter<CVUniverse, MichelEvent>::truth_t &nukeSignalDefinition, PlotUtils::Cutter<CVUniverse, MichelEvent>::truth_t &nukePhaseSpace)
   {
-    std::cout << "Trying target: " << tgt << std::endl;
-    if (tgt<1000) std::cout<<"\tWhich is a pseudotarget\n";
-
-
-
     // Now that we've defined what a cross section is, decide which sample and model
     // we're extracting a cross section for.
-    PlotUtils::Cutter<CVUniverse, MichelEvent>::reco_t nukeSidebands, nukePreCut;
-    PlotUtils::Cutter<CVUniverse, MichelEvent>::truth_t nukeSignalDefinition, nukePhaseSpace;
-
     nukePreCut = util::GetAnalysisCuts(nupdg);
     if (tgt >12 && tgt < 1000) nukePreCut.emplace_back(new reco::ZRangeANN<CVUniverse, MichelEvent>("Z pos in active tracker", 5810, 8600));
     else nukePreCut.emplace_back(new reco::ZRangeANN<CVUniverse, MichelEvent>("Z pos in Nuclear Targets", PlotUtils::TargetProp::NukeRegion::Face, PlotUtils::TargetProp::NukeRegion::Back));
@@ -1055,7 +1405,7 @@ int main(const int argc, const char **argv)
     if (nupdg > 0) nukeSignalDefinition.emplace_back(new truth::IsNeutrino<CVUniverse>());
     else if (nupdg < 0) nukeSignalDefinition.emplace_back(new truth::IsAntiNeutrino<CVUniverse>());
     nukeSignalDefinition.emplace_back(new truth::IsCC<CVUniverse>());
-    
+  
     nukeSignalDefinition.emplace_back(new truth::IsInTarget<CVUniverse>(tgt, false));
     //^^^ False for the usingExtendedTargetDefintion option even when we are doing an analysis with the extended target definition since we're really
     //looking for events in the targets and not in this extended scintillator region, that is just a means to an end (where the end is capturing
@@ -1071,145 +1421,496 @@ int main(const int argc, const char **argv)
     else nukePhaseSpace.emplace_back(new truth::ZRange<CVUniverse>("Z pos in Nuclear Targets", PlotUtils::TargetProp::NukeRegion::Face, PlotUtils::TargetProp::NukeRegion::Back));
 
     // nukePhaseSpace.emplace_back(new truth::PZMuMin<CVUniverse>(1500.));
+  };
 
-    PlotUtils::Cutter<CVUniverse, MichelEvent> nukeCuts(std::move(nukePreCut), std::move(nukeSidebands), std::move(nukeSignalDefinition), std::move(nukePhaseSpace));
+  // Estimate one target's histogram footprint to decide how many targets can share a pass over the chains
+  size_t nMCUniverses = 0, nTruthUniverses = 0, nMCLateral = 0, nTruthLateral = 0;
+  for (const auto &band : error_bands)
+  {
+    nMCUniverses += band.second.size();
+    if (!band.second.empty() && !band.second.front()->IsVerticalOnly()) nMCLateral += band.second.size();
+  }
+  for (const auto &band : truth_bands)
+  {
+    nTruthUniverses += band.second.size();
+    if (!band.second.empty() && !band.second.front()->IsVerticalOnly()) nTruthLateral += band.second.size();
+  }
+  double bytesPerTarget = 0;
+  {
+    std::vector<Variable1DNuke *> protoVars;
+    std::vector<Variable2DNuke *> protoVars2D;
+    makeNukeVars(protoVars, protoVars2D);
+    for (auto &var : protoVars) bytesPerTarget += var->EstimateHistBytes(nMCUniverses, nTruthUniverses, 1);
+    for (auto &var : protoVars2D) bytesPerTarget += var->EstimateHistBytes(nMCUniverses, nTruthUniverses, 1, nMCLateral, nTruthLateral);
+    for (auto &var : protoVars2D) delete var;
+    for (auto &var : protoVars) delete var;
+  }
 
+  std::vector<Study *> studies;
+  std::function<double(const CVUniverse &, const MichelEvent &)> ptmu = [](const CVUniverse &univ, const MichelEvent & /* evt */)
+  { return univ.GetMuonPT(); };
+  std::function<double(const CVUniverse &, const MichelEvent &)> pzmu = [](const CVUniverse &univ, const MichelEvent & /* evt */)
+  { return univ.GetMuonPz(); };
 
+  // studies.push_back(new PerEventVarByGENIELabel2D(pzmu, ptmu, std::string("pzmu_vs_ptmu_GENIE_labels"), std::string("GeV/c"), dansPzBins, dansPTBins, error_bands));
+  // studies.push_back(new WaterTargetIntOrigin2D(pzmu, ptmu, std::string("pzmu_vs_ptmu_water_breakdown"), std::string("GeV/c"), dansPzBins, dansPTBins, error_bands));
 
+  CVUniverse *data_universe = new CVUniverse(options.m_data);
+  std::vector<CVUniverse *> data_band = {data_universe};
+  std::map<std::string, std::vector<CVUniverse *>> data_error_bands;
+  data_error_bands["cv"] = data_band;
 
-    for (auto &var : nukeVars)
-      var->InitializeMCHists(error_bands, truth_bands);
-    for (auto &var : nukeVars)
-      var->InitializeDATAHists(data_band);
+  std::vector<Study *> data_studies;
+  // data_studies.push_back(new PerEventVarByGENIELabel2D(ptmu, pzmu, std::string("ptmu_vs_pzmu"), std::string("GeV/c"), dansPTBins, dansPzBins, data_error_bands));
+  // Wouldn't make sense to do a PerEventVarByGENIELabel2D study for data since data wont have the GENIE simulation labels
 
-    for (auto &var : nukeVars2D)
-      var->InitializeMCHists(error_bands, truth_bands);
-    for (auto &var : nukeVars2D)
-      var->InitializeDATAHists(data_band);
+  // Group targets into passes over the chains.  Without a memory budget, each target gets its own pass.
+  auto passes = groupTargetsIntoPasses(targets, bytesPerTarget, memoryBudgetMB);
+  if (passes.empty() && (!trackerPetals.empty() || doValidations)) passes.emplace_back(); // Every target came from the result cache
+  for (const auto &pass : passes)
+  {
+    // The tracker analysis shares the first pass over the chains
+    std::unique_ptr<TrackerSelection> tracker;
+    if (!trackerPetals.empty() && &pass == &passes.front())
+    {
+      tracker.reset(new TrackerSelection{util::GetTrackerCuts(nupdg), {}});
+      for (auto petal : trackerPetals)
+      {
+        auto &hists = tracker->petals[petal];
+        hists.reset(new util::TrackerHists(petal));
+        hists->InitializeHists(error_bands, truth_bands, data_band);
+      }
+    }
 
-    // Loop entries and fill
-    //try
-    //{
-      std::cout << "Staring event loops\n";
-      CVUniverse::SetTruth(false);
-      LoopAndFillEventSelection(options.m_mc, error_bands, nukeVars, nukeVars2D, studies, nukeCuts, model, tgt);
-      CVUniverse::SetTruth(true);
-      LoopAndFillEffDenom(options.m_truth, truth_bands, nukeVars, nukeVars2D, nukeCuts, model, tgt);
-      options.PrintMacroConfiguration(argv[0]);
-      std::cout << "Nuclear Target MC cut summary:\n"
-                << nukeCuts << "\n";
-      nukeCuts.resetStats();
-
-      CVUniverse::SetTruth(false);
-      LoopAndFillData(options.m_data, data_band, nukeVars, nukeVars2D, data_studies, nukeCuts, tgt);
-      std::cout << "Nuclear Target Data cut summary:\n"
-                << nukeCuts << "\n";
-
-      auto playlistStr = new TNamed("PlaylistUsed", options.m_plist_string);
-
-      std::string mcOutFileName = MC_OUT_FILE_NAME_BASE + std::to_string(tgt) + ".root";
-      if (nSubruns != 0 ) mcOutFileName = MC_OUT_FILE_NAME_BASE + std::to_string(tgt) + "_n"+nProcess+ ".root";
-      // Write MC results
-      TFile *mcOutDir = TFile::Open(mcOutFileName.c_str(), "RECREATE");
-      if (!mcOutDir)
+    // Skips MC entries that no universe could select in this pass
+    std::unique_ptr<util::ShiftPreFilter> preFilter;
+    if (usePreFilter)
+    {
+      try
       {
-        std::cerr << "Failed to open a file named " << mcOutFileName << " in the current directory for writing histograms.\n";
-        return badOutputFile;
+        preFilter.reset(new util::ShiftPreFilter(error_bands));
+        if (tracker) preFilter->AddSelection(util::GetTrackerPreCuts(nupdg));
       }
-      std::cout << "Saving " << studies.size() << " studies\n";
-      for (auto &study : studies)
-        study->SaveOrDraw(*mcOutDir);
-      std::cout << "Saved studies\n";
+      catch (const std::runtime_error &e)
+      {
+        std::cout << "Not pre-filtering MC entries: " << e.what() << "\n";
+      }
+    }
+
+    // So do runEventLoopValidations' histograms.  They see every event before the targets' cuts.
+    std::unique_ptr<VertexValidationStudy> mcValidations, dataValidations;
+    std::vector<Study *> mcEveryEventStudies, dataEveryEventStudies;
+    if (doValidations && &pass == &passes.front())
+    {
+      auto validations = std::make_shared<VertexValidations>(nupdg, verbose);
+      mcValidations.reset(new VertexValidationStudy(validations, false));
+      dataValidations.reset(new VertexValidationStudy(validations, true));
+      mcEveryEventStudies.push_back(mcValidations.get());
+      dataEveryEventStudies.push_back(dataValidations.get());
+    }
+
+    std::vector<TargetSelection> selections;
+    std::vector<std::unique_ptr<CutScanStudy>> scanStudies;
+    for (auto tgt : pass)
+    {
+      std::cout << "Trying target: " << tgt << std::endl;
+      if (tgt<1000) std::cout<<"\tWhich is a pseudotarget\n";
 
-      for (auto &var : nukeVars)
-        var->WriteMC(*mcOutDir);
-      std::cout << "Saved 1D Variables\n";
-      for (auto &var : nukeVars2D)
-        var->WriteMC(*mcOutDir);
-      std::cout << "Saved 2D Variables\n";
 
-      // Playlist name - Used for flux calculations later on
-      playlistStr->Write();
 
-      // Protons On Target
-      auto mcPOT = new TParameter<double>("POTUsed", options.m_mc_pot);
-      mcPOT->Write();
+      PlotUtils::Cutter<CVUniverse, MichelEvent>::reco_t nukeSidebands, nukePreCut;
+      PlotUtils::Cutter<CVUniverse, MichelEvent>::truth_t nukeSignalDefinition, nukePhaseSpace;
+
+      makeNukeCuts(tgt, nukePreCut, nukeSignalDefinition, nukePhaseSpace);
+      if (preFilter)
+      {
+        preFilter->AddSelection(nukePreCut);
+        preFilter->AddSideband(tgt);
+      }
 
-      PlotUtils::TargetUtils targetInfo;
-      assert(error_bands["cv"].size() == 1 && "List of error bands must contain a universe named \"cv\" for the flux integral.");
+      selections.push_back(TargetSelection{tgt, std::unique_ptr<PlotUtils::Cutter<CVUniverse, MichelEvent>>(new PlotUtils::Cutter<CVUniverse, MichelEvent>(std::move(nukePreCut), std::move(nukeSidebands), std::move(nukeSignalDefinition), std::move(nukePhaseSpace))), {}, {}});
+      auto &nukeVars = selections.back().vars;
+      auto &nukeVars2D = selections.back().vars2D;
+      makeNukeVars(nukeVars, nukeVars2D);
 
       for (auto &var : nukeVars)
+        var->InitializeMCHists(error_bands, truth_bands);
+      for (auto &var : nukeVars)
+        var->InitializeDATAHists(data_band);
+
+      for (auto &var : nukeVars2D)
+        var->InitializeMCHists(error_bands, truth_bands);
+      for (auto &var : nukeVars2D)
+        var->InitializeDATAHists(data_band);
+
+      if (doReweightTrees)
       {
-        // Flux integral only if systematics are being done (temporary solution)
-        util::GetFluxIntegral(*error_bands["cv"].front(), var->efficiencyNumerator->hist)->Write((var->GetName() + "_reweightedflux_integrated").c_str());
-        // Always use MC number of nucleons for cross section
-        // This may not even be necessary since we can always pull the same information in the extract cross section script as long ad we have the target information, which we do
-        TParameter<double> *nNucleons;
-        if (tgt == 6000)
-          nNucleons = new TParameter<double>((var->GetName() + "_fiducial_nucleons").c_str(), targetInfo.GetPassiveTargetNNucleons(6, 1, true));
-        else if (tgt >= 7 && tgt <= 11)
+        const std::string reweightOutFileName = targetOutFileName(REWEIGHT_OUT_FILE_NAME_BASE, tgt, bandShardSuffix);
+        try
         {
-          nNucleons = new TParameter<double>((var->GetName() + "_fiducial_nucleons").c_str(), targetInfo.GetTrackerNNucleons(6, true));
+          selections.back().reweightTrees.reset(new util::ReweightTrees(reweightOutFileName, reweighterFactors, std::vector<const PlotUtils::VariableBase<CVUniverse> *>(nukeVars.begin(), nukeVars.end())));
         }
-        else if (tgt == 12)
-          nNucleons = new TParameter<double>((var->GetName() + "_fiducial_nucleons").c_str(), targetInfo.GetTrackerNNucleons(2, true));
-        else if (tgt >12)
-          nNucleons = new TParameter<double>((var->GetName() + "_fiducial_nucleons").c_str(), targetInfo.GetTrackerNNucleons(6, true));
-        else
+        catch (const std::runtime_error &e)
         {
-          int tgtZ = tgt % 1000;
-          int tgtID = (tgt - tgtZ) / 1000;
-          nNucleons = new TParameter<double>((var->GetName() + "_fiducial_nucleons").c_str(), targetInfo.GetPassiveTargetNNucleons(tgtID, tgtZ, true));
+          std::cerr << e.what() << "\n";
+          return badOutputFile;
         }
-        nNucleons->Write();
       }
+      if (models) selections.back().modelHists.reset(new util::AlternateModelHists(*models, std::vector<const PlotUtils::VariableBase<CVUniverse> *>(nukeVars.begin(), nukeVars.end())));
 
-      mcOutDir->Close();
+      // The scan has its own copy of the target's cuts without the scanned ones
+      if (!scanPoints.empty())
+      {
+        PlotUtils::Cutter<CVUniverse, MichelEvent>::reco_t scanPreCut;
+        PlotUtils::Cutter<CVUniverse, MichelEvent>::truth_t scanSignalDefinition, scanPhaseSpace;
+        makeNukeCuts(tgt, scanPreCut, scanSignalDefinition, scanPhaseSpace);
+        try
+        {
+          selections.back().scan = std::make_shared<CutScan>(scanPoints, std::move(scanPreCut), std::move(scanSignalDefinition), std::move(scanPhaseSpace),
+                                                             std::vector<const PlotUtils::VariableBase<CVUniverse> *>(nukeVars.begin(), nukeVars.end()));
+        }
+        catch (const std::runtime_error &e)
+        {
+          std::cerr << "Can't scan target " << tgt << ": " << e.what() << "\n" << USAGE << "\n";
+          return badCmdLine;
+        }
+        scanStudies.emplace_back(new CutScanStudy(selections.back().scan, false));
+        mcEveryEventStudies.push_back(scanStudies.back().get());
+        scanStudies.emplace_back(new CutScanStudy(selections.back().scan, true));
+        dataEveryEventStudies.push_back(scanStudies.back().get());
+      }
+    }
 
-      // playlistStr = new TNamed("PlaylistUsed", options.m_plist_string);
-      // Write data results
-      std::string dataOutFileName = DATA_OUT_FILE_NAME_BASE + std::to_string(tgt) + ".root";
-      if (nSubruns != 0 ) dataOutFileName = DATA_OUT_FILE_NAME_BASE + std::to_string(tgt) + "_n"+nProcess+ ".root";
-      TFile *dataOutDir = TFile::Open(dataOutFileName.c_str(), "RECREATE");
-      if (!dataOutDir)
+    // Studies like the validations and scans apply their own cuts to every entry
+    if (!mcEveryEventStudies.empty()) preFilter.reset();
+
+    // Loop entries and fill
+    //try
+    //{
+      std::cout << "Staring event loops\n";
+      if (doMC)
       {
-        std::cerr << "Failed to open a file named " << dataOutFileName << " in the current directory for writing histograms.\n";
-        return badOutputFile;
+        CVUniverse::SetTruth(false);
+        LoopAndFillEventSelection(options.m_mc, error_bands, selections, tracker.get(), models.get(), preFilter.get(), studies, mcEveryEventStudies, model, mcSampler);
+        CVUniverse::SetTruth(true);
+        LoopAndFillEffDenom(options.m_truth, truth_bands, selections, tracker.get(), models.get(), model, truthSampler, truthSampleWeight);
+        options.PrintMacroConfiguration(argv[0]);
+        if (preFilter) std::cout << "The pre-filter skipped " << preFilter->NSkipped() << " MC entries that no universe could select.  They aren't in the MC cut summaries.\n";
+        for (auto &selection : selections)
+        {
+          std::cout << "Nuclear Target MC cut summary for target " << selection.targetCode << ":\n"
+                    << *selection.cuts << "\n";
+          selection.cuts->resetStats();
+        }
+        if (tracker)
+        {
+          std::cout << "Tracker MC cut summary:\n" << *tracker->cuts << "\n";
+          tracker->cuts->resetStats();
+        }
+        if (mcValidations)
+        {
+          std::cout << "Vertex validation MC cut summary:\n" << mcValidations->Validations().Cuts() << "\n";
+          mcValidations->Validations().Cuts().resetStats();
+        }
       }
 
-      for (auto &var : nukeVars)
-        var->WriteData(*dataOutDir);
-      for (auto &var : nukeVars2D)
-        var->WriteData(*dataOutDir);
+      if (doData)
+      {
+        CVUniverse::SetTruth(false);
+        LoopAndFillData(options.m_data, data_band, selections, tracker.get(), data_studies, dataEveryEventStudies, dataSampler);
+        for (auto &selection : selections)
+        {
+          std::cout << "Nuclear Target Data cut summary for target " << selection.targetCode << ":\n"
+                    << *selection.cuts << "\n";
+        }
+        if (tracker) std::cout << "Tracker Data cut summary:\n" << *tracker->cuts << "\n";
+        if (dataValidations) std::cout << "Vertex validation Data cut summary:\n" << dataValidations->Validations().Cuts() << "\n";
+      }
 
-      for (auto &study : data_studies)
-        study->SaveOrDraw(*dataOutDir);
+      for (auto &selection : selections)
+      {
+        const int tgt = selection.targetCode;
+        auto &nukeVars = selection.vars;
+        auto &nukeVars2D = selection.vars2D;
 
-      // Playlist name - Used for flux calculations later on
-      playlistStr->Write();
-      // Protons On Target
-      auto dataPOT = new TParameter<double>("POTUsed", options.m_data_pot);
-      dataPOT->Write();
+        TNamed playlistStr("PlaylistUsed", options.m_plist_string);
 
-      dataOutDir->Close();
+        // In incremental mode, write next to the existing outputs and then add to them
+        auto writeName = [incremental](const std::string &outFileName) { return incremental ? outFileName + ".new" : outFileName; };
+        std::vector<std::string> outputFiles; // To store in the result cache
+        auto addToExisting = [incremental, &writeName](const std::string &outFileName)
+        {
+          if (!incremental) return true;
+          try
+          {
+            util::MergeInto(outFileName, writeName(outFileName));
+          }
+          catch (const std::runtime_error &e)
+          {
+            std::cerr << "Failed to add the new files' histograms to " << outFileName << ": " << e.what() << "\n";
+            return false;
+          }
+          std::remove(writeName(outFileName).c_str());
+          return true;
+        };
 
-      // Saving 2D migration matrices
-      // Putting this right at the end in case of a crash
-      std::string migrationOutDirName = MIGRATION_2D_OUT_FILE_NAME_BASE + std::to_string(tgt) + ".root";
-      if (nSubruns != 0 ) migrationOutDirName = MIGRATION_2D_OUT_FILE_NAME_BASE + std::to_string(tgt) + "_n"+nProcess+ ".root";
-      TFile *migrationOutDir = TFile::Open(migrationOutDirName.c_str(), "RECREATE");
-      if (!migrationOutDir)
-      {
-        std::cerr << "Failed to open a file named " << migrationOutDirName << " in the current directory for writing histograms.\n";
-        return badOutputFile;
+        if (doMC)
+        {
+          const std::string mcOutFileName = targetOutFileName(MC_OUT_FILE_NAME_BASE, tgt, bandShardSuffix);
+          // Write MC results
+          std::unique_ptr<TFile> mcOutDir(TFile::Open(writeName(mcOutFileName).c_str(), "RECREATE"));
+          if (!mcOutDir)
+          {
+            std::cerr << "Failed to open a file named " << mcOutFileName << " in the current directory for writing histograms.\n";
+            return badOutputFile;
+          }
+          std::cout << "Saving " << studies.size() << " studies\n";
+          for (auto &study : studies)
+            study->SaveOrDraw(*mcOutDir);
+          std::cout << "Saved studies\n";
+
+          for (auto &var : nukeVars)
+            var->WriteMC(*mcOutDir);
+          std::cout << "Saved 1D Variables\n";
+          for (auto &var : nukeVars2D)
+            var->WriteMC(*mcOutDir);
+          std::cout << "Saved 2D Variables\n";
+
+          // Playlist name - Used for flux calculations later on
+          playlistStr.Write();
+
+          // Protons On Target
+          TParameter<double> mcPOT("POTUsed", options.m_mc_pot);
+          mcPOT.Write();
+
+          PlotUtils::TargetUtils targetInfo;
+          assert(error_bands["cv"].size() == 1 && "List of error bands must contain a universe named \"cv\" for the flux integral.");
+
+          for (auto &var : nukeVars)
+          {
+            // Flux integral only if systematics are being done (temporary solution)
+            std::unique_ptr<PlotUtils::MnvH1D> fluxIntegral(util::GetFluxIntegral(*error_bands["cv"].front(), var->efficiencyNumerator->hist)); //Not in any TDirectory because of TH1::AddDirectory(false)
+            fluxIntegral->Write((var->GetName() + "_reweightedflux_integrated").c_str());
+            // Always use MC number of nucleons for cross section
+            // This may not even be necessary since we can always pull the same information in the extract cross section script as long ad we have the target information, which we do
+            std::unique_ptr<TParameter<double>> nNucleons;
+            if (tgt == 6000)
+              nNucleons.reset(new TParameter<double>((var->GetName() + "_fiducial_nucleons").c_str(), targetInfo.GetPassiveTargetNNucleons(6, 1, true)));
+            else if (tgt >= 7 && tgt <= 11)
+            {
+              nNucleons.reset(new TParameter<double>((var->GetName() + "_fiducial_nucleons").c_str(), targetInfo.GetTrackerNNucleons(6, true)));
+            }
+            else if (tgt == 12)
+              nNucleons.reset(new TParameter<double>((var->GetName() + "_fiducial_nucleons").c_str(), targetInfo.GetTrackerNNucleons(2, true)));
+            else if (tgt >12)
+              nNucleons.reset(new TParameter<double>((var->GetName() + "_fiducial_nucleons").c_str(), targetInfo.GetTrackerNNucleons(6, true)));
+            else
+            {
+              int tgtZ = tgt % 1000;
+              int tgtID = (tgt - tgtZ) / 1000;
+              nNucleons.reset(new TParameter<double>((var->GetName() + "_fiducial_nucleons").c_str(), targetInfo.GetPassiveTargetNNucleons(tgtID, tgtZ, true)));
+            }
+            nNucleons->Write();
+          }
+
+          util::writeInputFiles(*mcOutDir, mcInputFiles);
+          if (results) TNamed("ConfigHash", results->Hash(tgt).c_str()).Write();
+          mcOutDir->Close();
+          outputFiles.push_back(mcOutFileName);
+          if (!addToExisting(mcOutFileName)) return badOutputFile;
+        }
+
+        // Write data results
+        if (doData)
+        {
+          const std::string dataOutFileName = targetOutFileName(DATA_OUT_FILE_NAME_BASE, tgt, ""); // Data has no error bands to shard
+          std::unique_ptr<TFile> dataOutDir(TFile::Open(writeName(dataOutFileName).c_str(), "RECREATE"));
+          if (!dataOutDir)
+          {
+            std::cerr << "Failed to open a file named " << dataOutFileName << " in the current directory for writing histograms.\n";
+            return badOutputFile;
+          }
+
+          for (auto &var : nukeVars)
+            var->WriteData(*dataOutDir);
+          for (auto &var : nukeVars2D)
+            var->WriteData(*dataOutDir);
+
+          for (auto &study : data_studies)
+            study->SaveOrDraw(*dataOutDir);
+
+          // Playlist name - Used for flux calculations later on
+          playlistStr.Write();
+          // Protons On Target
+          TParameter<double> dataPOT("POTUsed", options.m_data_pot);
+          dataPOT.Write();
+
+          util::writeInputFiles(*dataOutDir, dataInputFiles);
+          if (results) TNamed("ConfigHash", results->Hash(tgt).c_str()).Write();
+          dataOutDir->Close();
+          outputFiles.push_back(dataOutFileName);
+          if (!addToExisting(dataOutFileName)) return badOutputFile;
+        }
+
+        // Saving 2D migration matrices
+        // Putting this right at the end in case of a crash
+        if (doMC)
+        {
+          const std::string migrationOutDirName = targetOutFileName(MIGRATION_2D_OUT_FILE_NAME_BASE, tgt, bandShardSuffix);
+          std::unique_ptr<TFile> migrationOutDir(TFile::Open(writeName(migrationOutDirName).c_str(), "RECREATE"));
+          if (!migrationOutDir)
+          {
+            std::cerr << "Failed to open a file named " << migrationOutDirName << " in the current directory for writing histograms.\n";
+            return badOutputFile;
+          }
+          for (auto &var : nukeVars2D)
+          {
+            var->WriteMigration(*migrationOutDir); // Save 2D migration to separate files, because it's huge
+          }
+          util::writeInputFiles(*migrationOutDir, mcInputFiles);
+          if (results) TNamed("ConfigHash", results->Hash(tgt).c_str()).Write();
+          migrationOutDir->Close();
+          outputFiles.push_back(migrationOutDirName);
+          if (!addToExisting(migrationOutDirName)) return badOutputFile;
+        }
+
+        // Both the MC and data scans go in 1 file with the POT to normalize them
+        if (selection.scan)
+        {
+          const std::string scanOutFileName = targetOutFileName(CUT_SCAN_OUT_FILE_NAME_BASE, tgt, bandShardSuffix);
+          std::unique_ptr<TFile> scanOutDir(TFile::Open(scanOutFileName.c_str(), "RECREATE"));
+          if (!scanOutDir)
+          {
+            std::cerr << "Failed to open a file named " << scanOutFileName << " in the current directory for writing histograms.\n";
+            return badOutputFile;
+          }
+          selection.scan->Write(*scanOutDir);
+          TParameter<double> mcPOT("MCPOT", options.m_mc_pot);
+          mcPOT.Write();
+          TParameter<double> dataPOT("DataPOT", options.m_data_pot);
+          dataPOT.Write();
+          scanOutDir->Close();
+        }
+
+        if (selection.reweightTrees)
+        {
+          selection.reweightTrees->Write(options.m_plist_string, options.m_mc_pot, truthSampleWeight);
+          selection.reweightTrees.reset();
+        }
+
+        // Every model's MC histograms side by side
+        if (selection.modelHists)
+        {
+          const std::string modelsOutFileName = targetOutFileName(MODELS_OUT_FILE_NAME_BASE, tgt, bandShardSuffix);
+          std::unique_ptr<TFile> modelsOutDir(TFile::Open(modelsOutFileName.c_str(), "RECREATE"));
+          if (!modelsOutDir)
+          {
+            std::cerr << "Failed to open a file named " << modelsOutFileName << " in the current directory for writing histograms.\n";
+            return badOutputFile;
+          }
+          selection.modelHists->Write(*modelsOutDir);
+          playlistStr.Write();
+          TParameter<double> mcPOT("POTUsed", options.m_mc_pot);
+          mcPOT.Write();
+          modelsOutDir->Close();
+          selection.modelHists.reset();
+        }
+
+        if (useCache)
+        {
+          try
+          {
+            results->Store(tgt, outputFiles);
+          }
+          catch (const std::runtime_error &e)
+          {
+            std::cerr << "Failed to store target " << tgt << " in the result cache: " << e.what() << "\n";
+          }
+        }
+
+        // All of this target's histograms are on disk now.  Free them before the next target allocates its own set.
+        for (auto &var : nukeVars2D)
+        {
+          var->ReleaseHists();
+          delete var;
+        }
+        for (auto &var : nukeVars)
+        {
+          var->ReleaseHists();
+          delete var;
+        }
+        util::printMemoryUsage(std::cout, "after target " + std::to_string(tgt));
+
+        std::cout << "Success" << std::endl;
       }
-      for (auto &var : nukeVars2D)
+
+      // Same files that runEventLoopTracker writes for each petal
+      if (tracker)
       {
-        var->WriteMigration(*migrationOutDir); // Save 2D migration to separate files, because it's huge
+        const int subrun = (nSubruns != 0) ? nProcess : -1;
+        for (auto &petal : tracker->petals)
+        {
+          auto &hists = *petal.second;
+          const std::string mcOutFileName = util::TrackerOutFileName(TRACKER_MC_OUT_FILE_NAME_BASE, petal.first, bandShardSuffix, subrun);
+          std::unique_ptr<TFile> mcOutDir(TFile::Open(mcOutFileName.c_str(), "RECREATE"));
+          if (!mcOutDir)
+          {
+            std::cerr << "Failed to open a file named " << mcOutFileName << " in the current directory for writing histograms.\n";
+            return badOutputFile;
+          }
+          hists.WriteMC(*mcOutDir, options.m_plist_string, options.m_mc_pot, *error_bands["cv"].front());
+          mcOutDir->Close();
+
+          if (doData)
+          {
+            const std::string dataOutFileName = util::TrackerOutFileName(TRACKER_DATA_OUT_FILE_NAME_BASE, petal.first, "", subrun);
+            std::unique_ptr<TFile> dataOutDir(TFile::Open(dataOutFileName.c_str(), "RECREATE"));
+            if (!dataOutDir)
+            {
+              std::cerr << "Failed to open a file named " << dataOutFileName << " in the current directory for writing histograms.\n";
+              return badOutputFile;
+            }
+            hists.WriteData(*dataOutDir, options.m_plist_string, options.m_data_pot);
+            dataOutDir->Close();
+          }
+
+          const std::string migrationOutDirName = util::TrackerOutFileName(TRACKER_MIGRATION_2D_OUT_FILE_NAME_BASE, petal.first, bandShardSuffix, subrun);
+          std::unique_ptr<TFile> migrationOutDir(TFile::Open(migrationOutDirName.c_str(), "RECREATE"));
+          if (!migrationOutDir)
+          {
+            std::cerr << "Failed to open a file named " << migrationOutDirName << " in the current directory for writing histograms.\n";
+            return badOutputFile;
+          }
+          hists.WriteMigration(*migrationOutDir);
+          migrationOutDir->Close();
+        }
+        tracker.reset();
+        util::printMemoryUsage(std::cout, "after the tracker petals");
       }
-      migrationOutDir->Close();
 
-      std::cout << "Success" << std::endl;
+      // Same file that runEventLoopValidations writes.  Each grid subrun already only read its share of the
+      // playlists, so unlike runEventLoopValidations, the POT isn't divided by the number of subruns.
+      if (mcValidations)
+      {
+        std::string validationsOutFileName = VALIDATIONS_OUT_FILE_NAME_BASE ".root";
+        if (nSubruns != 0) validationsOutFileName = VALIDATIONS_OUT_FILE_NAME_BASE "_n" + std::to_string(nProcess) + ".root";
+        std::unique_ptr<TFile> validationsOutDir(TFile::Open(validationsOutFileName.c_str(), "RECREATE"));
+        if (!validationsOutDir)
+        {
+          std::cerr << "Failed to open a file named " << validationsOutFileName << " in the current directory for writing histograms.\n";
+          return badOutputFile;
+        }
+        mcValidations->SaveOrDraw(*validationsOutDir);
+        TParameter<double> mcPOT("MCPOT", options.m_mc_pot);
+        mcPOT.Write();
+        TParameter<double> dataPOT("DataPOT", options.m_data_pot);
+        dataPOT.Write();
+        validationsOutDir->Close();
+
+        mcValidations.reset();
+        dataValidations.reset();
+        util::printMemoryUsage(std::cout, "after the vertex validations");
+      }
     /* }
     catch (const ROOT::exception &e)
     {
@@ -1220,5 +1921,6 @@ int main(const int argc, const char **argv)
       return badFileRead;
     } */
   }
+  util::printMemoryUsage(std::cout, "at the end of the job");
   return success;
 }
\ No newline at end of file
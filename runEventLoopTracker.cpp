@@ -56,8 +56,7 @@ enum ErrorCodes
 #include "event/MichelEvent.h"
 #include "systematics/Systematics.h"
 #include "cuts/MaxPzMu.h"
-#include "util/Variable.h"
-#include "util/Variable2D.h"
+#include "util/TrackerAnalysis.h"
 #include "util/GetFluxIntegral.h"
 #include "util/GetPlaylist.h"
 #include "cuts/SignalDefinition.h"
@@ -105,6 +104,7 @@ enum ErrorCodes
 #include <cstdlib> //getenv()
 #include <fstream>
 #include <sstream> //reading input files
+#include <memory> //std::unique_ptr
 
 
 //These 2 variables are used when doing broken down runs to speed up running on the grid
@@ -117,20 +117,16 @@ int nProcess = 0;
 void LoopAndFillEventSelection(
     PlotUtils::ChainWrapper* chain,
     std::map<std::string, std::vector<CVUniverse*> > error_bands,
-    std::vector<Variable*> vars,
-    std::vector<Variable2D*> vars2D,
+    util::TrackerHists& hists,
     std::vector<Study*> studies,
     PlotUtils::Cutter<CVUniverse, MichelEvent>& michelcuts,
-    PlotUtils::Model<CVUniverse, MichelEvent>& model, int inpetal)
+    PlotUtils::Model<CVUniverse, MichelEvent>& model)
 {
   assert(!error_bands["cv"].empty() && "\"cv\" error band is empty!  Can't set Model weight.");
   auto& cvUniv = error_bands["cv"].front();
 
   std::cout << "Starting MC reco loop...\n";
   const int nEntries = chain->GetEntries();
-  //const int nEntries = 10000;
-  //for (int i=19598; i<nEntries; ++i)
-  PlotUtils::TargetUtils util;
   for (int i = 0; i < nEntries; ++i)
   {
     if(i%1000==0) 
@@ -145,68 +141,24 @@ void LoopAndFillEventSelection(
     for (auto band : error_bands)
     {
       std::vector<CVUniverse*> error_band_universes = band.second;
-      int univCount = 0;
       for (auto universe : error_band_universes)
       {
-        univCount++; // Put the iterator right at the start so it's executed even in paths that lead to a continue, don't forget to subtract by 1 when we use it
         MichelEvent myevent; // make sure your event is inside the error band loop. 
     
         // Tell the Event which entry in the TChain it's looking at
         universe->SetEntry(i);
          
-        // This is where you would Access/create a Michel
-
         //weight is ignored in isMCSelected() for all but the CV Universe.
         if (!michelcuts.isMCSelected(*universe, myevent, cvWeight).all()) continue; //all is another function that will later help me with sidebands
         const double weight = model.GetWeight(*universe, myevent); //Only calculate the per-universe weight for events that will actually use it.
-        //Get daisy petal
-        int petal = util.GetDaisyPetal(universe->GetANNVertex().X(), universe->GetANNVertex().Y() ); // *10 to convert from cm to mm
-        if (petal!=inpetal/*  && inpetal!=-1 */) continue;
-        //if (petal>0) std::cout<<"Petal: " <<petal << std::endl;
-        for(auto& var: vars)
-        { 
-          var->selectedMCReco->FillUniverse(universe, var->GetRecoValue(*universe), weight); //"Fake data" for closure
-          (*var->m_intChannels)[universe->GetInteractionType()].FillUniverse(universe, var->GetRecoValue(*universe), weight);
-        }
-        for(auto& var: vars2D)
-        {
-          var->selectedMCReco->FillUniverse(universe, var->GetRecoValueX(*universe), var->GetRecoValueY(*universe), weight); //"Fake data" for closure
-          (*var->m_intChannels)[universe->GetInteractionType()].FillUniverse(universe, var->GetRecoValueX(*universe), var->GetRecoValueY(*universe), weight);
-          //(*var->m_interactionChannels)[universe->GetInteractionType()].FillUniverse(universe, var->GetRecoValueX(*universe), var->GetRecoValueY(*universe), weight);
-        }
+        if (util::GetRecoDaisyPetal(*universe) != hists.Petal()) continue;
+
         const bool isSignal = michelcuts.isSignal(*universe, weight);
         if(isSignal)
         {
           for(auto& study: studies) study->SelectedSignal(*universe, myevent, weight);
-
-          for(auto& var: vars)
-          {
-            //Cross section components
-            var->efficiencyNumerator->FillUniverse(universe, var->GetTrueValue(*universe), weight);
-            var->migration->FillUniverse(universe, var->GetRecoValue(*universe), var->GetTrueValue(*universe), weight);
-            var->selectedSignalReco->FillUniverse(universe, var->GetRecoValue(*universe), weight); //Efficiency numerator in reco variables.  Useful for warping studies.
-          }
-          for(auto& var: vars2D)
-          {
-            var->efficiencyNumerator->FillUniverse(universe, var->GetTrueValueX(*universe), var->GetTrueValueY(*universe), weight);
-            var->migration->Fill(var->GetRecoValueX(*universe), var->GetRecoValueY(*universe),var->GetTrueValueX(*universe), var->GetTrueValueY(*universe), weight);
-            var->selectedSignalReco->FillUniverse(universe, var->GetRecoValueX(*universe), var->GetRecoValueY(*universe), weight); //Efficiency numerator in reco variables.  Useful for warping studies.
-          }
-        }
-        else
-        {
-          int bkgd_ID = -1;
-          if (universe->GetCurrent() == 2) bkgd_ID = 0;
-          else if (universe->GetTruthNuPDG() == -14) bkgd_ID = 1;
-          for(auto& var: vars)
-          {
-            (*var->m_backgroundHists)[bkgd_ID].FillUniverse(universe, var->GetRecoValue(*universe), weight);
-          }
-          for(auto& var: vars2D)
-          {
-            (*var->m_backgroundHists)[bkgd_ID].FillUniverse(universe, var->GetRecoValueX(*universe), var->GetRecoValueY(*universe), weight);
-          } 
         }
+        hists.FillSelected(universe, isSignal, weight);
       } // End band's universe loop
     } // End Band loop
   } //End entries loop
@@ -215,16 +167,13 @@ void LoopAndFillEventSelection(
 
 void LoopAndFillData( PlotUtils::ChainWrapper* data,
 			        std::vector<CVUniverse*> data_band,
-				std::vector<Variable*> vars,
-                                std::vector<Variable2D*> vars2D,
+                                util::TrackerHists& hists,
                                 std::vector<Study*> studies,
-				PlotUtils::Cutter<CVUniverse, MichelEvent>& michelcuts, int inpetal)
+				PlotUtils::Cutter<CVUniverse, MichelEvent>& michelcuts)
 
 {
   std::cout << "Starting data loop...\n";
   const int nEntries = data->GetEntries();
-  PlotUtils::TargetUtils util;
-  //const int nEntries = 10000;
   for (int i = 0; i < nEntries; ++i)
   {
     for (auto universe : data_band) {
@@ -232,20 +181,9 @@ void LoopAndFillData( PlotUtils::ChainWrapper* data,
       if(i%1000==0) std::cout << i << " / " << nEntries << "\r" << std::flush;
       MichelEvent myevent; 
       if (!michelcuts.isDataSelected(*universe, myevent).all()) continue;
-      //Get daisy petal
-      int petal = util.GetDaisyPetal(universe->GetANNVertex().X(), universe->GetANNVertex().Y() );
-      if (petal!=inpetal/*  && inpetal!=-1 */) continue;
+      if (util::GetRecoDaisyPetal(*universe) != hists.Petal()) continue;
       for(auto& study: studies) study->Selected(*universe, myevent, 1); 
-      //std::cout<<"petal: " <<petal << "X: " << universe->GetANNVertex().X() << "\tY: "<<universe->GetANNVertex().Y()<<std::endl;
-      for(auto& var: vars)
-      {
-        var->dataHist->FillUniverse(universe, var->GetRecoValue(*universe, myevent.m_idx), 1);
-      }
-
-      for(auto& var: vars2D)
-      {
-        var->dataHist->FillUniverse(universe, var->GetRecoValueX(*universe), var->GetRecoValueY(*universe), 1);
-      }
+      hists.FillData(universe, myevent);
     }
   }
   std::cout << "Finished data loop.\n";
@@ -253,17 +191,14 @@ void LoopAndFillData( PlotUtils::ChainWrapper* data,
 
 void LoopAndFillEffDenom( PlotUtils::ChainWrapper* truth,
     				std::map<std::string, std::vector<CVUniverse*> > truth_bands,
-    				std::vector<Variable*> vars,
-                                std::vector<Variable2D*> vars2D,
+                                util::TrackerHists& hists,
     				PlotUtils::Cutter<CVUniverse, MichelEvent>& michelcuts,
-                                PlotUtils::Model<CVUniverse, MichelEvent>& model, int inpetal)
+                                PlotUtils::Model<CVUniverse, MichelEvent>& model)
 {
   assert(!truth_bands["cv"].empty() && "\"cv\" error band is empty!  Could not set Model entry.");
   auto& cvUniv = truth_bands["cv"].front();
-  PlotUtils::TargetUtils util;
   std::cout << "Starting efficiency denominator loop...\n";
   const int nEntries = truth->GetEntries();
-  //const int nEntries = 10000;
 
   for (int i = 0; i < nEntries; ++i)
   {
@@ -290,20 +225,9 @@ void LoopAndFillEffDenom( PlotUtils::ChainWrapper* truth,
         if (!michelcuts.isEfficiencyDenom(*universe, cvWeight)) continue; //Weight is ignored for isEfficiencyDenom() in all but the CV universe 
         const double weight = model.GetWeight(*universe, myevent); //Only calculate the weight for events that will use it
         
-        int petal = util.GetDaisyPetal(universe->GetTrueVertex().X(), universe->GetTrueVertex().Y() ); // *10 to convert from cm to mm
-        if (petal!=inpetal/*  && inpetal!=-1 */) continue;
+        if (util::GetTrueDaisyPetal(*universe) != hists.Petal()) continue;
         //Fill efficiency denominator now: 
-        for(auto var: vars)
-        {
-          var->efficiencyDenominator->FillUniverse(universe, var->GetTrueValue(*universe), weight);
-          (*var->m_intChannelsEffDenom)[universe->GetInteractionType()].FillUniverse(universe, var->GetTrueValue(*universe), weight);
-        }
-
-        for(auto var: vars2D)
-        {
-          var->efficiencyDenominator->FillUniverse(universe, var->GetTrueValueX(*universe), var->GetTrueValueY(*universe), weight);
-          (*var->m_intChannelsEffDenom)[universe->GetInteractionType()].FillUniverse(universe, var->GetTrueValueX(*universe), var->GetTrueValueY(*universe), weight);
-        }
+        hists.FillEffDenom(universe, weight);
       }
     }
   }
@@ -454,7 +378,7 @@ int main(const int argc, const char** argv)
     std::cerr << "Failed to find required trees in MC playlist " << mc_file_list << " and/or data playlist " << data_file_list << ".\n" << USAGE << "\n";
     return badInputFile;
   }
-  char* numSubruns = getenv("NumGridSubrums");
+  char* numSubruns = getenv("NumGridSubruns");
   char* numProcess = getenv("PROCESS");
 
   if (numSubruns != nullptr && numProcess != nullptr)
@@ -485,21 +409,7 @@ int main(const int argc, const char** argv)
   std::cout<<"Test2\n";
   //Now that we've defined what a cross section is, decide which sample and model
   //we're extracting a cross section for.
-  PlotUtils::Cutter<CVUniverse, MichelEvent>::reco_t sidebands, preCuts;
-  PlotUtils::Cutter<CVUniverse, MichelEvent>::truth_t signalDefinition, phaseSpace;
-
-  preCuts = util::GetAnalysisCuts(nupdg);
-  preCuts.emplace_back(new reco::ZRangeANN<CVUniverse, MichelEvent>("Z pos in active tracker", PlotUtils::TargetProp::Tracker::Face, PlotUtils::TargetProp::Tracker::Back));
-
-                                                                                                                                                   
-  if (nupdg>0) signalDefinition.emplace_back(new truth::IsNeutrino<CVUniverse>());
-  else if (nupdg<0) signalDefinition.emplace_back(new truth::IsAntiNeutrino<CVUniverse>());
-  signalDefinition.emplace_back(new truth::IsCC<CVUniverse>());
-                                                                                                                                                   
-  phaseSpace = util::GetPhaseSpace();
-  phaseSpace.emplace_back(new truth::ZRange<CVUniverse>("Z pos in active tracker", PlotUtils::TargetProp::Tracker::Face, PlotUtils::TargetProp::Tracker::Back));
-                                                                                                                                                   
-  PlotUtils::Cutter<CVUniverse, MichelEvent> mycuts(std::move(preCuts), std::move(sidebands) , std::move(signalDefinition),std::move(phaseSpace));
+  auto mycuts = util::GetTrackerCuts(nupdg);
 
   const bool NO_2P2H_WARP = (getenv("NO_2P2H_WARP") != nullptr);
   if(NO_2P2H_WARP){
@@ -667,38 +577,6 @@ int main(const int argc, const char** argv)
   if(doSystematics) truth_bands = GetStandardSystematics(options.m_truth);
   truth_bands["cv"] = {new CVUniverse(options.m_truth)};
 
-  std::vector<Variable*> vars;
-  std::vector<Variable2D*> vars2D;
-
-  std::vector<double> RecoilBins, segmentBins, angleBins;
-  //const double RecoilBinWidth = 50; //MeV
-  //for(int whichBin = 0; whichBin < 100 + 1; ++whichBin) RecoilBins.push_back(RecoilBinWidth * whichBin);
-
-  const double numsegments = 180;
-  for (double whichBin = 0; whichBin < numsegments; whichBin++)
-    segmentBins.push_back(whichBin - 0.5);
-
-  const double nAngleBins = 170;
-  for (double whichBin = 0; whichBin < nAngleBins+1; whichBin++)
-    angleBins.push_back(0.1*whichBin);
-
-  //std::function<double(const CVUniverse&)> ANNRecoilEGeV = [](const CVUniverse& univ) { return univ.GetANNRecoilE()/1000;};
-  std::function<double(const CVUniverse&)> q0TrueGeV = [](const CVUniverse& univ) { return univ.Getq0True()/1000;};
-  std::function<double(const CVUniverse &)> muonAngleDegrees = [](const CVUniverse &univ) { return (univ.GetThetamu() * 180 / M_PI); };
-  std::function<double(const CVUniverse &)> muonAngleDegreesTruth = [](const CVUniverse &univ) { return (univ.GetDouble("truth_muon_theta")* 180 / M_PI); };
-
-  vars.push_back(new Variable("pTmu", "p_{T, #mu} [GeV/c]", util::PTBins, &CVUniverse::GetANNMuonPTGeV, &CVUniverse::GetMuonPTTrue));
-  vars.push_back(new Variable("pZmu", "p_{||, #mu} [GeV/c]", util::PzBins, &CVUniverse::GetANNMuonPzGeV, &CVUniverse::GetMuonPzTrue));
-  vars.push_back(new Variable("Emu", "E_{#mu} [GeV]", util::EmuBins, &CVUniverse::GetANNEmuGeV, &CVUniverse::GetElepTrueGeV));
-  vars.push_back(new Variable("Erecoil", "E_{recoil} [GeV]", util::Erecoilbins, &CVUniverse::GetANNRecoilEGeV, q0TrueGeV)); // TODO: q0 is not the same as recoil energy without a spline correction
-  vars.push_back(new Variable("BjorkenX", "X", util::bjorkenXbins, &CVUniverse::GetBjorkenX, &CVUniverse::GetBjorkenXTrue));
-  vars.push_back(new Variable("BjorkenY", "Y", util::bjorkenYbins, &CVUniverse::GetBjorkenY, &CVUniverse::GetBjorkenYTrue));
-  vars.push_back(new Variable("segment", "segmentNum", segmentBins, &CVUniverse::GetANNSegment, &CVUniverse::GetTruthSegment)); // Just used for plotting events by detector position tbh - not for any actual physics
-  vars.push_back(new Variable("beamAngle", "Angle", angleBins, muonAngleDegrees, muonAngleDegreesTruth));              // Neutrino angle 
-  vars2D.push_back(new Variable2D("pTmu_pZmu", *vars[0], *vars[1]));
-  vars2D.push_back(new Variable2D("Emu_Erecoil", *vars[2], *vars[3]));
-  vars2D.push_back(new Variable2D("BjorkenX_BjorkenY", *vars[4], *vars[5])); 
-  //Probe some more variables?????
 
   std::vector<Study*> studies;
 
@@ -712,38 +590,30 @@ int main(const int argc, const char** argv)
 
   for (auto ptl : petals)
   {
-    for(auto& var: vars) var->InitializeMCHists(error_bands, truth_bands);
-    for(auto& var: vars) var->InitializeDATAHists(data_band);
-
-    for(auto& var: vars2D) var->InitializeMCHists(error_bands, truth_bands);
-    for(auto& var: vars2D) var->InitializeDATAHists(data_band);
+    util::TrackerHists hists(ptl);
+    hists.InitializeHists(error_bands, truth_bands, data_band);
 
     // Loop entries and fill
     try
     {
       CVUniverse::SetTruth(false);
       std::cout<<"Daisy reweight test0\n";
-      LoopAndFillEventSelection(options.m_mc, error_bands, vars, vars2D, studies, mycuts, model, ptl);
+      LoopAndFillEventSelection(options.m_mc, error_bands, hists, studies, *mycuts, model);
       CVUniverse::SetTruth(true);
       std::cout<<"Daisy reweight test1\n";
-      LoopAndFillEffDenom(options.m_truth, truth_bands, vars, vars2D, mycuts, model, ptl);
+      LoopAndFillEffDenom(options.m_truth, truth_bands, hists, *mycuts, model);
         std::cout<<"Daisy reweight test2\n";
       options.PrintMacroConfiguration(argv[0]);
-      std::cout << "MC cut summary:\n" << mycuts << "\n";
-      mycuts.resetStats();
+      std::cout << "MC cut summary:\n" << *mycuts << "\n";
+      mycuts->resetStats();
 
       CVUniverse::SetTruth(false);
-      LoopAndFillData(options.m_data, data_band, vars, vars2D, data_studies, mycuts, ptl);
-      std::cout << "Data cut summary:\n" << mycuts << "\n";
-
-      auto playlistStr = new TNamed("PlaylistUsed", options.m_plist_string);
+      LoopAndFillData(options.m_data, data_band, hists, data_studies, *mycuts);
+      std::cout << "Data cut summary:\n" << *mycuts << "\n";
 
-      std::string mcOutFileName = std::string(MC_OUT_FILE_NAME_BASE) +"_petal_"+ std::to_string(ptl)+".root";
-      if (nSubruns != 0 ) mcOutFileName = std::string(MC_OUT_FILE_NAME_BASE) +"_petal_"+ std::to_string(ptl) + "_n"+nProcess+ ".root";
-      //if (ptl==-1) mcOutFileName = std::string(MC_OUT_FILE_NAME_BASE) + ".root";
-      //else mcOutFileName = std::string(MC_OUT_FILE_NAME_BASE) +"_petal_"+ std::to_string(ptl)+".root";
+      std::string mcOutFileName = util::TrackerOutFileName(MC_OUT_FILE_NAME_BASE, ptl, "", nSubruns != 0 ? nProcess : -1);
       //Write MC results
-      TFile* mcOutDir = TFile::Open(mcOutFileName.c_str(), "RECREATE");
+      std::unique_ptr<TFile> mcOutDir(TFile::Open(mcOutFileName.c_str(), "RECREATE"));
       if(!mcOutDir)
       {
         std::cerr << "Failed to open a file named " << mcOutFileName << " in the current directory for writing histograms.\n";
@@ -751,80 +621,36 @@ int main(const int argc, const char** argv)
       }
 
       for(auto& study: studies) study->SaveOrDraw(*mcOutDir);
-      for(auto& var: vars) var->WriteMC(*mcOutDir);
-      for(auto& var: vars2D) var->WriteMC(*mcOutDir);
-
-      //Playlist name - Used for flux calculations later on
-      playlistStr->Write();
-      //Protons On Target
-      double mcpot = options.m_mc_pot;
-      if (numSubruns != nullptr) mcpot/=nSubruns;
-      auto mcPOT = new TParameter<double>("POTUsed", mcpot);
-      mcPOT->Write();
-
-      PlotUtils::TargetUtils targetInfo;
+      //Protons On Target.  A grid subrun's playlists were already broken up, so this is only its share of the POT.
+      const double mcpot = options.m_mc_pot;
       assert(error_bands["cv"].size() == 1 && "List of error bands must contain a universe named \"cv\" for the flux integral.");
-
-      for(const auto& var: vars)
-      {
-        //Flux integral only if systematics are being done (temporary solution)
-        util::GetFluxIntegral(*error_bands["cv"].front(), var->efficiencyNumerator->hist)->Write((var->GetName() + "_reweightedflux_integrated").c_str());
-        //Always use MC number of nucleons for cross section
-        auto nNucleons = new TParameter<double>((var->GetName() + "_fiducial_nucleons").c_str(), targetInfo.GetTrackerNNucleons(PlotUtils::TargetProp::Tracker::Face, PlotUtils::TargetProp::Tracker::Back, true, util::apothem));
-        nNucleons->Write();
-      }
-      for(const auto& var: vars2D)
-      {
-        //Flux integral only if systematics are being done (temporary solution)
-        util::GetFluxIntegral(*error_bands["cv"].front(), var->efficiencyNumerator->hist)->Write((var->GetName() + "_reweightedflux_integrated").c_str());
-        //Always use MC number of nucleons for cross section
-        auto nNucleons = new TParameter<double>((var->GetName() + "_fiducial_nucleons").c_str(), targetInfo.GetTrackerNNucleons(PlotUtils::TargetProp::Tracker::Face, PlotUtils::TargetProp::Tracker::Back, true, util::apothem));
-        nNucleons->Write();
-      }
+      hists.WriteMC(*mcOutDir, options.m_plist_string, mcpot, *error_bands["cv"].front());
       mcOutDir->Close();
 
-      playlistStr = new TNamed("PlaylistUsed", options.m_plist_string);
-
       //Write data results
-
-      std::string dataOutFileName = std::string(DATA_OUT_FILE_NAME_BASE) +"_petal_"+ std::to_string(ptl)+".root";
-      if (nSubruns != 0 ) dataOutFileName = std::string(DATA_OUT_FILE_NAME_BASE) +"_petal_"+ std::to_string(ptl) + "_n"+nProcess+ ".root";
-
-      //if (ptl==-1) dataOutFileName = std::string(DATA_OUT_FILE_NAME_BASE) + ".root";
-      //else dataOutFileName = std::string(DATA_OUT_FILE_NAME_BASE) +"_petal_"+ std::to_string(ptl)+".root";
-      TFile* dataOutDir = TFile::Open(dataOutFileName.c_str(), "RECREATE");
+      std::string dataOutFileName = util::TrackerOutFileName(DATA_OUT_FILE_NAME_BASE, ptl, "", nSubruns != 0 ? nProcess : -1);
+      std::unique_ptr<TFile> dataOutDir(TFile::Open(dataOutFileName.c_str(), "RECREATE"));
       if(!dataOutDir)
       {
         std::cerr << "Failed to open a file named " << dataOutFileName << " in the current directory for writing histograms.\n";
         return badOutputFile;
       }
 
-      for(auto& var: vars) var->WriteData(*dataOutDir);
-      for(auto& var: vars2D) var->WriteData(*dataOutDir);
-
-      playlistStr->Write();
-      //Protons On Target
-      double datapot = options.m_data_pot;
-      if (numSubruns != nullptr) datapot/=nSubruns;
-      auto dataPOT = new TParameter<double>("POTUsed", datapot);
-      dataPOT->Write();
-
+      //Protons On Target.  Also only this subrun's share.
+      const double datapot = options.m_data_pot;
+      hists.WriteData(*dataOutDir, options.m_plist_string, datapot);
       dataOutDir->Close();
 
       //Saving 2D migration matrices
       //Putting this right at the end in case of a crash
-      std::string migrationOutDirName = std::string(MIGRATION_2D_OUT_FILE_NAME_BASE) +"_petal_"+ std::to_string(ptl)+".root";
-      if (nSubruns != 0 ) migrationOutDirName = std::string(MIGRATION_2D_OUT_FILE_NAME_BASE) +"_petal_"+ std::to_string(ptl) + "_n"+nProcess+ ".root";
-
-      //if (ptl==-1) migrationOutDirName = std::string(MIGRATION_2D_OUT_FILE_NAME_BASE) + ".root";
-      //else migrationOutDirName = std::string(MIGRATION_2D_OUT_FILE_NAME_BASE) +"_petal_"+ std::to_string(ptl)+".root";
-      TFile* migrationOutDir = TFile::Open(migrationOutDirName.c_str(), "RECREATE");
+      std::string migrationOutDirName = util::TrackerOutFileName(MIGRATION_2D_OUT_FILE_NAME_BASE, ptl, "", nSubruns != 0 ? nProcess : -1);
+      std::unique_ptr<TFile> migrationOutDir(TFile::Open(migrationOutDirName.c_str(), "RECREATE"));
       if(!migrationOutDir)
       {
         std::cerr << "Failed to open a file named " << migrationOutDirName << " in the current directory for writing histograms.\n";
         return badOutputFile;
       }
-      for(auto& var: vars2D)var->WriteMigration(*migrationOutDir);
+      hists.WriteMigration(*migrationOutDir);
 
       migrationOutDir->Close();
 
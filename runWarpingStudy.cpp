@@ -0,0 +1,371 @@
+#define HELP \
+"\n*** Help: ***\n"\
+" File: runWarpingStudy.cpp\n"\
+" Brief: Warping study to choose the number of unfolding iterations.  Replaces running TransWarpExtraction once per\n"\
+"        warp from runTransWarp.sh.  The migration, reco and truth histograms are loaded once, the statistical universes\n"\
+"        of each warped pseudo-data sample are thrown once with a seeded RNG, and every (warp, number of iterations)\n"\
+"        combination is unfolded in parallel.  Results do not depend on the number of threads.\n"\
+"        Writes one Warping_<warped file name>.root per warped file.  Its Chi2_Iteration_Dists/ has the chi2 summaries\n"\
+"        that TransWarpExtraction uses to pick the number of iterations under the same names:\n"\
+"        h_chi2_modelData_trueData_iter_chi2, m_avg_chi2_modelData_trueData_iter_chi2 and\n"\
+"        h_median_chi2_modelData_trueData_iter_chi2.  It also has h_avg_bias_modelData_trueData_iter, the average\n"\
+"        fractional bias in each truth bin, and the nDOF and corrFactor used for the chi2.  Nothing else that\n"\
+"        TransWarpExtraction writes is saved, like the unfolded histogram of each universe and number of iterations.\n\n"\
+" Usage: runWarpingStudy <variable> <unfolding iterations> <universes> <threads> <migration file> <warped file> [more warped files...]\n"\
+"        e.g:   runWarpingStudy BjorkenX 1-30,40,50,60,70,80,90,100 100 8 runEventLoopTargetsMC2026.root warped_2p2h.root warped_lowQ2.root\n"\
+"        <threads> of 0 uses every core on the machine.  ROOT 5 builds always use 1 thread.\n\n"\
+"        Uses <variable>_migration, <variable>_selected_signal_reco and <variable>_efficiency_numerator from each file.\n"\
+"        The statistical covariance used for the chi2 is scaled by WARPING_CORR_FACTOR (default 2, like -C 2 in runTransWarp.sh).\n"\
+"        The statistical universes are thrown with WARPING_SEED (default 0).\n\n"
+
+// util includes
+#include "util/GetIngredient.h"
+#include "util/SparseMigration.h"
+#include "util/NukeUtils.h"
+
+// UnfoldUtils includes
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Woverloaded-virtual"
+#include "MinervaUnfold/MnvUnfold.h"
+
+// PlotUtils includes
+#include "PlotUtils/MnvH1D.h"
+#include "PlotUtils/MnvH2D.h"
+#pragma GCC diagnostic pop
+
+// ROOT includes
+#include "TH1D.h"
+#include "TH2D.h"
+#include "TFile.h"
+#include "TParameter.h"
+#include "TMatrixD.h"
+#include "TROOT.h"
+
+#ifndef NCINTEX
+#include "Cintex/Cintex.h"
+#endif
+
+// c++ includes
+#include <iostream>
+#include <iomanip>
+#include <exception>
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <cmath>
+#include <cstdlib>
+
+// Everything one warp needs.  Read-only once the worker threads start.
+struct Warp
+{
+  std::string name;
+  std::unique_ptr<TH1D> dataTruth;
+  std::vector<std::unique_ptr<TH1D>> universes; // Statistical universes of the warped reco distribution
+};
+
+// chi2 and bias of every statistical universe for one warp and one number of iterations
+struct Result
+{
+  std::vector<double> chi2;
+  std::vector<std::vector<double>> bias; // [universe][truth bin]
+};
+
+TH1D *GetCV(TFile &file, const std::string &name)
+{
+  auto hist = new TH1D(util::GetIngredient<PlotUtils::MnvH1D>(file, name)->GetCVHistoWithStatError());
+  hist->SetDirectory(nullptr);
+  return hist;
+}
+
+// Poisson fluctuations of the warped reco distribution.  Each universe gets its own seed so that a universe
+// does not depend on how many others were thrown.
+std::vector<std::unique_ptr<TH1D>> ThrowUniverses(const TH1D &reco, const int nUniverses, const unsigned long seed)
+{
+  std::vector<std::unique_ptr<TH1D>> universes;
+  for (int uni = 0; uni < nUniverses; ++uni)
+  {
+    std::mt19937_64 rng(seed * 1000003ul + uni);
+    std::unique_ptr<TH1D> fluctuated(static_cast<TH1D *>(reco.Clone((std::string(reco.GetName()) + "_stat_" + std::to_string(uni)).c_str())));
+    fluctuated->SetDirectory(nullptr);
+    for (int bin = 0; bin <= reco.GetNbinsX() + 1; ++bin)
+    {
+      const double mean = reco.GetBinContent(bin);
+      const double content = (mean > 0) ? std::poisson_distribution<long>(mean)(rng) : 0;
+      fluctuated->SetBinContent(bin, content);
+      fluctuated->SetBinError(bin, std::sqrt(content));
+    }
+    universes.push_back(std::move(fluctuated));
+  }
+  return universes;
+}
+
+// Same chi2 as TransWarpExtraction: compare the unfolded pseudo-data to its true distribution using the
+// statistical covariance from the unfolding.  Bins with no variance are left out.
+double Chi2(const TH1D &unfolded, const TH1D &truth, const TMatrixD &covariance, const double corrFactor)
+{
+  std::vector<int> bins;
+  for (int bin = 1; bin <= truth.GetNbinsX(); ++bin)
+  {
+    if (bin < covariance.GetNrows() && covariance(bin, bin) > 0)
+      bins.push_back(bin);
+  }
+
+  TMatrixD inverse(bins.size(), bins.size());
+  for (size_t i = 0; i < bins.size(); ++i)
+  {
+    for (size_t j = 0; j < bins.size(); ++j)
+      inverse(i, j) = covariance(bins[i], bins[j]) * corrFactor;
+  }
+  double det = 0;
+  inverse.Invert(&det);
+  if (det == 0)
+    throw std::runtime_error(std::string("Singular unfolding covariance for ") + unfolded.GetName());
+
+  double chi2 = 0;
+  for (size_t i = 0; i < bins.size(); ++i)
+  {
+    const double diffI = unfolded.GetBinContent(bins[i]) - truth.GetBinContent(bins[i]);
+    for (size_t j = 0; j < bins.size(); ++j)
+      chi2 += diffI * inverse(i, j) * (unfolded.GetBinContent(bins[j]) - truth.GetBinContent(bins[j]));
+  }
+  return chi2;
+}
+
+double Median(std::vector<double> values)
+{
+  if (values.empty()) return 0;
+  std::sort(values.begin(), values.end());
+  const size_t mid = values.size() / 2;
+  return (values.size() % 2) ? values[mid] : 0.5 * (values[mid - 1] + values[mid]);
+}
+
+// Only the summaries over statistical universes.  Saving every unfolded universe would take warps x iterations x
+// universes histograms.
+void WriteSummary(const Warp &warp, const std::vector<int> &iterations, const std::vector<Result> &results, const int nDOF, const double corrFactor)
+{
+  const std::string outFileName = "Warping_" + warp.name;
+  auto outFile = TFile::Open(outFileName.c_str(), "RECREATE");
+  if (!outFile)
+    throw std::runtime_error("Could not create a file called " + outFileName);
+
+  const int maxIter = *std::max_element(iterations.begin(), iterations.end());
+  const int nUniverses = warp.universes.size();
+  const int nTruthBins = warp.dataTruth->GetNbinsX();
+  double maxChi2 = 0;
+  for (const auto &result : results)
+    maxChi2 = std::max(maxChi2, *std::max_element(result.chi2.begin(), result.chi2.end()));
+
+  auto dir = outFile->mkdir("Chi2_Iteration_Dists");
+  dir->cd();
+  TH2D chi2Dist("h_chi2_modelData_trueData_iter_chi2", "chi2 of unfolded stat. universes;Iteration;chi2", maxIter, 0.5, maxIter + 0.5, 500, 0, std::max(5. * nDOF, 1.1 * maxChi2));
+  TH1D avgChi2("m_avg_chi2_modelData_trueData_iter_chi2", "Average chi2;Iteration;Average chi2", maxIter, 0.5, maxIter + 0.5);
+  TH1D medianChi2("h_median_chi2_modelData_trueData_iter_chi2", "Median chi2;Iteration;Median chi2", maxIter, 0.5, maxIter + 0.5);
+  TH2D avgBias("h_avg_bias_modelData_trueData_iter", "Average (unfolded - true) / true;Iteration;Truth bin", maxIter, 0.5, maxIter + 0.5, nTruthBins, 0.5, nTruthBins + 0.5);
+  chi2Dist.SetDirectory(nullptr);
+  avgChi2.SetDirectory(nullptr);
+  medianChi2.SetDirectory(nullptr);
+  avgBias.SetDirectory(nullptr);
+
+  std::cout << "\n" << warp.name << ": " << nUniverses << " statistical universes, " << nDOF << " degrees of freedom\n"
+            << std::setw(12) << "Iterations" << std::setw(16) << "Average chi2" << std::setw(16) << "Median chi2" << "\n";
+  for (size_t whichIter = 0; whichIter < iterations.size(); ++whichIter)
+  {
+    const int iter = iterations[whichIter];
+    const auto &result = results[whichIter];
+    for (const double chi2 : result.chi2)
+      chi2Dist.Fill(iter, chi2);
+
+    const double avg = std::accumulate(result.chi2.begin(), result.chi2.end(), 0.) / nUniverses;
+    const double median = Median(result.chi2);
+    avgChi2.SetBinContent(avgChi2.FindBin(iter), avg);
+    medianChi2.SetBinContent(medianChi2.FindBin(iter), median);
+
+    for (int bin = 1; bin <= nTruthBins; ++bin)
+    {
+      double sum = 0;
+      for (const auto &bias : result.bias)
+        sum += bias[bin];
+      avgBias.SetBinContent(avgBias.GetXaxis()->FindBin(iter), bin, sum / nUniverses);
+    }
+    std::cout << std::setw(12) << iter << std::setw(16) << avg << std::setw(16) << median << "\n";
+  }
+
+  chi2Dist.Write();
+  avgChi2.Write();
+  medianChi2.Write();
+  avgBias.Write();
+  TParameter<int>("nDOF", nDOF).Write();
+  TParameter<double>("corrFactor", corrFactor).Write();
+  outFile->Close();
+  delete outFile;
+}
+
+int main(const int argc, const char **argv)
+{
+#ifndef NCINTEX
+  ROOT::Cintex::Cintex::Enable(); // Needed to look up dictionaries for PlotUtils classes like MnvH1D
+#else
+  ROOT::EnableThreadSafety(); // The unfolding creates and deletes histograms from every thread
+#endif
+
+  TH1::AddDirectory(kFALSE);
+  if (argc < 7)
+  {
+    std::cerr << "Expected at least 6 arguments, but I got " << argc - 1 << ".\n" << HELP << std::endl;
+    return 1;
+  }
+
+  const std::string variable = argv[1];
+  std::vector<int> iterations;
+  try
+  {
+    iterations = util::parseIterationList(argv[2]);
+  }
+  catch (const std::invalid_argument &e)
+  {
+    std::cerr << e.what() << ".\n" << HELP << std::endl;
+    return 1;
+  }
+  const int nUniverses = std::stoi(argv[3]);
+  size_t nThreads = std::stoul(argv[4]);
+  if (nThreads == 0) nThreads = std::max(1u, std::thread::hardware_concurrency());
+#ifndef NCINTEX
+  nThreads = 1; // ROOT 5 can't create and delete histograms from more than one thread at a time
+#endif
+  const double corrFactor = std::getenv("WARPING_CORR_FACTOR") ? std::stod(std::getenv("WARPING_CORR_FACTOR")) : 2.;
+  const unsigned long seed = std::getenv("WARPING_SEED") ? std::stoul(std::getenv("WARPING_SEED")) : 0;
+  if (iterations.empty() || nUniverses < 1)
+  {
+    std::cerr << "Need at least 1 number of iterations and 1 universe.\n" << HELP << std::endl;
+    return 1;
+  }
+
+  std::unique_ptr<TH2D> migration;
+  std::unique_ptr<TH1D> mcReco, mcTruth;
+  std::vector<Warp> warps;
+  try
+  {
+    std::unique_ptr<TFile> migrationFile(TFile::Open(argv[5], "READ"));
+    if (!migrationFile)
+      throw std::runtime_error(std::string("Failed to open ") + argv[5]);
+    migration.reset(new TH2D(util::GetMigration(*migrationFile, variable + "_migration")->GetCVHistoWithStatError()));
+    migration->SetDirectory(nullptr);
+    mcReco.reset(GetCV(*migrationFile, variable + "_selected_signal_reco"));
+    mcTruth.reset(GetCV(*migrationFile, variable + "_efficiency_numerator"));
+
+    for (int whichFile = 6; whichFile < argc; ++whichFile)
+    {
+      std::unique_ptr<TFile> warpedFile(TFile::Open(argv[whichFile], "READ"));
+      if (!warpedFile)
+        throw std::runtime_error(std::string("Failed to open ") + argv[whichFile]);
+      Warp warp;
+      const std::string path = argv[whichFile];
+      warp.name = path.substr(path.find_last_of('/') + 1);
+      warp.dataTruth.reset(GetCV(*warpedFile, variable + "_efficiency_numerator"));
+      std::unique_ptr<TH1D> dataReco(GetCV(*warpedFile, variable + "_selected_signal_reco"));
+      warp.universes = ThrowUniverses(*dataReco, nUniverses, seed + whichFile - 6);
+      warps.push_back(std::move(warp));
+    }
+  }
+  catch (const std::runtime_error &e)
+  {
+    std::cerr << "Failed to load the warping study inputs: " << e.what() << "\n";
+    return 2;
+  }
+
+  // One job per warp and number of iterations.  Each job writes only to its own Result, so the output
+  // is the same no matter which thread ran it.
+  std::vector<std::vector<Result>> results(warps.size(), std::vector<Result>(iterations.size()));
+  const size_t nJobs = warps.size() * iterations.size();
+  std::atomic<size_t> nextJob(0);
+  std::mutex errorMutex, cloneMutex;
+  std::string firstError;
+
+  auto worker = [&]()
+  {
+    MinervaUnfold::MnvUnfold unfold;
+
+    // UnfoldHisto() takes its inputs as non-const pointers, so each thread unfolds with its own copies.  Cloning
+    // streams the original, so only one thread clones at a time.
+    std::unique_ptr<TH2D> myMigration;
+    std::unique_ptr<TH1D> myReco, myTruth;
+    {
+      std::lock_guard<std::mutex> lock(cloneMutex);
+      myMigration.reset(static_cast<TH2D *>(migration->Clone()));
+      myReco.reset(static_cast<TH1D *>(mcReco->Clone()));
+      myTruth.reset(static_cast<TH1D *>(mcTruth->Clone()));
+    }
+
+    for (size_t job = nextJob++; job < nJobs; job = nextJob++)
+    {
+      const auto &warp = warps[job / iterations.size()];
+      const int iter = iterations[job % iterations.size()];
+      auto &result = results[job / iterations.size()][job % iterations.size()];
+      try
+      {
+        for (const auto &universe : warp.universes)
+        {
+          std::unique_ptr<TH1D> data, unfolded;
+          {
+            std::lock_guard<std::mutex> lock(cloneMutex);
+            data.reset(static_cast<TH1D *>(universe->Clone()));
+            unfolded.reset(static_cast<TH1D *>(myTruth->Clone()));
+          }
+          TMatrixD covariance;
+          if (!unfold.UnfoldHisto(unfolded.get(), covariance, myMigration.get(), myReco.get(), myTruth.get(), data.get(), RooUnfold::kBayes, iter))
+            throw std::runtime_error(std::string("Failed to unfold ") + universe->GetName() + " with " + std::to_string(iter) + " iterations");
+
+          result.chi2.push_back(Chi2(*unfolded, *warp.dataTruth, covariance, corrFactor));
+          std::vector<double> bias(unfolded->GetNbinsX() + 2, 0);
+          for (int bin = 1; bin <= unfolded->GetNbinsX(); ++bin)
+          {
+            const double truth = warp.dataTruth->GetBinContent(bin);
+            if (truth > 0) bias[bin] = (unfolded->GetBinContent(bin) - truth) / truth;
+          }
+          result.bias.push_back(std::move(bias));
+        }
+      }
+      catch (const std::exception &e)
+      {
+        std::lock_guard<std::mutex> lock(errorMutex);
+        if (firstError.empty()) firstError = e.what();
+        return;
+      }
+    }
+  };
+
+  std::cout << "Unfolding " << warps.size() << " warps x " << iterations.size() << " numbers of iterations x " << nUniverses
+            << " universes on " << nThreads << " threads\n";
+  std::vector<std::thread> threads;
+  for (size_t whichThread = 0; whichThread < std::min(nThreads, nJobs); ++whichThread)
+    threads.emplace_back(worker);
+  for (auto &thread : threads)
+    thread.join();
+
+  if (!firstError.empty())
+  {
+    std::cerr << "Warping study failed: " << firstError << "\n";
+    return 3;
+  }
+
+  int nDOF = 0;
+  for (int bin = 1; bin <= mcTruth->GetNbinsX(); ++bin)
+    if (mcTruth->GetBinContent(bin) > 0) ++nDOF;
+
+  try
+  {
+    for (size_t whichWarp = 0; whichWarp < warps.size(); ++whichWarp)
+      WriteSummary(warps[whichWarp], iterations, results[whichWarp], nDOF, corrFactor);
+  }
+  catch (const std::runtime_error &e)
+  {
+    std::cerr << "Failed to write the warping study summaries: " << e.what() << "\n";
+    return 4;
+  }
+
+  return 0;
+}
@@ -10,17 +10,39 @@
 #include "util/NukeUtils.h"
 
 #include <cstdlib>
+#include <memory>
 typedef unsigned int uint;
 
+//Truth information shared by every CCInclTargets in one XSecLooper.  The looper asks every XSec whether each entry
+//passes its cuts, so the signal definition and true target code are only worked out the first time an entry is seen.
+struct TruthEntryCache
+{
+  const PlotUtils::ChainWrapper* chain = nullptr;
+  int entry = -1;
+  bool isSignal = false;
+  int tgtCode = -1;
+};
 
 class CCInclTargets : public XSec
 {
 public:
-  CCInclTargets(const char* name, std::string TargetCode) : 
+  CCInclTargets(const char* name, std::string TargetCode, std::shared_ptr<TruthEntryCache> cache = std::make_shared<TruthEntryCache>()) : 
   XSec(name), 
-  fTargetCode(TargetCode){};
+  fTargetCode(TargetCode),
+  fAcceptedCodes(acceptedCodes(TargetCode)),
+  fCache(cache){};
   
   std::string fTargetCode;
+  std::vector<int> fAcceptedCodes; //fTargetCode resolved to the target codes from getTargetCodeFromVtxInfo() it includes
+  std::shared_ptr<TruthEntryCache> fCache;
+
+  static std::vector<int> acceptedCodes(const std::string& targetCode)
+  {
+    if (targetCode=="Iron") return {2026, 3026, 5026};
+    if (targetCode=="Lead") return {2082, 3082, 4082, 5082};
+    if (targetCode=="Carbon") return {3006};
+    return {std::stoi(targetCode)};
+  }
 
   double getVariableValue(ChainWrapper& chw, int entry)
   {
@@ -39,27 +61,17 @@ public:
 
   bool isCCInclusiveSignal( PlotUtils::ChainWrapper& chw, int entry )
   {
-    double theta              = 0.;
-    double true_muon_px   = (double)chw.GetValue("mc_primFSLepton",entry,0)/1000;
-    double true_muon_py   = (double)chw.GetValue("mc_primFSLepton",entry,1)/1000;
-    double true_muon_pz   = (double)chw.GetValue("mc_primFSLepton",entry,2)/1000;
-    double true_muon_vtx_x   = (double)chw.GetValue("mc_vtx",entry,0);
-    double true_muon_vtx_y   = (double)chw.GetValue("mc_vtx",entry,1);
-    double true_muon_vtx_z   = (double)chw.GetValue("mc_vtx",entry,2);
     double numi_beam_angle_rad = -0.05887;
-    double muon_E     = (double)chw.GetValue("mc_primFSLepton",entry,3);
-    double pyprime = -1.0*sin(numi_beam_angle_rad)*true_muon_pz + cos(numi_beam_angle_rad)*true_muon_py;
-    double pzprime =  1.0*cos(numi_beam_angle_rad)*true_muon_pz + sin(numi_beam_angle_rad)*true_muon_py;
-    double pSquare = pow(true_muon_px,2) + pow(pyprime,2) + pow(pzprime,2);
-    theta = acos( pzprime / sqrt(pSquare) );
-    theta *= 180./3.14159265;
     double truth_muon_E = (double)chw.GetValue("truth_muon_E",entry);
+    //Check the energy first so that most events outside the signal don't need the muon momentum
+    bool inERange = (truth_muon_E>2000) && (truth_muon_E<50000);
+    if (!inERange) return false;
 
     TVector3 p3lep((double)chw.GetValue("mc_primFSLepton",entry,0),
                   (double)chw.GetValue("mc_primFSLepton",entry,1),
                   (double)chw.GetValue("mc_primFSLepton",entry,2));
     p3lep.RotateX(numi_beam_angle_rad);
-    theta = p3lep.Theta();
+    double theta = p3lep.Theta();
     //std::cout<<"entry: " << entry <<std::endl;
     //std::cout<<"theta: " << theta << std::endl;
     //theta = p3lep.Theta();
@@ -75,20 +87,26 @@ public:
     //bool inZRange = true_muon_vtx_z > PlotUtils::TargetProp::NukeRegion::Face && true_muon_vtx_z < PlotUtils::TargetProp::NukeRegion::Back;
     //std::cout<<"truth_muon_E: " << truth_muon_E << std::endl;
     //std::cout<<"theta: " << theta << std::endl;
-    bool inERange = (truth_muon_E>2000) && (truth_muon_E<50000);
-    if(inAngle  && inERange ) return true;
-    return false;
+    return inAngle;
 
   }
   // Override this method from the base class to decide what events to
   // include in this selection
   virtual bool passesCuts(PlotUtils::ChainWrapper& chw, int entry)
   {
+    if (fCache->chain != &chw || fCache->entry != entry)
+    {
+      fCache->chain = &chw;
+      fCache->entry = entry;
+      fCache->isSignal = passesSignalCuts(chw, entry);
+      fCache->tgtCode = fCache->isSignal ? trueTargetCode(chw, entry) : -1;
+    }
+    return fCache->isSignal && std::find(fAcceptedCodes.begin(), fAcceptedCodes.end(), fCache->tgtCode) != fAcceptedCodes.end();
+  }
 
-    double true_muon_vtx_x   = (double)chw.GetValue("mc_vtx",entry,0);
-    double true_muon_vtx_y   = (double)chw.GetValue("mc_vtx",entry,1);
-    double true_muon_vtx_z   = (double)chw.GetValue("mc_vtx",entry,2);
-
+  //Everything but the target requirement
+  bool passesSignalCuts(PlotUtils::ChainWrapper& chw, int entry)
+  {
     //std::cout<<"entry: "<<entry<<" truth_target_code: "<<(int)chw.GetValue("truth_target_code", entry)<<std::endl;
 
     if((int)chw.GetValue("mc_incoming", entry)!=14) return false;
@@ -98,11 +116,6 @@ public:
       //std::cout<<"Failed signal check\n";
       return false;
     }
-    if (!inTarget( chw, entry ))
-    {
-      //std::cout<<"Failed target check\n";
-      return false;
-    }
     
     //std::cout<<"entry: "<<entry<<" truth_target_code: "<<(int)chw.GetValue("truth_target_code", entry)<<std::endl;
     /* if ((int)chw.GetValue("truth_target_code", entry) != fTargetCode)
@@ -151,7 +164,7 @@ public:
         return true;
     }
 
-    bool inTarget(PlotUtils::ChainWrapper& chw, int entry)
+    int trueTargetCode(PlotUtils::ChainWrapper& chw, int entry)
     {
       double vtx_x   = (double)chw.GetValue("mc_vtx",entry,0);
       double vtx_y   = (double)chw.GetValue("mc_vtx",entry,1);
@@ -163,29 +176,13 @@ public:
       std::cout<<"vtx_z "<<vtx_z<<"\n";
       std::cout<<"mod "<<mod<<"\n";
       std::cout<<"plane "<<plane<<"\n"; */
-      int tgtCode = util::getTargetCodeFromVtxInfo(vtx_x, vtx_y, vtx_z, mod, plane);
-      bool inTgt = false;
-      if (fTargetCode=="Iron")
-      {
-        inTgt = (tgtCode == 2026) || (tgtCode == 3026) || (tgtCode == 5026);
-      }
-      else if (fTargetCode=="Lead")
-      {
-        inTgt = (tgtCode == 2082) || (tgtCode == 3082) || (tgtCode == 4082) || (tgtCode == 5082);
-      }
-      else if (fTargetCode=="Carbon")
-      {
-        inTgt = (tgtCode == 3006);
-      }
-      else
-      {
-        //std::cout<<"Here1\n";
-        //std::cout<<"fTargetCode "<<fTargetCode<<"\n";
-        inTgt = std::stoi(fTargetCode) == tgtCode;
-        //std::cout<<"tgtCode "<<tgtCode<<"\n";
-        //std::cout<<"inTgt "<<inTgt<<"\n";
-      }
-      return inTgt;
+      return util::getTargetCodeFromVtxInfo(vtx_x, vtx_y, vtx_z, mod, plane);
+    }
+
+    bool inTarget(PlotUtils::ChainWrapper& chw, int entry)
+    {
+      const int tgtCode = trueTargetCode(chw, entry);
+      return std::find(fAcceptedCodes.begin(), fAcceptedCodes.end(), tgtCode) != fAcceptedCodes.end();
     }
 };
 
@@ -259,12 +256,14 @@ double GetNormValue( std::string tgt)
 int main(const int argc, const char** argv)
 {
   //Read a playlist file from the command line
-  if(argc != 2)
+  if(argc < 2)
   {
-    std::cerr << "Expected exactly 1 command line argument, but got " << argc - 1 << ".\n\n"
-              << "USAGE: runXSecLooper <MCPlaylist.txt>\n\n"
+    std::cerr << "Expected at least 1 command line argument, but got " << argc - 1 << ".\n\n"
+              << "USAGE: runXSecLooperTargets_ByTarget <MCPlaylist.txt> [target codes...]\n\n"
               << "MCPlaylist.txt shall contain one .root file per line that has a Truth tree in it.\n"
-              << "This program returns 0 when it suceeds.  It produces a .root file with GENIEXSECEXTRACT in its name.\n";
+              << "Target codes are like 3006, 2026, 6000, 7 or Iron, Lead and Carbon.  Defaults to 3006.\n"
+              << "All targets are filled in a single pass over the Truth tree.\n"
+              << "This program returns 0 when it suceeds.  It produces a .root file with GENIEXSECEXTRACT_Tgt<target code> in its name for each target.\n";
     return 1;
   }
 
@@ -276,12 +275,31 @@ int main(const int argc, const char** argv)
   //std::vector<std::string> targetCodes = { "2026", "2082", "3006", "3026", "3082", "4082", "5026", "5082", "6000 ,7", "8", "9", "10", "11", "12","Iron", "Lead", "Carbon"};
   //std::vector<std::string> targetCodes = { "Iron", "Lead", "Carbon"};
   std::vector<std::string> targetCodes = { "3006"};
+  if (argc > 2) targetCodes.assign(argv + 2, argv + argc);
+
+  // Create the XSecLooper and tell it the input files
+  // Inputs should be the merged ntuples:
+  XSecLooperExt loop(playlistFile.c_str());
+
+  // Tell the XSecLooper which neutrino type we're considering (mandatory)
+  loop.setNuPDG(14);
+
+  // Setting the number of Universes in the GENIE error band (default 100, put 0 if you do not want to include the universes)
+  loop.setNumUniv(0); 
+
+  loop.setFiducial(5970, 8450);
+  //loop.setFiducial(PlotUtils::TargetProp::Tracker::Face, PlotUtils::TargetProp::Tracker::Back, 850.0);
+  //loop.setFiducial(PlotUtils::TargetProp::NukeRegion::Face, PlotUtils::TargetProp::NukeRegion::Back);
+  loop.setPlaylist(PlotUtils::FluxReweighter::minervame1A);
+
+  //Every target's XSecs share one TruthEntryCache so that each Truth entry's signal definition is only evaluated once.
+  //XSec names get a _Tgt<code> suffix to keep the histograms of different targets apart.  It's removed again when writing.
+  auto cache = std::make_shared<TruthEntryCache>();
+  std::map<std::string, std::vector<XSec*>> xsecsByTarget;
   for (auto const& tgtCode : targetCodes)
   {
     std::cout<< "Target: " << tgtCode << std::endl;
-    // Create the XSecLooper and tell it the input files
-    // Inputs should be the merged ntuples:
-    XSecLooperExt loop(playlistFile.c_str());
+    const std::string tag = "_Tgt" + tgtCode;
 
     double norm = GetNormValue( tgtCode);
   /* 
@@ -299,16 +317,6 @@ int main(const int argc, const char** argv)
     loop.setPlaylist(FluxReweighter::GetPlaylistEnum(playlistname));
     */
 
-    // Tell the XSecLooper which neutrino type we're considering (mandatory)
-    loop.setNuPDG(14);
-
-    // Setting the number of Universes in the GENIE error band (default 100, put 0 if you do not want to include the universes)
-    loop.setNumUniv(0); 
-
-    loop.setFiducial(5970, 8450);
-    //loop.setFiducial(PlotUtils::TargetProp::Tracker::Face, PlotUtils::TargetProp::Tracker::Back, 850.0);
-    //loop.setFiducial(PlotUtils::TargetProp::NukeRegion::Face, PlotUtils::TargetProp::NukeRegion::Back);
-    loop.setPlaylist(PlotUtils::FluxReweighter::minervame1A);
 
     // Add the differential cross section dsigma/ds_dpT
     double pt_edges[] = { 0.0, 0.075, 0.15, 0.25, 0.325, 0.4, 0.475, 0.55, 0.7, 0.85, 1.0, 1.25, 1.5, 2.5, 4.5 };
@@ -333,7 +341,7 @@ int main(const int argc, const char** argv)
     }
   
     // Flux-integrated over the range 0.0 to 100.0 GeV
-    CCInclTargets* ds_dpT = new CCInclTargets("pTmu", tgtCode);
+    CCInclTargets* ds_dpT = new CCInclTargets(("pTmu" + tag).c_str(), tgtCode, cache);
     ds_dpT->setBinEdges(pt_nbins, pt_edges);
     ds_dpT->setVariable(XSec::kPTLep);
     ds_dpT->setIsFluxIntegrated(true);
@@ -343,9 +351,10 @@ int main(const int argc, const char** argv)
     ds_dpT->setNormalizationType(XSec::kSelfNorm);
     ds_dpT->setUniverses(0); //default value, put 0 if you do not want universes to be included.
     loop.addXSec(ds_dpT);
+    xsecsByTarget[tgtCode].push_back(ds_dpT);
 
 
-    CCInclTargets* ds_dpZ = new CCInclTargets("pZmu", tgtCode);
+    CCInclTargets* ds_dpZ = new CCInclTargets(("pZmu" + tag).c_str(), tgtCode, cache);
     ds_dpZ->setBinEdges(pz_nbins, pz_edges);
     ds_dpZ->setVariable(XSec::kPZLep);
     ds_dpZ->setIsFluxIntegrated(true);
@@ -355,8 +364,9 @@ int main(const int argc, const char** argv)
     ds_dpZ->setNormalizationType(XSec::kSelfNorm);
     ds_dpZ->setUniverses(0); //default value, put 0 if you do not want universes to be included.
     loop.addXSec(ds_dpZ);
+    xsecsByTarget[tgtCode].push_back(ds_dpZ);
 
-    CCInclTargets* ds_dpEMu = new CCInclTargets("Emu", tgtCode);
+    CCInclTargets* ds_dpEMu = new CCInclTargets(("Emu" + tag).c_str(), tgtCode, cache);
     ds_dpEMu->setBinEdges(eMu_nbins, eMu_edges);
     ds_dpEMu->setVariable(XSec::kELep);
     ds_dpEMu->setIsFluxIntegrated(true);
@@ -366,8 +376,9 @@ int main(const int argc, const char** argv)
     ds_dpEMu->setNormalizationType(XSec::kSelfNorm);
     ds_dpEMu->setUniverses(0); //default value, put 0 if you do not want universes to be included.
     loop.addXSec(ds_dpEMu);
+    xsecsByTarget[tgtCode].push_back(ds_dpEMu);
 
-    CCInclTargets* ds_dpERecoil = new CCInclTargets("Erecoil", tgtCode);
+    CCInclTargets* ds_dpERecoil = new CCInclTargets(("Erecoil" + tag).c_str(), tgtCode, cache);
     ds_dpERecoil->setBinEdges(Erecoil_nbins, Erecoil_edges);
     ds_dpERecoil->setVariable(XSec::kEHad);
     ds_dpERecoil->setIsFluxIntegrated(true);
@@ -377,8 +388,9 @@ int main(const int argc, const char** argv)
     ds_dpERecoil->setNormalizationType(XSec::kSelfNorm);
     ds_dpERecoil->setUniverses(0); //default value, put 0 if you do not want universes to be included.
     loop.addXSec(ds_dpERecoil);
+    xsecsByTarget[tgtCode].push_back(ds_dpERecoil);
 
-    CCInclTargets* ds_dpMeasX = new CCInclTargets("measX", tgtCode);
+    CCInclTargets* ds_dpMeasX = new CCInclTargets(("measX" + tag).c_str(), tgtCode, cache);
     ds_dpMeasX->setBinEdges(bjorken_nbins, bjorken_edges);
     ds_dpMeasX->setVariable(XSec::kxExp);
     ds_dpMeasX->setIsFluxIntegrated(true);
@@ -388,8 +400,9 @@ int main(const int argc, const char** argv)
     ds_dpMeasX->setNormalizationType(XSec::kSelfNorm);
     ds_dpMeasX->setUniverses(0); //default value, put 0 if you do not want universes to be included.
     loop.addXSec(ds_dpMeasX);
+    xsecsByTarget[tgtCode].push_back(ds_dpMeasX);
 
-    CCInclTargets* ds_dpX = new CCInclTargets("BjorkenX", tgtCode);
+    CCInclTargets* ds_dpX = new CCInclTargets(("BjorkenX" + tag).c_str(), tgtCode, cache);
     ds_dpX->setBinEdges(bjorken_nbins, bjorken_edges);
     ds_dpX->setVariable(XSec::kx);
     ds_dpX->setIsFluxIntegrated(true);
@@ -399,8 +412,9 @@ int main(const int argc, const char** argv)
     ds_dpX->setNormalizationType(XSec::kSelfNorm);
     ds_dpX->setUniverses(0); //default value, put 0 if you do not want universes to be included.
     loop.addXSec(ds_dpX);
+    xsecsByTarget[tgtCode].push_back(ds_dpX);
 
-    CCInclTargets* ds_dpTdpZ = new CCInclTargets("pTpZ", tgtCode);
+    CCInclTargets* ds_dpTdpZ = new CCInclTargets(("pTpZ" + tag).c_str(), tgtCode, cache);
     ds_dpTdpZ->setBinEdges(pz_nbins, pz_edges, pt_nbins, pt_edges);
     ds_dpTdpZ->setVariable(XSec::kPZLep, XSec::kPTLep);
     ds_dpTdpZ->setIsFluxIntegrated(true);
@@ -410,25 +424,40 @@ int main(const int argc, const char** argv)
     ds_dpTdpZ->setNormalizationType(XSec::kSelfNorm);
     ds_dpTdpZ->setUniverses(0); //default value, put 0 if you do not want universes to be included.
     loop.addXSec(ds_dpTdpZ);
+    xsecsByTarget[tgtCode].push_back(ds_dpTdpZ);
+
+  }
+
+  loop.runLoop();
 
-    loop.runLoop();
+  // Get the output histograms and save them to file
+  for (auto const& tgtCode : targetCodes)
+  {
+    const std::string tag = "_Tgt" + tgtCode;
+    //Write an object under its name from before the target tag was added
+    auto writeUntagged = [&tag](TObject* obj)
+    {
+      std::string name = obj->GetName();
+      const size_t pos = name.find(tag);
+      if (pos != std::string::npos) name.erase(pos, tag.size());
+      obj->Write(name.c_str());
+    };
 
-    // Get the output histograms and save them to file
     std::string geniefilename =  "GENIEXSECEXTRACT_Tgt"+tgtCode+".root";
     TFile fout(geniefilename.c_str(), "RECREATE");
-    for(uint i=0; i<loop.getXSecs().size(); ++i)
+    for (auto xsec : xsecsByTarget[tgtCode])
     {
-      if (loop.getXSecs()[i]->getDimension()==1)
+      if (xsec->getDimension()==1)
       {
-        loop.getXSecs()[i]->getXSecHist()->Write();
-        loop.getXSecs()[i]->getEvRateHist()->Write();
-        loop.getXSecs()[i]->integratedFlux->Write();
-        loop.getXSecs()[i]->flux->Write();
+        writeUntagged(xsec->getXSecHist());
+        writeUntagged(xsec->getEvRateHist());
+        writeUntagged(xsec->integratedFlux);
+        writeUntagged(xsec->flux);
         loop.getFluxHist()->Write();
       }
-      else if (loop.getXSecs()[i]->getDimension()==2)
+      else if (xsec->getDimension()==2)
       {
-        loop.getXSecs()[i]->get2DXSecHist()->Write();
+        writeUntagged(xsec->get2DXSecHist());
       }
     }
   }
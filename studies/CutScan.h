@@ -0,0 +1,326 @@
+//File: CutScan.h
+//Brief: Scans the thresholds of the cuts with a continuous discriminant in one pass over the AnaTuples instead of one
+//       job per threshold.  The cuts that can be scanned are ANNConfidence, Apothem, CurveSignificance, and the ZMin
+//       and ZMax of the ANN vertex.  A CutScan takes the scanned cuts out of a target's cuts, so each event only goes
+//       through the rest of them once.  Then each scanned cut's discriminant is calculated once and compared to every
+//       one of its thresholds with the other scanned cuts at their nominal thresholds.  Each threshold gets a copy of
+//       the target's 1D Variables' selected, selected signal, and data histograms and a bin in cut flow histograms.
+//       Only the CV universe is filled.  The efficiency denominator doesn't depend on any of these cuts, so use the
+//       target's efficiency denominator for the efficiency at each threshold.
+
+#ifndef CUTSCAN_H
+#define CUTSCAN_H
+
+//studies includes
+#include "studies/Study.h"
+
+//Includes from this package
+#include "event/MichelEvent.h"
+#include "event/CVUniverse.h"
+#include "util/NukeUtils.h"
+#include "cuts/CCInclCuts.h"
+
+//PlotUtils includes
+#include "PlotUtils/Cutter.h"
+#include "PlotUtils/VariableBase.h"
+
+//ROOT includes
+#include "TH1D.h"
+#include "TParameter.h"
+#include "TDirectory.h"
+
+//c++ includes
+#include <vector>
+#include <string>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <limits>
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+
+class CutScan
+{
+  public:
+    //Thresholds to try for each cut, like {"ANNConfidence", {0.2, 0.3, 0.4}}
+    using Points = std::map<std::string, std::vector<double>>;
+    using Cuts = PlotUtils::Cutter<CVUniverse, MichelEvent>;
+    using Variable = PlotUtils::VariableBase<CVUniverse>;
+
+    //Adds <cut>=<threshold>,<threshold>,... from the command line to points
+    static void ParsePoints(const std::string& arg, Points& points)
+    {
+      const auto equals = arg.find('=');
+      const std::string cut = arg.substr(0, equals);
+      if(equals == std::string::npos || !Kinds().count(cut))
+      {
+        std::string known;
+        for(const auto& kind: Kinds()) known += " " + kind.first;
+        throw std::runtime_error("Can't scan \"" + arg + "\".  Expected <cut>=<threshold>,<threshold>,... with one of these cuts:" + known);
+      }
+
+      std::stringstream thresholds(arg.substr(equals + 1));
+      for(std::string threshold; std::getline(thresholds, threshold, ',');) points[cut].push_back(std::stod(threshold));
+      if(points[cut].empty()) throw std::runtime_error("No thresholds to scan for " + cut);
+    }
+
+    //The scan gets its own Cutter from cuts without the scanned cuts, signalDefinition, and phaseSpace.
+    //vars have to outlive the CutScan.
+    CutScan(const Points& points, Cuts::reco_t cuts, Cuts::truth_t signalDefinition, Cuts::truth_t phaseSpace,
+            const std::vector<const Variable*>& vars): fVars(vars)
+    {
+      for(auto cut = cuts.begin(); cut != cuts.end();)
+      {
+        if(TakeCut(points, **cut)) cut = cuts.erase(cut);
+        else ++cut;
+      }
+
+      for(const auto& point: points)
+      {
+        if(std::none_of(fScanned.begin(), fScanned.end(), [&point](const ScannedCut& cut) { return cut.name == point.first; }))
+          throw std::runtime_error("Can't scan " + point.first + " because these cuts don't have it");
+      }
+
+      fCuts.reset(new Cuts(std::move(cuts), Cuts::reco_t(), std::move(signalDefinition), std::move(phaseSpace)));
+      fValues.resize(fScanned.size());
+      fPassesNominal.resize(fScanned.size());
+      fVarValues.resize(fVars.size());
+    }
+
+    //The histograms point to fVars
+    CutScan(const CutScan&) = delete;
+    CutScan& operator=(const CutScan&) = delete;
+
+    //Every cut but the scanned cuts
+    Cuts& GetCuts() { return *fCuts; }
+
+    //Applies the cuts itself, so call this for every MC event
+    void FillMC(const CVUniverse& univ, const double weight)
+    {
+      MichelEvent evt;
+      //weight is ignored in isMCSelected() for all but the CV Universe.
+      if(!fCuts->isMCSelected(univ, evt, weight).all()) return;
+      Fill(univ, weight, false, fCuts->isSignal(univ, weight));
+    }
+
+    //Applies the cuts itself, so call this for every data event
+    void FillData(const CVUniverse& univ)
+    {
+      MichelEvent evt;
+      if(!fCuts->isDataSelected(univ, evt).all()) return;
+      Fill(univ, 1, true, false);
+    }
+
+    void Write(TDirectory& dir)
+    {
+      dir.cd();
+      for(auto& cut: fScanned)
+      {
+        if(cut.thresholds.empty()) continue;
+        TParameter<double>((cut.name + "_nominal").c_str(), cut.nominal).Write();
+        cut.nSelected->Write();
+        cut.nSelectedSignal->Write();
+        cut.nData->Write();
+        for(auto& threshold: cut.thresholds)
+        {
+          for(auto& hist: threshold.selected) hist->Write();
+          for(auto& hist: threshold.selectedSignal) hist->Write();
+          for(auto& hist: threshold.data) hist->Write();
+        }
+      }
+    }
+
+  private:
+    //How to calculate a cut's discriminant and compare it to a threshold just like the cut does
+    struct Kind
+    {
+      double (*discriminant)(const CVUniverse&);
+      bool (*passes)(const double value, const double threshold);
+    };
+
+    struct Threshold
+    {
+      double value;
+      std::vector<std::unique_ptr<TH1D>> selected, selectedSignal, data; //One for each Variable
+    };
+
+    struct ScannedCut
+    {
+      std::string name;
+      Kind kind;
+      double nominal;
+      std::vector<Threshold> thresholds; //Empty for a cut that's only applied at its nominal threshold
+      std::unique_ptr<TH1D> nSelected, nSelectedSignal, nData; //Cut flow with a bin for each threshold
+    };
+
+    static const std::map<std::string, Kind>& Kinds()
+    {
+      static const std::map<std::string, Kind> kinds = {
+        {"ANNConfidence", {[](const CVUniverse& univ) { return univ.GetANNProb(); },
+                           [](const double value, const double threshold) { return value > threshold; }}},
+        //Apothem of the smallest hexagon around the vertex.  Its flat sides are at x = +/- apothem like in IsInHexagon().
+        {"Apothem", {[](const CVUniverse& univ) { const auto vtx = univ.GetVertex();
+                                                  return std::max(std::fabs(vtx.X()), (std::fabs(vtx.X()) + std::sqrt(3.) * std::fabs(vtx.Y()))/2.); },
+                     [](const double value, const double threshold) { return value < threshold; }}},
+        //Flipped for neutrinos so that bigger is more significant.  Muons reconstructed by range always pass.
+        {"CurveSignificance", {[](const CVUniverse& univ) { if(univ.GetInt((univ.GetAnaToolName() + "_minos_used_curvature").c_str()) != 1) return std::numeric_limits<double>::infinity();
+                                                            const double relativeErr = 1/univ.GetMuonQPErr();
+                                                            return (univ.GetAnalysisNuPDG() > 0) ? -relativeErr : relativeErr; },
+                               [](const double value, const double threshold) { return value >= threshold; }}},
+        {"ZMin", {[](const CVUniverse& univ) { return univ.GetANNVertex().Z(); },
+                  [](const double value, const double threshold) { return value >= threshold; }}},
+        {"ZMax", {[](const CVUniverse& univ) { return univ.GetANNVertex().Z(); },
+                  [](const double value, const double threshold) { return value <= threshold; }}}
+      };
+      return kinds;
+    }
+
+    std::unique_ptr<Cuts> fCuts;
+    std::vector<ScannedCut> fScanned;
+    std::vector<const Variable*> fVars;
+
+    //Per-event scratch space so that Fill() doesn't allocate
+    std::vector<double> fValues;
+    std::vector<bool> fPassesNominal;
+    std::vector<double> fVarValues;
+
+    //True if cut is one of the scanned cuts and now belongs to fScanned
+    bool TakeCut(const Points& points, const PlotUtils::Cut<CVUniverse, MichelEvent>& cut)
+    {
+      if(auto ann = dynamic_cast<const reco::ANNConfidenceCut<CVUniverse, MichelEvent>*>(&cut))
+        return points.count("ANNConfidence") && AddScanned(points, "ANNConfidence", ann->GetThreshold());
+      if(dynamic_cast<const reco::Apothem<CVUniverse, MichelEvent>*>(&cut)) //Doesn't tell what its apothem is, but GetAnalysisCuts() uses util::apothem
+        return points.count("Apothem") && AddScanned(points, "Apothem", util::apothem);
+      if(auto curvature = dynamic_cast<const reco::MuonCurveSignificance<CVUniverse, MichelEvent>*>(&cut))
+        return points.count("CurveSignificance") && AddScanned(points, "CurveSignificance", curvature->GetMin());
+      if(auto z = dynamic_cast<const reco::ZRangeANN<CVUniverse, MichelEvent>*>(&cut))
+      {
+        //Scanning either end of the range takes both of them
+        if(!points.count("ZMin") && !points.count("ZMax")) return false;
+        AddScanned(points, "ZMin", z->GetMin());
+        return AddScanned(points, "ZMax", z->GetMax());
+      }
+      return false;
+    }
+
+    bool AddScanned(const Points& points, const std::string& name, const double nominal)
+    {
+      fScanned.push_back(ScannedCut{name, Kinds().at(name), nominal, {}, nullptr, nullptr, nullptr});
+      auto& cut = fScanned.back();
+      const auto found = points.find(name);
+      if(found == points.end()) return true;
+
+      const auto& values = found->second;
+      const int nThresholds = values.size();
+      auto makeCutFlow = [&](const std::string& suffix, const std::string& title)
+      {
+        std::unique_ptr<TH1D> hist(new TH1D((name + suffix).c_str(), (title + " by " + name + " threshold;" + name + ";Events").c_str(), nThresholds, 0, nThresholds));
+        hist->SetDirectory(nullptr);
+        for(int whichThreshold = 0; whichThreshold < nThresholds; ++whichThreshold) hist->GetXaxis()->SetBinLabel(whichThreshold + 1, std::to_string(values[whichThreshold]).c_str());
+        return hist;
+      };
+      cut.nSelected = makeCutFlow("_selected_MC", "Selected MC");
+      cut.nSelectedSignal = makeCutFlow("_selected_signal_MC", "Selected signal MC");
+      cut.nData = makeCutFlow("_data", "Selected data");
+
+      for(int whichThreshold = 0; whichThreshold < nThresholds; ++whichThreshold)
+      {
+        cut.thresholds.push_back(Threshold{values[whichThreshold], {}, {}, {}});
+        auto& threshold = cut.thresholds.back();
+        const std::string prefix = name + "_" + std::to_string(whichThreshold) + "_";
+        const std::string titleSuffix = " with " + name + " threshold " + std::to_string(values[whichThreshold]);
+        auto makeHist = [&](const Variable& var, const std::string& suffix)
+        {
+          const auto bins = var.GetBinVec();
+          std::unique_ptr<TH1D> hist(new TH1D((prefix + var.GetName() + suffix).c_str(), (var.GetName() + titleSuffix + ";" + var.GetAxisLabel()).c_str(), bins.size() - 1, bins.data()));
+          hist->SetDirectory(nullptr);
+          return hist;
+        };
+        for(auto var: fVars)
+        {
+          threshold.selected.push_back(makeHist(*var, "_selected_MC"));
+          threshold.selectedSignal.push_back(makeHist(*var, "_selected_signal_MC"));
+          threshold.data.push_back(makeHist(*var, "_data"));
+        }
+      }
+      return true;
+    }
+
+    //univ already passed every cut that isn't scanned
+    void Fill(const CVUniverse& univ, const double weight, const bool isData, const bool isSignal)
+    {
+      int nFailNominal = 0;
+      for(size_t whichCut = 0; whichCut < fScanned.size(); ++whichCut)
+      {
+        const auto& cut = fScanned[whichCut];
+        fValues[whichCut] = cut.kind.discriminant(univ);
+        fPassesNominal[whichCut] = cut.kind.passes(fValues[whichCut], cut.nominal);
+        if(!fPassesNominal[whichCut]) ++nFailNominal;
+      }
+      if(nFailNominal > 1) return; //Fails at least 1 cut at nominal no matter which cut is being scanned
+
+      for(size_t whichVar = 0; whichVar < fVars.size(); ++whichVar) fVarValues[whichVar] = fVars[whichVar]->GetRecoValue(univ);
+
+      for(size_t whichCut = 0; whichCut < fScanned.size(); ++whichCut)
+      {
+        //Every other scanned cut has to pass at nominal
+        if(nFailNominal > (fPassesNominal[whichCut] ? 0 : 1)) continue;
+
+        auto& cut = fScanned[whichCut];
+        for(size_t whichThreshold = 0; whichThreshold < cut.thresholds.size(); ++whichThreshold)
+        {
+          auto& threshold = cut.thresholds[whichThreshold];
+          if(!cut.kind.passes(fValues[whichCut], threshold.value)) continue;
+
+          if(isData)
+          {
+            cut.nData->Fill(whichThreshold);
+            for(size_t whichVar = 0; whichVar < fVars.size(); ++whichVar) threshold.data[whichVar]->Fill(fVarValues[whichVar]);
+            continue;
+          }
+
+          cut.nSelected->Fill(whichThreshold, weight);
+          for(size_t whichVar = 0; whichVar < fVars.size(); ++whichVar) threshold.selected[whichVar]->Fill(fVarValues[whichVar], weight);
+          if(isSignal)
+          {
+            cut.nSelectedSignal->Fill(whichThreshold, weight);
+            for(size_t whichVar = 0; whichVar < fVars.size(); ++whichVar) threshold.selectedSignal[whichVar]->Fill(fVarValues[whichVar], weight);
+          }
+        }
+      }
+    }
+};
+
+//Fills a CutScan from an event loop.  The MC and data CutScanStudies share a CutScan, and only the MC one writes it.
+class CutScanStudy: public Study
+{
+  public:
+    CutScanStudy(std::shared_ptr<CutScan> scan, const bool isData): Study(), fScan(scan), fIsData(isData)
+    {
+    }
+
+    void SaveOrDraw(TDirectory& outDir)
+    {
+      if(!fIsData) fScan->Write(outDir);
+    }
+
+    CutScan& Scan() { return *fScan; }
+
+  private:
+    std::shared_ptr<CutScan> fScan;
+    const bool fIsData;
+
+    void fillSelected(const CVUniverse& univ, const MichelEvent& /*evt*/, const double weight)
+    {
+      if(univ.ShortName() != "cv") return;
+      if(fIsData) fScan->FillData(univ);
+      else fScan->FillMC(univ, weight);
+    }
+
+    //FillMC() checks the signal definition itself
+    void fillSelectedSignal(const CVUniverse& /*univ*/, const MichelEvent& /*evt*/, const double /*weight*/) {}
+    void fillTruthSignal(const CVUniverse& /*univ*/, const MichelEvent& /*evt*/, const double /*weight*/) {}
+};
+
+#endif //CUTSCAN_H
@@ -0,0 +1,676 @@
+//File: VertexValidations.h
+//Brief: runEventLoopValidations' vertex validation histograms: ANN, track based, and true vertex z positions,
+//       segments, residuals, and scans over the cutoff of the weighted ANN z position in each target.  They have their
+//       own cuts, so VertexValidationStudy can fill them from any event loop over the same AnaTuples.  That's how
+//       runEventLoopTargets --validations fills them in the same reads as the cross section histograms.
+//       Only the CV universe is filled.
+
+#ifndef VERTEXVALIDATIONS_H
+#define VERTEXVALIDATIONS_H
+
+//studies includes
+#include "studies/Study.h"
+
+//Includes from this package
+#include "event/MichelEvent.h"
+#include "event/CVUniverse.h"
+#include "util/NukeUtils.h"
+#include "util/LazyHist.h"
+
+//PlotUtils includes
+#include "PlotUtils/Cutter.h"
+#include "PlotUtils/TargetUtils.h"
+
+//ROOT includes
+#include "TH1D.h"
+#include "TH2D.h"
+
+//c++ includes
+#include <vector>
+#include <string>
+#include <memory>
+#include <cmath>
+#include <iostream>
+
+class VertexValidations
+{
+  public:
+    VertexValidations(const int nupdg, const bool verbose = false): fCuts(GetCuts(nupdg)), fANNConfCut(0.20), fVerbose(verbose)
+    {
+    }
+
+    //The histograms point to vertexBins
+    VertexValidations(const VertexValidations&) = delete;
+    VertexValidations& operator=(const VertexValidations&) = delete;
+
+    //Every cut but the ANN confidence cut.  Some histograms are filled before the ANN confidence cut.
+    PlotUtils::Cutter<CVUniverse, MichelEvent>& Cuts() { return *fCuts; }
+
+    //Applies the cuts itself, so call this for every MC event
+    void FillMC(const CVUniverse& univ, const double weight)
+    {
+      MichelEvent myevent;
+      ROOT::Math::XYZVector ANNVtx = univ.GetANNVertex();
+      ROOT::Math::XYZTVector TrackBasedVtx = univ.GetVertex();
+      ROOT::Math::XYZTVector TrueVtx = univ.GetTrueVertex();
+
+      double ANNProb = univ.GetANNProb();
+      double erecoil = univ.GetRecoilE()/pow(10,3);
+      double curvsig = 1/univ.GetMuonQPErr();
+      double pmu = univ.GetPmu()/1000;
+
+      // This is where you would Access/create a Michel
+
+      //weight is ignored in isMCSelected() for all but the CV Universe.
+      if (!fCuts->isMCSelected(univ, myevent, weight).all()) return;   //All cuts except ANN confidence cut
+
+      if(ANNVtx.X()!=-1.0)
+      {
+        ANNPlaneProbabilityVsEhadMC->Fill(ANNProb, erecoil, weight);
+        if (fTargetUtils.InIron2VolMC(ANNVtx.X(), ANNVtx.Y(), ANNVtx.Z(), 850, true))  ANNPlaneProbabilityTgt2IronVsEhadMC->Fill(ANNProb, erecoil, weight);
+        if (fTargetUtils.InLead2VolMC(ANNVtx.X(), ANNVtx.Y(), ANNVtx.Z(), 850, true))  ANNPlaneProbabilityTgt2LeadVsEhadMC->Fill(ANNProb, erecoil, weight);
+        if (fTargetUtils.InIron3VolMC(ANNVtx.X(), ANNVtx.Y(), ANNVtx.Z(), 850, true))  ANNPlaneProbabilityTgt3IronVsEhadMC->Fill(ANNProb, erecoil, weight);
+        if (fTargetUtils.InLead3VolMC(ANNVtx.X(), ANNVtx.Y(), ANNVtx.Z(), 850, true))  ANNPlaneProbabilityTgt3LeadVsEhadMC->Fill(ANNProb, erecoil, weight);
+        if (fTargetUtils.InCarbon3VolMC(ANNVtx.X(), ANNVtx.Y(), ANNVtx.Z(), 850, true))  ANNPlaneProbabilityTgt3CarbonVsEhadMC->Fill(ANNProb, erecoil, weight);
+        if (fTargetUtils.InLead4VolMC(ANNVtx.X(), ANNVtx.Y(), ANNVtx.Z()))  ANNPlaneProbabilityTgt4LeadVsEhadMC->Fill(ANNProb, erecoil, weight);
+        if (fTargetUtils.InIron5VolMC(ANNVtx.X(), ANNVtx.Y(), ANNVtx.Z(), 850, true))  ANNPlaneProbabilityTgt5IronVsEhadMC->Fill(ANNProb, erecoil, weight);
+        if (fTargetUtils.InLead5VolMC(ANNVtx.X(), ANNVtx.Y(), ANNVtx.Z(), 850, true))  ANNPlaneProbabilityTgt5LeadVsEhadMC->Fill(ANNProb, erecoil, weight);
+        if (fTargetUtils.InWaterTargetVolMC(ANNVtx.X(), ANNVtx.Y(), ANNVtx.Z()))  ANNPlaneProbabilityWaterVsEhadMC->Fill(ANNProb, erecoil, weight);
+        if (fTargetUtils.InTracker(ANNVtx.X(), ANNVtx.Y(), ANNVtx.Z()))  ANNPlaneProbabilityTrackerVsEhadMC->Fill(ANNProb, erecoil, weight);
+        ANNPlaneProbabilityVsPmuMC->Fill(ANNProb, pmu, weight);
+        ANNPlaneProbabilityVsEhadMC->Fill(ANNProb, erecoil, weight);
+
+        ANNVerticesMC_ByZPosVsANNConf->Fill(ANNVtx.Z(), ANNProb, weight);
+        ANNVerticesMCANNConf_ByModule->Fill( ANNVtx.Z(), ANNProb, weight);
+
+        //For events misreconstructed in each target, what's the probability distribution
+        if (fTargetUtils.InIron2VolMC(ANNVtx.X(), ANNVtx.Y(), ANNVtx.Z(), 850, true) && !fTargetUtils.InIron2VolMC(TrueVtx.X(), TrueVtx.Y(), TrueVtx.Z(), 850, true)) ANNConfMisrecoInTgt2Iron->Fill(ANNProb);
+        if (fTargetUtils.InLead2VolMC(ANNVtx.X(), ANNVtx.Y(), ANNVtx.Z(), 850, true) && !fTargetUtils.InLead2VolMC(TrueVtx.X(), TrueVtx.Y(), TrueVtx.Z(), 850, true)) ANNConfMisrecoInTgt2Lead->Fill(ANNProb);
+        if (fTargetUtils.InIron3VolMC(ANNVtx.X(), ANNVtx.Y(), ANNVtx.Z(), 850, true) && !fTargetUtils.InIron3VolMC(TrueVtx.X(), TrueVtx.Y(), TrueVtx.Z(), 850, true)) ANNConfMisrecoInTgt3Iron->Fill(ANNProb);
+        if (fTargetUtils.InLead3VolMC(ANNVtx.X(), ANNVtx.Y(), ANNVtx.Z(), 850, true) && !fTargetUtils.InLead3VolMC(TrueVtx.X(), TrueVtx.Y(), TrueVtx.Z(), 850, true)) ANNConfMisrecoInTgt3Lead->Fill(ANNProb);
+        if (fTargetUtils.InCarbon3VolMC(ANNVtx.X(), ANNVtx.Y(), ANNVtx.Z(), 850, true) && !fTargetUtils.InCarbon3VolMC(TrueVtx.X(), TrueVtx.Y(), TrueVtx.Z(), 850, true)) ANNConfMisrecoInTgt3Carbon->Fill(ANNProb);
+        if (fTargetUtils.InLead4VolMC(ANNVtx.X(), ANNVtx.Y(), ANNVtx.Z()) && !fTargetUtils.InLead4VolMC(TrueVtx.X(), TrueVtx.Y(), TrueVtx.Z())) ANNConfMisrecoInTgt4Lead->Fill(ANNProb);
+        if (fTargetUtils.InIron5VolMC(ANNVtx.X(), ANNVtx.Y(), ANNVtx.Z(), 850, true) && !fTargetUtils.InIron5VolMC(TrueVtx.X(), TrueVtx.Y(), TrueVtx.Z(), 850, true)) ANNConfMisrecoInTgt5Iron->Fill(ANNProb);
+        if (fTargetUtils.InLead5VolMC(ANNVtx.X(), ANNVtx.Y(), ANNVtx.Z(), 850, true) && !fTargetUtils.InLead5VolMC(TrueVtx.X(), TrueVtx.Y(), TrueVtx.Z(), 850, true)) ANNConfMisrecoInTgt5Lead->Fill(ANNProb);
+        if (fTargetUtils.InWaterTargetVolMC(ANNVtx.X(), ANNVtx.Y(), ANNVtx.Z()) && !fTargetUtils.InWaterTargetVolMC(TrueVtx.X(), TrueVtx.Y(), TrueVtx.Z())) ANNConfMisrecoInWater->Fill(ANNProb);
+
+      }
+      TBVerticesMCCurvSig_ByModule->Fill( TrackBasedVtx.Z(), curvsig, weight);
+      TruthVerticesMCANNConf_ByModule->Fill( TrackBasedVtx.Z(), ANNProb, weight);
+      TruthVerticesMCCurvSig_ByModule->Fill( TrackBasedVtx.Z(), curvsig, weight);
+
+      if (!fANNConfCut.passesCut(univ, myevent, weight)) return;   //ANN confidence cut
+
+      //Performing vtx validation check Deborah suggested
+      double batchPOT = univ.GetBatchPOT();
+      double efficiency = 0.5563 - (0.01353*batchPOT); //Based on MINERvA-doc-21436
+      //weight/=efficiency; //Not doing efficiency correction right now
+
+      //Hadron Energy Spectrum plot
+      int multiplicity = univ.GetMultiplicity();
+      //-----------------------------------------------------------
+      // Making a note of events that may be interesting to view in Arachne
+      //-----------------------------------------------------------
+      //if (fTargetUtils.InWaterTargetVolMC(TrueVtx.X(), TrueVtx.Y(), TrueVtx.Z()) && (fTargetUtils.InWaterTargetVolMC(TrackBasedVtx.X(), TrackBasedVtx.Y(), TrackBasedVtx.Z())))  std::cout<<"Check in arachne: \n" << " ev_run: " << univ.GetInt("ev_run") << " ev_subrun: " << univ.GetInt("ev_subrun") << " ev_gate: " << univ.GetInt("ev_gate") << std::endl;
+      if ( std::abs(TrueVtx.Z() - ANNVtx.Z()) > 2000 && ANNProb>0.4 && fVerbose)
+      {
+        std::cout<<"Difference between true and ann reco z larger than 2000: \tANN Segment: " << univ.GetANNSegment() << "\tTrue Segment: " << univ.GetTruthSegment() << " mc_run: " << univ.GetInt("mc_run") << " mc_subrun: " << univ.GetInt("mc_subrun")  << " mc_nthEvtInSpill: " << univ.GetInt("mc_nthEvtInSpill") << " mc_nthEvtInFile: " << univ.GetInt("mc_nthEvtInFile") << " ev_global_gate: " << univ.GetInt("ev_global_gate")  << std::endl;
+        std::string ArachneLink = "https://mnvevdgpvm02.fnal.gov/Arachne/?det=SIM_minerva&recoVer=v22r1p1&run="+std::to_string(univ.GetInt("mc_run"))+"&subrun="+std::to_string(univ.GetInt("mc_subrun"))+"&gate="+std::to_string(univ.GetInt("mc_nthEvtInFile")+1)+"&slice=-1";
+        std::cout<<"Arachne Link: " << ArachneLink << std::endl;
+      }
+
+      if(ANNVtx.X()!=-1.0)
+      {
+        ANNVerticesMC_ByModule->Fill( ANNVtx.Z(), weight);
+        ANNVerticesMC_ByZPos->Fill( ANNVtx.Z(), weight);
+        ANNVerticesMC_ByZPosVsERecoil->Fill(ANNVtx.Z(), erecoil, weight);
+
+        ANNVerticesMCERecoil_ByModule->Fill( ANNVtx.Z(), erecoil, weight);
+        ANNVerticesMCMultiplicity_ByModule->Fill( ANNVtx.Z(), multiplicity, weight);
+        ANNVerticesMCCurvSig_ByModule->Fill( ANNVtx.Z(), curvsig, weight);
+
+        ANNVerticesConfusion_ByModule->Fill(ANNVtx.Z(), TrueVtx.Z(), weight);
+        ANNVerticesConfusion_ByZPos->Fill(ANNVtx.Z(), TrueVtx.Z(), weight);
+
+        ANNVerticesMC_BySegment->Fill(univ.GetANNSegment(), weight);
+        ANNVerticesMC_BySegmentVsERecoil->Fill(univ.GetANNSegment(), erecoil, weight);
+        //if (univ.GetANNSegment() == 45) std::cout<<"Found plane in ANN mod 45, truth seg: " << univ.GetTruthSegment() << " truth mod: " << univ.GetTruthVtxModule()<< " truth pla: " << univ.GetTruthVtxPlane()<< " truth tgtid: " << univ.GetTruthTargetID()<< " truth tgtz: " << univ.GetTruthTargetZ()<<  std::endl;
+
+        ANNZVertexResidual->Fill((ANNVtx.Z() - TrueVtx.Z()), weight);
+        if (fTargetUtils.InIron2VolMC(ANNVtx.X(), ANNVtx.Y(), ANNVtx.Z(), 850, true))  ANNZVertexResidualTgt2Iron->Fill((ANNVtx.Z() - TrueVtx.Z()), weight);
+        if (fTargetUtils.InLead2VolMC(ANNVtx.X(), ANNVtx.Y(), ANNVtx.Z(), 850, true))  ANNZVertexResidualTgt2Lead->Fill((ANNVtx.Z() - TrueVtx.Z()), weight);
+        if (fTargetUtils.InIron3VolMC(ANNVtx.X(), ANNVtx.Y(), ANNVtx.Z(), 850, true))  ANNZVertexResidualTgt3Iron->Fill((ANNVtx.Z() - TrueVtx.Z()), weight);
+        if (fTargetUtils.InLead3VolMC(ANNVtx.X(), ANNVtx.Y(), ANNVtx.Z(), 850, true))  ANNZVertexResidualTgt3Lead->Fill((ANNVtx.Z() - TrueVtx.Z()), weight);
+        if (fTargetUtils.InCarbon3VolMC(ANNVtx.X(), ANNVtx.Y(), ANNVtx.Z(), 850, true))  ANNZVertexResidualTgt3Carbon->Fill((ANNVtx.Z() - TrueVtx.Z()), weight);
+        if (fTargetUtils.InLead4VolMC(ANNVtx.X(), ANNVtx.Y(), ANNVtx.Z()))  ANNZVertexResidualTgt4Lead->Fill((ANNVtx.Z() - TrueVtx.Z()), weight);
+        if (fTargetUtils.InIron5VolMC(ANNVtx.X(), ANNVtx.Y(), ANNVtx.Z(), 850, true))  ANNZVertexResidualTgt5Iron->Fill((ANNVtx.Z() - TrueVtx.Z()), weight);
+        if (fTargetUtils.InLead5VolMC(ANNVtx.X(), ANNVtx.Y(), ANNVtx.Z(), 850, true))  ANNZVertexResidualTgt5Lead->Fill((ANNVtx.Z() - TrueVtx.Z()), weight);
+        if (fTargetUtils.InWaterTargetVolMC(ANNVtx.X(), ANNVtx.Y(), ANNVtx.Z()))  ANNZVertexResidualWater->Fill((ANNVtx.Z() - TrueVtx.Z()), weight);
+        if (fTargetUtils.InTracker(ANNVtx.X(), ANNVtx.Y(), ANNVtx.Z()))  ANNZVertexResidualTracker->Fill((ANNVtx.Z() - TrueVtx.Z()), weight);
+
+        ANNZVertexResidualVsConf->Fill((ANNVtx.Z() - TrueVtx.Z()), ANNProb, weight);
+        if (fTargetUtils.InIron2VolMC(ANNVtx.X(), ANNVtx.Y(), ANNVtx.Z(), 850, true))  ANNZVertexResidualVsConfTgt2Iron->Fill((ANNVtx.Z() - TrueVtx.Z()), ANNProb, weight);
+        if (fTargetUtils.InLead2VolMC(ANNVtx.X(), ANNVtx.Y(), ANNVtx.Z(), 850, true))  ANNZVertexResidualVsConfTgt2Lead->Fill((ANNVtx.Z() - TrueVtx.Z()), ANNProb, weight);
+        if (fTargetUtils.InIron3VolMC(ANNVtx.X(), ANNVtx.Y(), ANNVtx.Z(), 850, true))  ANNZVertexResidualVsConfTgt3Iron->Fill((ANNVtx.Z() - TrueVtx.Z()), ANNProb, weight);
+        if (fTargetUtils.InLead3VolMC(ANNVtx.X(), ANNVtx.Y(), ANNVtx.Z(), 850, true))  ANNZVertexResidualVsConfTgt3Lead->Fill((ANNVtx.Z() - TrueVtx.Z()), ANNProb, weight);
+        if (fTargetUtils.InCarbon3VolMC(ANNVtx.X(), ANNVtx.Y(), ANNVtx.Z(), 850, true))  ANNZVertexResidualVsConfTgt3Carbon->Fill((ANNVtx.Z() - TrueVtx.Z()), ANNProb, weight);
+        if (fTargetUtils.InLead4VolMC(ANNVtx.X(), ANNVtx.Y(), ANNVtx.Z()))  ANNZVertexResidualVsConfTgt4Lead->Fill((ANNVtx.Z() - TrueVtx.Z()), ANNProb, weight);
+        if (fTargetUtils.InIron5VolMC(ANNVtx.X(), ANNVtx.Y(), ANNVtx.Z(), 850, true))  ANNZVertexResidualVsConfTgt5Iron->Fill((ANNVtx.Z() - TrueVtx.Z()), ANNProb, weight);
+        if (fTargetUtils.InLead5VolMC(ANNVtx.X(), ANNVtx.Y(), ANNVtx.Z(), 850, true))  ANNZVertexResidualVsConfTgt5Lead->Fill((ANNVtx.Z() - TrueVtx.Z()), ANNProb, weight);
+        if (fTargetUtils.InWaterTargetVolMC(ANNVtx.X(), ANNVtx.Y(), ANNVtx.Z()))  ANNZVertexResidualVsConfWater->Fill((ANNVtx.Z() - TrueVtx.Z()), ANNProb, weight);
+        if (fTargetUtils.InTracker(ANNVtx.X(), ANNVtx.Y(), ANNVtx.Z()))  ANNZVertexResidualVsConfTracker->Fill((ANNVtx.Z() - TrueVtx.Z()), ANNProb, weight);
+
+        //GetANNSegmentsZPosWeighted2() only takes 2 values per event, so look up the target volumes for each of them once
+        //instead of for every cutoff in the scan below.
+        const auto zPosScan = univ.GetANNSegmentsZPosScan();
+        const util::ValidationVolumes segment0Vols = util::getValidationVolumes(fTargetUtils, ANNVtx.X(), ANNVtx.Y(), zPosScan.zPosSegment0);
+        const util::ValidationVolumes weightedVols = util::getValidationVolumes(fTargetUtils, ANNVtx.X(), ANNVtx.Y(), zPosScan.zPosWeighted);
+
+        double WeightedANNZ = zPosScan.at(1000000); //Just some large number
+        const util::ValidationVolumes& vols = (1000000 >= zPosScan.firstWeightedCutoff) ? weightedVols : segment0Vols;
+        ANNWeightedZVertexResidualVsConf->Fill((ANNVtx.Z() - TrueVtx.Z()), ANNProb, weight);
+        if (vols.iron2)  ANNWeightedZVertexResidualVsConfTgt2Iron->Fill((ANNVtx.Z() - TrueVtx.Z()), ANNProb, weight);
+        if (vols.lead2)  ANNWeightedZVertexResidualVsConfTgt2Lead->Fill((ANNVtx.Z() - TrueVtx.Z()), ANNProb, weight);
+        if (vols.iron3)  ANNWeightedZVertexResidualVsConfTgt3Iron->Fill((ANNVtx.Z() - TrueVtx.Z()), ANNProb, weight);
+        if (vols.lead3)  ANNWeightedZVertexResidualVsConfTgt3Lead->Fill((ANNVtx.Z() - TrueVtx.Z()), ANNProb, weight);
+        if (vols.carbon3)  ANNWeightedZVertexResidualVsConfTgt3Carbon->Fill((ANNVtx.Z() - TrueVtx.Z()), ANNProb, weight);
+        if (vols.lead4)  ANNWeightedZVertexResidualVsConfTgt4Lead->Fill((ANNVtx.Z() - TrueVtx.Z()), ANNProb, weight);
+        if (vols.iron5)  ANNWeightedZVertexResidualVsConfTgt5Iron->Fill((ANNVtx.Z() - TrueVtx.Z()), ANNProb, weight);
+        if (vols.lead5)  ANNWeightedZVertexResidualVsConfTgt5Lead->Fill((ANNVtx.Z() - TrueVtx.Z()), ANNProb, weight);
+        if (vols.water)  ANNWeightedZVertexResidualVsConfWater->Fill((ANNVtx.Z() - TrueVtx.Z()), ANNProb, weight);
+        if (vols.tracker)  ANNWeightedZVertexResidualVsConfTracker->Fill((ANNVtx.Z() - TrueVtx.Z()), ANNProb, weight);
+
+        ANNZWeightedVerticesMC_VsEhad->Fill(WeightedANNZ, erecoil, weight); //Some arbitrarily large cutoff
+        //for (double cutoff = 0; cutoff <=0.5; cutoff+=0.05)
+        for (int cutoff = 0; cutoff <100; cutoff++)
+        {
+          double WeightedANNZPos = zPosScan.at(cutoff);
+          const util::ValidationVolumes& cutoffVols = (cutoff >= zPosScan.firstWeightedCutoff) ? weightedVols : segment0Vols;
+          ANNZWeightedVerticesMC_VsCutoff->Fill(WeightedANNZPos, cutoff, weight);
+
+          ANNWeightedVsUnweightedZVertexDifferenceMC->Fill((WeightedANNZPos - ANNVtx.Z()), cutoff, weight);
+          if (cutoffVols.iron2)  ANNWeightedVsUnweightedZVertexDifferenceTgt2IronMC->Fill((WeightedANNZPos - ANNVtx.Z()), cutoff, weight);
+          if (cutoffVols.lead2)  ANNWeightedVsUnweightedZVertexDifferenceTgt2LeadMC->Fill((WeightedANNZPos - ANNVtx.Z()), cutoff, weight);
+          if (cutoffVols.iron3)  ANNWeightedVsUnweightedZVertexDifferenceTgt3IronMC->Fill((WeightedANNZPos - ANNVtx.Z()), cutoff, weight);
+          if (cutoffVols.lead3)  ANNWeightedVsUnweightedZVertexDifferenceTgt3LeadMC->Fill((WeightedANNZPos - ANNVtx.Z()), cutoff, weight);
+          if (cutoffVols.carbon3)  ANNWeightedVsUnweightedZVertexDifferenceTgt3CarbonMC->Fill((WeightedANNZPos - ANNVtx.Z()), cutoff, weight);
+          if (cutoffVols.lead4)  ANNWeightedVsUnweightedZVertexDifferenceTgt4LeadMC->Fill((WeightedANNZPos - ANNVtx.Z()), cutoff, weight);
+          if (cutoffVols.iron5)  ANNWeightedVsUnweightedZVertexDifferenceTgt5IronMC->Fill((WeightedANNZPos - ANNVtx.Z()), cutoff, weight);
+          if (cutoffVols.lead5)  ANNWeightedVsUnweightedZVertexDifferenceTgt5LeadMC->Fill((WeightedANNZPos - ANNVtx.Z()), cutoff, weight);
+          if (cutoffVols.water)  ANNWeightedVsUnweightedZVertexDifferenceWaterMC->Fill((WeightedANNZPos - ANNVtx.Z()), cutoff, weight);
+          if (cutoffVols.tracker)  ANNWeightedVsUnweightedZVertexDifferenceTrackerMC->Fill((WeightedANNZPos - ANNVtx.Z()), cutoff, weight);
+
+          ANNWeightedZVertexResidual->Fill((WeightedANNZPos - TrueVtx.Z()), cutoff, weight);
+          if (cutoffVols.iron2)  ANNWeightedZVertexResidualTgt2Iron->Fill((WeightedANNZPos - TrueVtx.Z()), cutoff, weight);
+          if (cutoffVols.lead2)  ANNWeightedZVertexResidualTgt2Lead->Fill((WeightedANNZPos - TrueVtx.Z()), cutoff, weight);
+          if (cutoffVols.iron3)  ANNWeightedZVertexResidualTgt3Iron->Fill((WeightedANNZPos - TrueVtx.Z()), cutoff, weight);
+          if (cutoffVols.lead3)  ANNWeightedZVertexResidualTgt3Lead->Fill((WeightedANNZPos - TrueVtx.Z()), cutoff, weight);
+          if (cutoffVols.carbon3)  ANNWeightedZVertexResidualTgt3Carbon->Fill((WeightedANNZPos - TrueVtx.Z()), cutoff, weight);
+          if (cutoffVols.lead4)  ANNWeightedZVertexResidualTgt4Lead->Fill((WeightedANNZPos - TrueVtx.Z()), cutoff, weight);
+          if (cutoffVols.iron5)  ANNWeightedZVertexResidualTgt5Iron->Fill((WeightedANNZPos - TrueVtx.Z()), cutoff, weight);
+          if (cutoffVols.lead5)  ANNWeightedZVertexResidualTgt5Lead->Fill((WeightedANNZPos - TrueVtx.Z()), cutoff, weight);
+          if (cutoffVols.water)  ANNWeightedZVertexResidualWater->Fill((WeightedANNZPos - TrueVtx.Z()), cutoff, weight);
+          if (cutoffVols.tracker)  ANNWeightedZVertexResidualTracker->Fill((WeightedANNZPos - TrueVtx.Z()), cutoff, weight);
+        }
+
+        ANNZResidualVsConfDifference->Fill((ANNVtx.Z() - TrueVtx.Z()), (univ.GetVecElem("ANN_plane_probs", 0) - univ.GetVecElem("ANN_plane_probs", 1)), weight);
+        if (fTargetUtils.InIron2VolMC(ANNVtx.X(), ANNVtx.Y(), ANNVtx.Z(), 850, true))  ANNZResidualVsConfDifferenceTgt2Iron->Fill((ANNVtx.Z() - TrueVtx.Z()), (univ.GetVecElem("ANN_plane_probs", 0) - univ.GetVecElem("ANN_plane_probs", 1)), weight);
+        if (fTargetUtils.InLead2VolMC(ANNVtx.X(), ANNVtx.Y(), ANNVtx.Z(), 850, true))  ANNZResidualVsConfDifferenceTgt2Lead->Fill((ANNVtx.Z() - TrueVtx.Z()), (univ.GetVecElem("ANN_plane_probs", 0) - univ.GetVecElem("ANN_plane_probs", 1)), weight);
+        if (fTargetUtils.InIron3VolMC(ANNVtx.X(), ANNVtx.Y(), ANNVtx.Z(), 850, true))  ANNZResidualVsConfDifferenceTgt3Iron->Fill((ANNVtx.Z() - TrueVtx.Z()), (univ.GetVecElem("ANN_plane_probs", 0) - univ.GetVecElem("ANN_plane_probs", 1)), weight);
+        if (fTargetUtils.InLead3VolMC(ANNVtx.X(), ANNVtx.Y(), ANNVtx.Z(), 850, true))  ANNZResidualVsConfDifferenceTgt3Lead->Fill((ANNVtx.Z() - TrueVtx.Z()), (univ.GetVecElem("ANN_plane_probs", 0) - univ.GetVecElem("ANN_plane_probs", 1)), weight);
+        if (fTargetUtils.InCarbon3VolMC(ANNVtx.X(), ANNVtx.Y(), ANNVtx.Z(), 850, true))  ANNZResidualVsConfDifferenceTgt3Carbon->Fill((ANNVtx.Z() - TrueVtx.Z()), (univ.GetVecElem("ANN_plane_probs", 0) - univ.GetVecElem("ANN_plane_probs", 1)), weight);
+        if (fTargetUtils.InLead4VolMC(ANNVtx.X(), ANNVtx.Y(), ANNVtx.Z()))  ANNZResidualVsConfDifferenceTgt4Lead->Fill((ANNVtx.Z() - TrueVtx.Z()), (univ.GetVecElem("ANN_plane_probs", 0) - univ.GetVecElem("ANN_plane_probs", 1)), weight);
+        if (fTargetUtils.InIron5VolMC(ANNVtx.X(), ANNVtx.Y(), ANNVtx.Z(), 850, true))  ANNZResidualVsConfDifferenceTgt5Iron->Fill((ANNVtx.Z() - TrueVtx.Z()), (univ.GetVecElem("ANN_plane_probs", 0) - univ.GetVecElem("ANN_plane_probs", 1)), weight);
+        if (fTargetUtils.InLead5VolMC(ANNVtx.X(), ANNVtx.Y(), ANNVtx.Z(), 850, true))  ANNZResidualVsConfDifferenceTgt5Lead->Fill((ANNVtx.Z() - TrueVtx.Z()), (univ.GetVecElem("ANN_plane_probs", 0) - univ.GetVecElem("ANN_plane_probs", 1)), weight);
+        if (fTargetUtils.InWaterTargetVolMC(ANNVtx.X(), ANNVtx.Y(), ANNVtx.Z()))  ANNZResidualVsConfDifferenceWater->Fill((ANNVtx.Z() - TrueVtx.Z()), (univ.GetVecElem("ANN_plane_probs", 0) - univ.GetVecElem("ANN_plane_probs", 1)), weight);
+        if (fTargetUtils.InTracker(ANNVtx.X(), ANNVtx.Y(), ANNVtx.Z()))  ANNZResidualVsConfDifferenceTracker->Fill((ANNVtx.Z() - TrueVtx.Z()), (univ.GetVecElem("ANN_plane_probs", 0) - univ.GetVecElem("ANN_plane_probs", 1)), weight);
+
+      }
+      TBVerticesMC_ByModule->Fill(TrackBasedVtx.Z(), weight);
+      TBVerticesMC_ByZPos->Fill( TrackBasedVtx.Z(), weight);
+      TruthVerticesMC_ByModule->Fill( TrueVtx.Z(), weight);
+      TruthVerticesMC_ByZPos->Fill( TrueVtx.Z(), weight);
+
+      TruthVerticesMC_ByMod->Fill(univ.GetTruthVtxModule(), weight);
+
+      TBVerticesMCERecoil_ByModule->Fill( TrackBasedVtx.Z(), erecoil, weight);
+      TBVerticesMCMultiplicity_ByModule->Fill( TrackBasedVtx.Z(), multiplicity, weight);
+      TruthVerticesMCERecoil_ByModule->Fill( TrueVtx.Z(), erecoil, weight);
+      TruthVerticesMCMultiplicity_ByModule->Fill( TrueVtx.Z(), multiplicity, weight);
+
+      ErecoilMC->Fill( erecoil, weight);
+
+      TruthVerticesMC_BySegment->Fill(univ.GetTruthSegment(), weight);
+      TruthVerticesMC_BySegmentVsERecoil->Fill(univ.GetTruthSegment(), erecoil, weight);
+
+      const bool isSignal = fCuts->isSignal(univ, weight);
+      if (isSignal) // If it is signal
+      {
+        if(ANNVtx.X()!=-1.0)
+        {
+          ANNPlaneProbabilityVsEhadNumerator->Fill(ANNProb, erecoil, weight);
+          if (fTargetUtils.InTracker(TrueVtx.X(), TrueVtx.Y(), TrueVtx.Z()) && fTargetUtils.InTracker(ANNVtx.X(), ANNVtx.Y(), ANNVtx.Z())) ANNPlaneProbabilityTrackerVsEhadNumerator->Fill(ANNProb, erecoil, weight);
+          if (fTargetUtils.InIron2VolMC(TrueVtx.X(), TrueVtx.Y(), TrueVtx.Z(), 850, true) && fTargetUtils.InIron2VolMC(ANNVtx.X(), ANNVtx.Y(), ANNVtx.Z(), 850, true)) ANNPlaneProbabilityTgt2IronVsEhadNumerator->Fill(ANNProb, erecoil, weight);
+          if (fTargetUtils.InLead2VolMC(TrueVtx.X(), TrueVtx.Y(), TrueVtx.Z(), 850, true) && fTargetUtils.InLead2VolMC(ANNVtx.X(), ANNVtx.Y(), ANNVtx.Z(), 850, true)) ANNPlaneProbabilityTgt2LeadVsEhadNumerator->Fill(ANNProb, erecoil, weight);
+          if (fTargetUtils.InIron3VolMC(TrueVtx.X(), TrueVtx.Y(), TrueVtx.Z(), 850, true) && fTargetUtils.InIron3VolMC(ANNVtx.X(), ANNVtx.Y(), ANNVtx.Z(), 850, true)) ANNPlaneProbabilityTgt3IronVsEhadNumerator->Fill(ANNProb, erecoil, weight);
+          if (fTargetUtils.InLead3VolMC(TrueVtx.X(), TrueVtx.Y(), TrueVtx.Z(), 850, true) && fTargetUtils.InLead3VolMC(TrueVtx.X(), TrueVtx.Y(), TrueVtx.Z(), 850, true)) ANNPlaneProbabilityTgt3LeadVsEhadNumerator->Fill(ANNProb, erecoil, weight);
+          if (fTargetUtils.InCarbon3VolMC(TrueVtx.X(), TrueVtx.Y(), TrueVtx.Z(), 850, true) && fTargetUtils.InCarbon3VolMC(ANNVtx.X(), ANNVtx.Y(), ANNVtx.Z(), 850, true)) ANNPlaneProbabilityTgt3CarbonVsEhadNumerator->Fill(ANNProb, erecoil, weight);
+          if (fTargetUtils.InLead4VolMC(TrueVtx.X(), TrueVtx.Y(), TrueVtx.Z()) && fTargetUtils.InLead4VolMC(ANNVtx.X(), ANNVtx.Y(), ANNVtx.Z())) ANNPlaneProbabilityTgt4LeadVsEhadNumerator->Fill(ANNProb, erecoil, weight);
+          if (fTargetUtils.InIron5VolMC(TrueVtx.X(), TrueVtx.Y(), TrueVtx.Z(), 850, true) && fTargetUtils.InIron5VolMC(ANNVtx.X(), ANNVtx.Y(), ANNVtx.Z(), 850, true)) ANNPlaneProbabilityTgt5IronVsEhadNumerator->Fill(ANNProb, erecoil, weight);
+          if (fTargetUtils.InLead5VolMC(TrueVtx.X(), TrueVtx.Y(), TrueVtx.Z(), 850, true) && fTargetUtils.InLead5VolMC(ANNVtx.X(), ANNVtx.Y(), ANNVtx.Z(), 850, true)) ANNPlaneProbabilityTgt5LeadVsEhadNumerator->Fill(ANNProb, erecoil, weight);
+          if (fTargetUtils.InWaterTargetVolMC(TrueVtx.X(), TrueVtx.Y(), TrueVtx.Z()) && fTargetUtils.InWaterTargetVolMC(ANNVtx.X(), ANNVtx.Y(), ANNVtx.Z())) ANNPlaneProbabilityWaterVsEhadNumerator->Fill(ANNProb, erecoil, weight);
+        }
+      }
+    }
+
+    //Applies the cuts itself, so call this for every data event
+    void FillData(const CVUniverse& univ)
+    {
+      MichelEvent myevent;
+      ROOT::Math::XYZVector ANNVtx = univ.GetANNVertex();
+      ROOT::Math::XYZTVector TrackBasedVtx = univ.GetVertex();
+      double batchPOT = univ.GetBatchPOT();
+      //Incorporate batch POT efficiency scaling as applied above
+      double erecoil = univ.GetRecoilE()/pow(10,3);
+      double ANNProb = univ.GetANNProb();
+      double curvsig = 1/univ.GetMuonQPErr();
+      int multiplicity = univ.GetMultiplicity();
+      double pmu = univ.GetPmu()/1000;
+
+      if (!fCuts->isDataSelected(univ, myevent).all()) return;   //All cuts except ANN confidence cut
+
+      if(ANNVtx.X()!=-1.0)
+      {
+        ANNPlaneProbabilityVsPmuData->Fill(ANNProb, pmu);
+        ANNPlaneProbabilityVsEhadData->Fill(ANNProb, erecoil);
+        if (fTargetUtils.InIron2VolMC(ANNVtx.X(), ANNVtx.Y(), ANNVtx.Z(), 850, true))  ANNPlaneProbabilityTgt2IronVsEhadData->Fill(ANNProb, erecoil);
+        if (fTargetUtils.InLead2VolMC(ANNVtx.X(), ANNVtx.Y(), ANNVtx.Z(), 850, true))  ANNPlaneProbabilityTgt2LeadVsEhadData->Fill(ANNProb, erecoil);
+        if (fTargetUtils.InIron3VolMC(ANNVtx.X(), ANNVtx.Y(), ANNVtx.Z(), 850, true))  ANNPlaneProbabilityTgt3IronVsEhadData->Fill(ANNProb, erecoil);
+        if (fTargetUtils.InLead3VolMC(ANNVtx.X(), ANNVtx.Y(), ANNVtx.Z(), 850, true))  ANNPlaneProbabilityTgt3LeadVsEhadData->Fill(ANNProb, erecoil);
+        if (fTargetUtils.InCarbon3VolMC(ANNVtx.X(), ANNVtx.Y(), ANNVtx.Z(), 850, true))  ANNPlaneProbabilityTgt3CarbonVsEhadData->Fill(ANNProb, erecoil);
+        if (fTargetUtils.InLead4VolMC(ANNVtx.X(), ANNVtx.Y(), ANNVtx.Z()))  ANNPlaneProbabilityTgt4LeadVsEhadData->Fill(ANNProb, erecoil);
+        if (fTargetUtils.InIron5VolMC(ANNVtx.X(), ANNVtx.Y(), ANNVtx.Z(), 850, true))  ANNPlaneProbabilityTgt5IronVsEhadData->Fill(ANNProb, erecoil);
+        if (fTargetUtils.InLead5VolMC(ANNVtx.X(), ANNVtx.Y(), ANNVtx.Z(), 850, true))  ANNPlaneProbabilityTgt5LeadVsEhadData->Fill(ANNProb, erecoil);
+        if (fTargetUtils.InWaterTargetVolMC(ANNVtx.X(), ANNVtx.Y(), ANNVtx.Z()))  ANNPlaneProbabilityWaterVsEhadData->Fill(ANNProb, erecoil);
+        if (fTargetUtils.InTracker(ANNVtx.X(), ANNVtx.Y(), ANNVtx.Z()))  ANNPlaneProbabilityTrackerVsEhadData->Fill(ANNProb, erecoil);
+
+        ANNVerticesDataANNConf_ByModule->Fill( ANNVtx.Z(), ANNProb);
+        ANNVerticesDataCurvSig_ByModule->Fill( ANNVtx.Z(), curvsig);
+
+        ANNVerticesData_ByZPosVsANNConf->Fill( ANNVtx.Z(), ANNProb);
+      }
+
+      if (!fANNConfCut.passesCut(univ, myevent)) return;   //ANN confidence cut
+
+      if(ANNVtx.X()!=-1.0)
+      {
+        ANNVerticesData_ByModule->Fill(ANNVtx.Z());
+        ANNVerticesData_ByZPos->Fill(ANNVtx.Z());
+        //for (double cutoff = 0; cutoff <=0.5; cutoff+=0.05)
+        const auto zPosScan = univ.GetANNSegmentsZPosScan();
+        ANNZWeightedVerticesData_VsEhad->Fill(zPosScan.at(1000000), erecoil); //Some arbitrarily large cutoff
+
+        //The data plots are broken down by the unweighted ANN vertex, so the target volumes don't change with the cutoff
+        const util::ValidationVolumes vols = util::getValidationVolumes(fTargetUtils, ANNVtx.X(), ANNVtx.Y(), ANNVtx.Z());
+        for (int cutoff = 0; cutoff <100; cutoff++)
+        {
+          double WeightedANNZPos = zPosScan.at(cutoff);
+          ANNZWeightedVerticesData_VsCutoff->Fill(WeightedANNZPos, cutoff);
+          ANNWeightedVsUnweightedZVertexDifferenceData->Fill((WeightedANNZPos - ANNVtx.Z()), cutoff);
+          if (vols.iron2)  ANNWeightedVsUnweightedZVertexDifferenceTgt2IronData->Fill((WeightedANNZPos - ANNVtx.Z()), cutoff);
+          if (vols.lead2)  ANNWeightedVsUnweightedZVertexDifferenceTgt2LeadData->Fill((WeightedANNZPos - ANNVtx.Z()), cutoff);
+          if (vols.iron3)  ANNWeightedVsUnweightedZVertexDifferenceTgt3IronData->Fill((WeightedANNZPos - ANNVtx.Z()), cutoff);
+          if (vols.lead3)  ANNWeightedVsUnweightedZVertexDifferenceTgt3LeadData->Fill((WeightedANNZPos - ANNVtx.Z()), cutoff);
+          if (vols.carbon3)  ANNWeightedVsUnweightedZVertexDifferenceTgt3CarbonData->Fill((WeightedANNZPos - ANNVtx.Z()), cutoff);
+          if (vols.lead4)  ANNWeightedVsUnweightedZVertexDifferenceTgt4LeadData->Fill((WeightedANNZPos - ANNVtx.Z()), cutoff);
+          if (vols.iron5)  ANNWeightedVsUnweightedZVertexDifferenceTgt5IronData->Fill((WeightedANNZPos - ANNVtx.Z()), cutoff);
+          if (vols.lead5)  ANNWeightedVsUnweightedZVertexDifferenceTgt5LeadData->Fill((WeightedANNZPos - ANNVtx.Z()), cutoff);
+          if (vols.water)  ANNWeightedVsUnweightedZVertexDifferenceWaterData->Fill((WeightedANNZPos - ANNVtx.Z()), cutoff);
+          if (vols.tracker)  ANNWeightedVsUnweightedZVertexDifferenceTrackerData->Fill((WeightedANNZPos - ANNVtx.Z()), cutoff);
+        }
+
+        ANNVerticesData_ByZPosVsERecoil->Fill(ANNVtx.Z(), erecoil);
+
+        ANNVerticesData_ByMod->Fill(univ.GetANNVtxModule());
+
+        ANNVerticesDataERecoil_ByModule->Fill( ANNVtx.Z(), erecoil);
+        ANNVerticesDataMultiplicity_ByModule->Fill( ANNVtx.Z(), multiplicity);
+
+        ANNVerticesDataCurvSig_ByModule->Fill( ANNVtx.Z(), curvsig);
+
+        ANNVerticesData_BySegment->Fill(univ.GetANNSegment());
+        ANNVerticesData_BySegmentVsERecoil->Fill(univ.GetANNSegment(), erecoil);
+      }
+      TBVerticesData_ByZPos->Fill(TrackBasedVtx.Z());
+      TBVerticesData_ByModule->Fill(TrackBasedVtx.Z());
+      TBVerticesData_ByMod->Fill(univ.GetMADVtxModule());
+
+      TBVerticesDataERecoil_ByModule->Fill( TrackBasedVtx.Z(), erecoil);
+      TBVerticesDataMultiplicity_ByModule->Fill( TrackBasedVtx.Z(), multiplicity);
+      TBVerticesDataCurvSig_ByModule->Fill( TrackBasedVtx.Z(), curvsig);
+      ErecoilData->Fill( erecoil);
+    }
+
+    //Call this for every entry in the Truth tree
+    void FillEffDenom(const CVUniverse& univ, const double weight)
+    {
+      if (!fCuts->isEfficiencyDenom(univ, weight))
+        return;                                                // Weight is ignored for isEfficiencyDenom() in all but the CV universe
+      ROOT::Math::XYZTVector TrueVtx = univ.GetTrueVertex();
+      double ANNProb = univ.GetANNProb();
+      double erecoil = univ.GetRecoilE()/pow(10,3);
+
+      ANNPlaneProbabilityVsEhadDenominator->Fill(ANNProb, erecoil, weight);
+      if (fTargetUtils.InTracker(TrueVtx.X(), TrueVtx.Y(), TrueVtx.Z())) ANNPlaneProbabilityTrackerVsEhadDenominator->Fill(ANNProb, erecoil, weight);
+      if (fTargetUtils.InIron2VolMC(TrueVtx.X(), TrueVtx.Y(), TrueVtx.Z(), 850, true)) ANNPlaneProbabilityTgt2IronVsEhadDenominator->Fill(ANNProb, erecoil, weight);
+      if (fTargetUtils.InLead2VolMC(TrueVtx.X(), TrueVtx.Y(), TrueVtx.Z(), 850, true)) ANNPlaneProbabilityTgt2LeadVsEhadDenominator->Fill(ANNProb, erecoil, weight);
+      if (fTargetUtils.InIron3VolMC(TrueVtx.X(), TrueVtx.Y(), TrueVtx.Z(), 850, true)) ANNPlaneProbabilityTgt3IronVsEhadDenominator->Fill(ANNProb, erecoil, weight);
+      if (fTargetUtils.InLead3VolMC(TrueVtx.X(), TrueVtx.Y(), TrueVtx.Z(), 850, true)) ANNPlaneProbabilityTgt3LeadVsEhadDenominator->Fill(ANNProb, erecoil, weight);
+      if (fTargetUtils.InCarbon3VolMC(TrueVtx.X(), TrueVtx.Y(), TrueVtx.Z(), 850, true)) ANNPlaneProbabilityTgt3CarbonVsEhadDenominator->Fill(ANNProb, erecoil, weight);
+      if (fTargetUtils.InLead4VolMC(TrueVtx.X(), TrueVtx.Y(), TrueVtx.Z())) ANNPlaneProbabilityTgt4LeadVsEhadDenominator->Fill(ANNProb, erecoil, weight);
+      if (fTargetUtils.InIron5VolMC(TrueVtx.X(), TrueVtx.Y(), TrueVtx.Z(), 850, true)) ANNPlaneProbabilityTgt5IronVsEhadDenominator->Fill(ANNProb, erecoil, weight);
+      if (fTargetUtils.InLead5VolMC(TrueVtx.X(), TrueVtx.Y(), TrueVtx.Z(), 850, true)) ANNPlaneProbabilityTgt5LeadVsEhadDenominator->Fill(ANNProb, erecoil, weight);
+      if (fTargetUtils.InWaterTargetVolMC(TrueVtx.X(), TrueVtx.Y(), TrueVtx.Z())) ANNPlaneProbabilityWaterVsEhadDenominator->Fill(ANNProb, erecoil, weight);
+    }
+
+    //Every histogram, filled or not, in the order runEventLoopValidations has always written them.
+    //The validation histograms are the only LazyHists, so that's everything in the LazyHistRegistry.
+    void Write(TDirectory& dir)
+    {
+      util::LazyHistRegistry::Get().PrintMemoryUsage(std::cout);
+      util::LazyHistRegistry::Get().Write(dir);
+    }
+
+  private:
+    static std::unique_ptr<PlotUtils::Cutter<CVUniverse, MichelEvent>> GetCuts(const int nupdg)
+    {
+      PlotUtils::Cutter<CVUniverse, MichelEvent>::reco_t sidebands, preCuts;
+      PlotUtils::Cutter<CVUniverse, MichelEvent>::truth_t signalDefinition, phaseSpace;
+
+      preCuts.emplace_back(new reco::Apothem<CVUniverse, MichelEvent>(util::apothem));
+      preCuts.emplace_back(new reco::MaxMuonAngle<CVUniverse, MichelEvent>(17.));
+      preCuts.emplace_back(new reco::HasMINOSMatch<CVUniverse, MichelEvent>());
+      preCuts.emplace_back(new reco::NoDeadtime<CVUniverse, MichelEvent>(1, "Deadtime"));
+      if(nupdg > 0) preCuts.emplace_back(new reco::IsNeutrino<CVUniverse, MichelEvent>()); //Used minos curvature
+      else if(nupdg < 0) preCuts.emplace_back(new reco::IsAntiNeutrino<CVUniverse, MichelEvent>()); //Used minos curvature
+      preCuts.emplace_back(new reco::MuonCurveSignificance<CVUniverse, MichelEvent>(5));
+      preCuts.emplace_back(new reco::MuonEnergyMin<CVUniverse, MichelEvent>(2000.0, "EMu Min"));
+      preCuts.emplace_back(new reco::MuonEnergyMax<CVUniverse, MichelEvent>(20000.0, "EMu Max"));
+      preCuts.emplace_back(new reco::ZRangeANN<CVUniverse, MichelEvent>("Z pos", PlotUtils::TargetProp::NukeRegion::Face, PlotUtils::TargetProp::Tracker::Back));
+      //preCuts.emplace_back(new reco::ANNConfidenceCut<CVUniverse, MichelEvent>(0.40)); //Reccomended at 0.4 for P6 ML vertexing and 0.2 for P4 vertexing
+      //preCuts.emplace_back(new reco::RockMuonCut<CVUniverse, MichelEvent>()); //Reccomended for P6 ML vertexing
+      //preCuts.emplace_back(new reco::VetoWall<CVUniverse, MichelEvent>()); //Reccomended for P6 ML vertexing
+
+      signalDefinition.emplace_back(new truth::IsNeutrino<CVUniverse>());
+      signalDefinition.emplace_back(new truth::IsCC<CVUniverse>());
+
+      phaseSpace = util::GetPhaseSpace();
+      phaseSpace.emplace_back(new truth::ZRange<CVUniverse>("Z pos", PlotUtils::TargetProp::NukeRegion::Face, PlotUtils::TargetProp::Tracker::Back));
+
+      return std::unique_ptr<PlotUtils::Cutter<CVUniverse, MichelEvent>>(new PlotUtils::Cutter<CVUniverse, MichelEvent>(std::move(preCuts), std::move(sidebands), std::move(signalDefinition), std::move(phaseSpace)));
+    }
+
+    std::unique_ptr<PlotUtils::Cutter<CVUniverse, MichelEvent>> fCuts;
+    reco::ANNConfidenceCut<CVUniverse, MichelEvent> fANNConfCut;
+    PlotUtils::TargetUtils fTargetUtils;
+    const bool fVerbose;
+
+    std::vector<double> vertexBins = {4293.04, 4313.68, 4337.25, 4357.9, 4381.47, 4402.11, 4425.68, 4446.33, 4514.11, 4534.76, 4558.33, 4578.97, 4602.54, 4623.19, 4646.76, 4667.4, 4735.19, 4755.83, 4779.4, 4800.05, 4823.62, 4844.26, 4867.83, 4888.48, 5000.48, 5021.12, 5044.69, 5065.34, 5088.91, 5109.55, 5133.12, 5153.77, 5456.74, 5477.38, 5500.95, 5521.6, 5545.17, 5565.81, 5589.38, 5610.02, 5677.81, 5698.45, 5722.03, 5742.67, 5810.45, 5831.1, 5855.68, 5876.33, 5900.91, 5921.56, 5946.14, 5966.79, 5991.37, 6012.01, 6036.6, 6057.24, 6081.83, 6102.47, 6127.06, 6147.7, 6172.29, 6192.93, 6217.52, 6238.16, 6262.74, 6283.39, 6307.97, 6328.62, 6353.2, 6373.85, 6398.43, 6419.08, 6443.66, 6464.3, 6488.89, 6509.53, 6534.12, 6554.76, 6579.35, 6599.99, 6624.58, 6645.22, 6669.81, 6690.45, 6715.03, 6735.68, 6760.26, 6780.91, 6805.49, 6826.14, 6850.72, 6871.37, 6895.95, 6916.59, 6941.18, 6961.82, 6986.41, 7007.05, 7031.64, 7052.28, 7076.87, 7097.51, 7122.1, 7142.74, 7167.32, 7187.97, 7212.55, 7233.2, 7257.78, 7278.43, 7303.01, 7323.66, 7348.24, 7368.88, 7393.47, 7414.11, 7438.7, 7459.34, 7483.93, 7504.57, 7529.16, 7549.8, 7574.39, 7595.03, 7619.61, 7640.26, 7664.84, 7685.49, 7710.07, 7730.72, 7755.3, 7775.95, 7800.53, 7821.17, 7845.76, 7866.4, 7890.99, 7911.63, 7936.22, 7956.86, 7981.45, 8002.09, 8026.68, 8047.32, 8071.9, 8092.55, 8117.13, 8137.78, 8162.36, 8183.01, 8207.59, 8228.24, 8252.82, 8273.46, 8298.05, 8318.69, 8343.28, 8363.92, 8388.51, 8409.15, 8433.74, 8454.38, 8478.97, 8499.61, 8524.19, 8544.84, 8569.42, 8590.07, 8614.65, 8635.3, 8659.46, 8680.1, 8704.26, 8724.9, 8749.06, 8769.71, 8793.86, 8814.51, 8838.67, 8859.31, 8883.47, 8904.11, 8928.27, 8948.92, 8973.08, 8993.72, 9017.88, 9038.52, 9088.08, 9135.41, 9182.75, 9230.08, 9277.41, 9324.74, 9372.08, 9419.41, 9466.74, 9514.07, 9561.41, 9608.74, 9656.07, 9703.4, 9750.74, 9798.07, 9845.4, 9892.73, 9940.07, 9987.4};
+
+    //Histograms are named after what they're written as.  They're only allocated when they're first filled.
+    util::LazyHist<TH1D> ANNVerticesMC_ByModule{"ANNVerticesMC_ByModule", "ANNVerticesMC_ByModule", vertexBins.size()-1, &vertexBins[0]};
+    util::LazyHist<TH1D> TBVerticesMC_ByModule{"TBVerticesMC_ByModule", "TBVerticesMC_ByModule", vertexBins.size()-1, &vertexBins[0]};
+    util::LazyHist<TH1D> ANNVerticesData_ByModule{"ANNVerticesData_ByModule", "ANNVerticesData_ByModule", vertexBins.size()-1, &vertexBins[0]};
+    util::LazyHist<TH1D> TBVerticesData_ByModule{"TBVerticesData_ByModule", "TBVerticesData_ByModule", vertexBins.size()-1, &vertexBins[0]};
+    util::LazyHist<TH1D> TruthVerticesMC_ByModule{"TruthVerticesMC_ByModule", "TruthVerticesMC_ByModule", vertexBins.size()-1, &vertexBins[0]};
+    util::LazyHist<TH1D> ANNVerticesMC_ByZPos{"ANNVerticesMC_ByZPos", "ANNVerticesMC_ByZPos", 9000, 4200, 8700};
+    util::LazyHist<TH1D> TBVerticesMC_ByZPos{"TBVerticesMC_ByZPos", "TBVerticesMC_ByModuleTruthVerticesMC_ByZPosHighRes", 9000, 4200, 8700};
+    util::LazyHist<TH1D> ANNVerticesData_ByZPos{"ANNVerticesData_ByZPos", "ANNVerticesData_ByZPos", 9000, 4200, 8700};
+    util::LazyHist<TH1D> TBVerticesData_ByZPos{"TBVerticesData_ByZPos", "TBVerticesData_ByZPos", 9000, 4200, 8700};
+    util::LazyHist<TH1D> TruthVerticesMC_ByZPos{"TruthVerticesMC_ByZPos", "TruthVerticesMC_ByZPos", 9000, 4200, 8700};
+    util::LazyHist<TH1D> ANNVerticesData_ByMod{"ANNVerticesData_ByMod", "ANNVerticesData_ByMod", 125, -5, 120};
+    util::LazyHist<TH1D> TBVerticesData_ByMod{"TBVerticesData_ByMod", "TBVerticesData_ByMod", 125, -5, 120};
+    util::LazyHist<TH1D> TruthVerticesMC_ByMod{"TruthVerticesMC_ByMod", "TruthVerticesMC_ByMod", 125, -5, 120};
+
+    util::LazyHist<TH2D> ANNZWeightedVerticesData_VsCutoff{"ANNZWeightedVerticesData_VsCutoff", "ANNZWeightedVerticesData_VsCutoff", 9000, 4200, 8700, 100, 0, 100};
+    util::LazyHist<TH2D> ANNZWeightedVerticesMC_VsCutoff{"ANNZWeightedVerticesMC_VsCutoff", "ANNZWeightedVerticesMC_VsCutoff", 9000, 4200, 8700, 100, 0 , 100};
+
+    util::LazyHist<TH2D> ANNZWeightedVerticesData_VsEhad{"ANNZWeightedVerticesData_VsEhad", "ANNZWeightedVerticesData_VsEhad", 9000, 4200, 8700, 100, 0, 20};
+    util::LazyHist<TH2D> ANNZWeightedVerticesMC_VsEhad{"ANNZWeightedVerticesMC_VsEhad", "ANNZWeightedVerticesMC_VsEhad", 9000, 4200, 8700, 100, 0 , 20};
+
+    util::LazyHist<TH1D> ANNVerticesMC_BySegment{"ANNVerticesMC_BySegment", "ANNVerticesMC_BySegment", 220, 0, 220};
+    util::LazyHist<TH1D> TruthVerticesMC_BySegment{"TruthVerticesMC_BySegment", "TruthVerticesMC_BySegment", 220, 0, 220};
+
+    util::LazyHist<TH1D> ANNVerticesData_BySegment{"ANNVerticesData_BySegment", "ANNVerticesData_BySegment", 220, 0, 220};
+
+    util::LazyHist<TH1D> ANNZVertexResidual{"ANNZVertexResidual", "ANNZVertexResidual", 800, -400, 400};
+    util::LazyHist<TH1D> ANNZVertexResidualTracker{"ANNZVertexResidualTracker", "ANNZVertexResidualTracker", 800, -400, 400};
+    util::LazyHist<TH1D> ANNZVertexResidualTgt2Iron{"ANNZVertexResidualTgt2Iron", "ANNZVertexResidualTgt2Iron", 800, -400, 400};
+    util::LazyHist<TH1D> ANNZVertexResidualTgt2Lead{"ANNZVertexResidualTgt2Lead", "ANNZVertexResidualTgt2Lead", 800, -400, 400};
+    util::LazyHist<TH1D> ANNZVertexResidualTgt3Iron{"ANNZVertexResidualTgt3Iron", "ANNZVertexResidualTgt3Iron", 800, -400, 400};
+    util::LazyHist<TH1D> ANNZVertexResidualTgt3Lead{"ANNZVertexResidualTgt3Lead", "ANNZVertexResidualTgt3Lead", 800, -400, 400};
+    util::LazyHist<TH1D> ANNZVertexResidualTgt3Carbon{"ANNZVertexResidualTgt3Carbon", "ANNZVertexResidualTgt3Carbon", 800, -400, 400};
+    util::LazyHist<TH1D> ANNZVertexResidualTgt4Lead{"ANNZVertexResidualTgt4Lead", "ANNZVertexResidualTgt4Lead", 800, -400, 400};
+    util::LazyHist<TH1D> ANNZVertexResidualTgt5Iron{"ANNZVertexResidualTgt5Iron", "ANNZVertexResidualTgt5Iron", 800, -400, 400};
+    util::LazyHist<TH1D> ANNZVertexResidualTgt5Lead{"ANNZVertexResidualTgt5Lead", "ANNZVertexResidualTgt5Lead", 800, -400, 400};
+    util::LazyHist<TH1D> ANNZVertexResidualWater{"ANNZVertexResidualWater", "ANNZVertexResidualWater", 800, -400, 400};
+
+    util::LazyHist<TH2D> ANNZVertexResidualVsConf{"ANNZVertexResidualVsConf", "ANNZVertexResidualVsConf", 800, -400, 400, 10, 0, 1};
+    util::LazyHist<TH2D> ANNZVertexResidualVsConfTracker{"ANNZVertexResidualVsConfTracker", "ANNZVertexResidualVsConfTracker", 800, -400, 400, 10, 0, 1};
+    util::LazyHist<TH2D> ANNZVertexResidualVsConfTgt2Iron{"ANNZVertexResidualVsConfTgt2Iron", "ANNZVertexResidualVsConfTgt2Iron", 800, -400, 400, 10, 0, 1};
+    util::LazyHist<TH2D> ANNZVertexResidualVsConfTgt2Lead{"ANNZVertexResidualVsConfTgt2Lead", "ANNZVertexResidualVsConfTgt2Lead", 800, -400, 400, 10, 0, 1};
+    util::LazyHist<TH2D> ANNZVertexResidualVsConfTgt3Iron{"ANNZVertexResidualVsConfTgt3Iron", "ANNZVertexResidualVsConfTgt3Iron", 800, -400, 400, 10, 0, 1};
+    util::LazyHist<TH2D> ANNZVertexResidualVsConfTgt3Lead{"ANNZVertexResidualVsConfTgt3Lead", "ANNZVertexResidualVsConfTgt3Lead", 800, -400, 400, 10, 0, 1};
+    util::LazyHist<TH2D> ANNZVertexResidualVsConfTgt3Carbon{"ANNZVertexResidualVsConfTgt3Carbon", "ANNZVertexResidualVsConfTgt3Carbon", 800, -400, 400, 10, 0, 1};
+    util::LazyHist<TH2D> ANNZVertexResidualVsConfTgt4Lead{"ANNZVertexResidualVsConfTgt4Lead", "ANNZVertexResidualVsConfTgt4Lead", 800, -400, 400, 10, 0, 1};
+    util::LazyHist<TH2D> ANNZVertexResidualVsConfTgt5Iron{"ANNZVertexResidualVsConfTgt5Iron", "ANNZVertexResidualVsConfTgt5Iron", 800, -400, 400, 10, 0, 1};
+    util::LazyHist<TH2D> ANNZVertexResidualVsConfTgt5Lead{"ANNZVertexResidualVsConfTgt5Lead", "ANNZVertexResidualVsConfTgt5Lead", 800, -400, 400, 10, 0, 1};
+    util::LazyHist<TH2D> ANNZVertexResidualVsConfWater{"ANNZVertexResidualVsConfWater", "ANNZVertexResidualVsConfWater", 800, -400, 400, 10, 0, 1};
+
+    util::LazyHist<TH2D> ANNWeightedZVertexResidualVsConf{"ANNWeightedZVertexResidualVsConf", "ANNWeightedZVertexResidualVsConf", 800, -400, 400, 10, 0, 1};
+    util::LazyHist<TH2D> ANNWeightedZVertexResidualVsConfTracker{"ANNWeightedZVertexResidualVsConfTracker", "ANNWeightedZVertexResidualVsConfTracker", 800, -400, 400, 10, 0, 1};
+    util::LazyHist<TH2D> ANNWeightedZVertexResidualVsConfTgt2Iron{"ANNWeightedZVertexResidualVsConfTgt2Iron", "ANNWeightedZVertexResidualVsConfTgt2Iron", 800, -400, 400, 10, 0, 1};
+    util::LazyHist<TH2D> ANNWeightedZVertexResidualVsConfTgt2Lead{"ANNWeightedZVertexResidualVsConfTgt2Lead", "ANNWeightedZVertexResidualVsConfTgt2Lead", 800, -400, 400, 10, 0, 1};
+    util::LazyHist<TH2D> ANNWeightedZVertexResidualVsConfTgt3Iron{"ANNWeightedZVertexResidualVsConfTgt3Iron", "ANNWeightedZVertexResidualVsConfTgt3Iron", 800, -400, 400, 10, 0, 1};
+    util::LazyHist<TH2D> ANNWeightedZVertexResidualVsConfTgt3Lead{"ANNWeightedZVertexResidualVsConfTgt3Lead", "ANNWeightedZVertexResidualVsConfTgt3Lead", 800, -400, 400, 10, 0, 1};
+    util::LazyHist<TH2D> ANNWeightedZVertexResidualVsConfTgt3Carbon{"ANNWeightedZVertexResidualVsConfTgt3Carbon", "ANNWeightedZVertexResidualVsConfTgt3Carbon", 800, -400, 400, 10, 0, 1};
+    util::LazyHist<TH2D> ANNWeightedZVertexResidualVsConfTgt4Lead{"ANNWeightedZVertexResidualVsConfTgt4Lead", "ANNWeightedZVertexResidualVsConfTgt4Lead", 800, -400, 400, 10, 0, 1};
+    util::LazyHist<TH2D> ANNWeightedZVertexResidualVsConfTgt5Iron{"ANNWeightedZVertexResidualVsConfTgt5Iron", "ANNWeightedZVertexResidualVsConfTgt5Iron", 800, -400, 400, 10, 0, 1};
+    util::LazyHist<TH2D> ANNWeightedZVertexResidualVsConfTgt5Lead{"ANNWeightedZVertexResidualVsConfTgt5Lead", "ANNWeightedZVertexResidualVsConfTgt5Lead", 800, -400, 400, 10, 0, 1};
+    util::LazyHist<TH2D> ANNWeightedZVertexResidualVsConfWater{"ANNWeightedZVertexResidualVsConfWater", "ANNWeightedZVertexResidualVsConfWater", 800, -400, 400, 10, 0, 1};
+
+    util::LazyHist<TH2D> ANNWeightedZVertexResidual{"ANNWeightedZVertexResidual", "ANNWeightedZVertexResidual", 800, -400, 400, 101, 0, 100};
+    util::LazyHist<TH2D> ANNWeightedZVertexResidualTracker{"ANNWeightedZVertexResidualTracker", "ANNWeightedZVertexResidualTracker", 800, -400, 400, 101, 0, 100};
+    util::LazyHist<TH2D> ANNWeightedZVertexResidualTgt2Iron{"ANNWeightedZVertexResidualTgt2Iron", "ANNWeightedZVertexResidualTgt2Iron", 800, -400, 400, 101, 0, 100};
+    util::LazyHist<TH2D> ANNWeightedZVertexResidualTgt2Lead{"ANNWeightedZVertexResidualTgt2Lead", "ANNWeightedZVertexResidualTgt2Lead", 800, -400, 400, 101, 0, 100};
+    util::LazyHist<TH2D> ANNWeightedZVertexResidualTgt3Iron{"ANNWeightedZVertexResidualTgt3Iron", "ANNWeightedZVertexResidualTgt3Iron", 800, -400, 400, 101, 0, 100};
+    util::LazyHist<TH2D> ANNWeightedZVertexResidualTgt3Lead{"ANNWeightedZVertexResidualTgt3Lead", "ANNWeightedZVertexResidualTgt3Lead", 800, -400, 400, 101, 0, 100};
+    util::LazyHist<TH2D> ANNWeightedZVertexResidualTgt3Carbon{"ANNWeightedZVertexResidualTgt3Carbon", "ANNWeightedZVertexResidualTgt3Carbon", 800, -400, 400, 101, 0, 100};
+    util::LazyHist<TH2D> ANNWeightedZVertexResidualTgt4Lead{"ANNWeightedZVertexResidualTgt4Lead", "ANNWeightedZVertexResidualTgt4Lead", 800, -400, 400, 101, 0, 100};
+    util::LazyHist<TH2D> ANNWeightedZVertexResidualTgt5Iron{"ANNWeightedZVertexResidualTgt5Iron", "ANNWeightedZVertexResidualTgt5Iron", 800, -400, 400, 101, 0, 100};
+    util::LazyHist<TH2D> ANNWeightedZVertexResidualTgt5Lead{"ANNWeightedZVertexResidualTgt5Lead", "ANNWeightedZVertexResidualTgt5Lead", 800, -400, 400, 101, 0, 100};
+    util::LazyHist<TH2D> ANNWeightedZVertexResidualWater{"ANNWeightedZVertexResidualWater", "ANNWeightedZVertexResidualWater", 800, -400, 400, 101, 0, 100};
+
+    util::LazyHist<TH2D> ANNWeightedVsUnweightedZVertexDifferenceMC{"ANNWeightedVsUnweightedZVertexDifferenceMC", "ANNWeightedVsUnweightedZVertexDifferenceMC", 800, -400, 400, 101, 0, 100};
+    util::LazyHist<TH2D> ANNWeightedVsUnweightedZVertexDifferenceTrackerMC{"ANNWeightedVsUnweightedZVertexDifferenceTrackerMC", "ANNWeightedVsUnweightedZVertexDifferenceTrackerMC", 800, -400, 400, 101, 0, 100};
+    util::LazyHist<TH2D> ANNWeightedVsUnweightedZVertexDifferenceTgt2IronMC{"ANNWeightedVsUnweightedZVertexDifferenceTgt2IronMC", "ANNWeightedVsUnweightedZVertexDifferenceTgt2IronMC", 800, -400, 400, 101, 0, 100};
+    util::LazyHist<TH2D> ANNWeightedVsUnweightedZVertexDifferenceTgt2LeadMC{"ANNWeightedVsUnweightedZVertexDifferenceTgt2LeadMC", "ANNWeightedVsUnweightedZVertexDifferenceTgt2LeadMC", 800, -400, 400, 101, 0, 100};
+    util::LazyHist<TH2D> ANNWeightedVsUnweightedZVertexDifferenceTgt3IronMC{"ANNWeightedVsUnweightedZVertexDifferenceTgt3IronMC", "ANNWeightedVsUnweightedZVertexDifferenceTgt3IronMC", 800, -400, 400, 101, 0, 100};
+    util::LazyHist<TH2D> ANNWeightedVsUnweightedZVertexDifferenceTgt3LeadMC{"ANNWeightedVsUnweightedZVertexDifferenceTgt3LeadMC", "ANNWeightedVsUnweightedZVertexDifferenceTgt3LeadMC", 800, -400, 400, 101, 0, 100};
+    util::LazyHist<TH2D> ANNWeightedVsUnweightedZVertexDifferenceTgt3CarbonMC{"ANNWeightedVsUnweightedZVertexDifferenceTgt3CarbonMC", "ANNWeightedVsUnweightedZVertexDifferenceTgt3CarbonMC", 800, -400, 400, 101, 0, 100};
+    util::LazyHist<TH2D> ANNWeightedVsUnweightedZVertexDifferenceTgt4LeadMC{"ANNWeightedVsUnweightedZVertexDifferenceTgt4LeadMC", "ANNWeightedVsUnweightedZVertexDifferenceTgt4LeadMC", 800, -400, 400, 101, 0, 100};
+    util::LazyHist<TH2D> ANNWeightedVsUnweightedZVertexDifferenceTgt5IronMC{"ANNWeightedVsUnweightedZVertexDifferenceTgt5IronMC", "ANNWeightedVsUnweightedZVertexDifferenceTgt5IronMC", 800, -400, 400, 101, 0, 100};
+    util::LazyHist<TH2D> ANNWeightedVsUnweightedZVertexDifferenceTgt5LeadMC{"ANNWeightedVsUnweightedZVertexDifferenceTgt5LeadMC", "ANNWeightedVsUnweightedZVertexDifferenceTgt5LeadMC", 800, -400, 400, 101, 0, 100};
+    util::LazyHist<TH2D> ANNWeightedVsUnweightedZVertexDifferenceWaterMC{"ANNWeightedVsUnweightedZVertexDifferenceWaterMC", "ANNWeightedVsUnweightedZVertexDifferenceWaterMC", 800, -400, 400, 101, 0, 100};
+
+    util::LazyHist<TH2D> ANNWeightedVsUnweightedZVertexDifferenceData{"ANNWeightedVsUnweightedZVertexDifferenceData", "ANNWeightedVsUnweightedZVertexDifferenceData", 800, -400, 400, 101, 0, 100};
+    util::LazyHist<TH2D> ANNWeightedVsUnweightedZVertexDifferenceTrackerData{"ANNWeightedVsUnweightedZVertexDifferenceTrackerData", "ANNWeightedVsUnweightedZVertexDifferenceTrackerData", 800, -400, 400, 101, 0, 100};
+    util::LazyHist<TH2D> ANNWeightedVsUnweightedZVertexDifferenceTgt2IronData{"ANNWeightedVsUnweightedZVertexDifferenceTgt2IronData", "ANNWeightedVsUnweightedZVertexDifferenceTgt2IronData", 800, -400, 400, 101, 0, 100};
+    util::LazyHist<TH2D> ANNWeightedVsUnweightedZVertexDifferenceTgt2LeadData{"ANNWeightedVsUnweightedZVertexDifferenceTgt2LeadData", "ANNWeightedVsUnweightedZVertexDifferenceTgt2LeadData", 800, -400, 400, 101, 0, 100};
+    util::LazyHist<TH2D> ANNWeightedVsUnweightedZVertexDifferenceTgt3IronData{"ANNWeightedVsUnweightedZVertexDifferenceTgt3IronData", "ANNWeightedVsUnweightedZVertexDifferenceTgt3IronData", 800, -400, 400, 101, 0, 100};
+    util::LazyHist<TH2D> ANNWeightedVsUnweightedZVertexDifferenceTgt3LeadData{"ANNWeightedVsUnweightedZVertexDifferenceTgt3LeadData", "ANNWeightedVsUnweightedZVertexDifferenceTgt3LeadData", 800, -400, 400, 101, 0, 100};
+    util::LazyHist<TH2D> ANNWeightedVsUnweightedZVertexDifferenceTgt3CarbonData{"ANNWeightedVsUnweightedZVertexDifferenceTgt3CarbonData", "ANNWeightedVsUnweightedZVertexDifferenceTgt3CarbonData", 800, -400, 400, 101, 0, 100};
+    util::LazyHist<TH2D> ANNWeightedVsUnweightedZVertexDifferenceTgt4LeadData{"ANNWeightedVsUnweightedZVertexDifferenceTgt4LeadData", "ANNWeightedVsUnweightedZVertexDifferenceTgt4LeadData", 800, -400, 400, 101, 0, 100};
+    util::LazyHist<TH2D> ANNWeightedVsUnweightedZVertexDifferenceTgt5IronData{"ANNWeightedVsUnweightedZVertexDifferenceTgt5IronData", "ANNWeightedVsUnweightedZVertexDifferenceTgt5IronData", 800, -400, 400, 101, 0, 100};
+    util::LazyHist<TH2D> ANNWeightedVsUnweightedZVertexDifferenceTgt5LeadData{"ANNWeightedVsUnweightedZVertexDifferenceTgt5LeadData", "ANNWeightedVsUnweightedZVertexDifferenceTgt5LeadData", 800, -400, 400, 101, 0, 100};
+    util::LazyHist<TH2D> ANNWeightedVsUnweightedZVertexDifferenceWaterData{"ANNWeightedVsUnweightedZVertexDifferenceWaterData", "ANNWeightedVsUnweightedZVertexDifferenceWaterData", 800, -400, 400, 101, 0, 100};
+
+    util::LazyHist<TH2D> ANNZResidualVsConfDifference{"ANNZResidualVsConfDifference", "ANNZResidualVsConfDifference", 100, -400, 400, 100, 0, 1};
+    util::LazyHist<TH2D> ANNZResidualVsConfDifferenceTracker{"ANNZResidualVsConfDifferenceTracker", "ANNZResidualVsConfDifferenceTracker", 100, -400, 400, 100, 0, 1};
+    util::LazyHist<TH2D> ANNZResidualVsConfDifferenceTgt2Iron{"ANNZResidualVsConfDifferenceTgt2Iron", "ANNZResidualVsConfDifferenceTgt2Iron", 100, -400, 400, 100, 0, 1};
+    util::LazyHist<TH2D> ANNZResidualVsConfDifferenceTgt2Lead{"ANNZResidualVsConfDifferenceTgt2Lead", "ANNZResidualVsConfDifferenceTgt2Lead", 100, -400, 400, 100, 0, 1};
+    util::LazyHist<TH2D> ANNZResidualVsConfDifferenceTgt3Iron{"ANNZResidualVsConfDifferenceTgt3Iron", "ANNZResidualVsConfDifferenceTgt3Iron", 100, -400, 400, 100, 0, 1};
+    util::LazyHist<TH2D> ANNZResidualVsConfDifferenceTgt3Lead{"ANNZResidualVsConfDifferenceTgt3Lead", "ANNZResidualVsConfDifferenceTgt3Lead", 100, -400, 400, 100, 0, 1};
+    util::LazyHist<TH2D> ANNZResidualVsConfDifferenceTgt3Carbon{"ANNZResidualVsConfDifferenceTgt3Carbon", "ANNZResidualVsConfDifferenceTgt3Carbon", 100, -400, 400, 100, 0, 1};
+    util::LazyHist<TH2D> ANNZResidualVsConfDifferenceTgt4Lead{"ANNZResidualVsConfDifferenceTgt4Lead", "ANNZResidualVsConfDifferenceTgt4Lead", 100, -400, 400, 100, 0, 1};
+    util::LazyHist<TH2D> ANNZResidualVsConfDifferenceTgt5Iron{"ANNZResidualVsConfDifferenceTgt5Iron", "ANNZResidualVsConfDifferenceTgt5Iron", 100, -400, 400, 100, 0, 1};
+    util::LazyHist<TH2D> ANNZResidualVsConfDifferenceTgt5Lead{"ANNZResidualVsConfDifferenceTgt5Lead", "ANNZResidualVsConfDifferenceTgt5Lead", 100, -400, 400, 100, 0, 1};
+    util::LazyHist<TH2D> ANNZResidualVsConfDifferenceWater{"ANNZResidualVsConfDifferenceWater", "ANNZResidualVsConfDifferenceWater", 100, -400, 400, 100, 0, 1};
+
+    util::LazyHist<TH2D> ANNPlaneProbabilityVsEhadData{"ANNPlaneProbabilityVsEhadData", "ANNPlaneProbabilityVsEhadData", 100, 0, 1, 100, 0, 20};
+    util::LazyHist<TH2D> ANNPlaneProbabilityTrackerVsEhadData{"ANNPlaneProbabilityTrackerVsEhadData", "ANNPlaneProbabilityTrackerVsEhadData", 100, 0, 1, 100, 0, 20};
+    util::LazyHist<TH2D> ANNPlaneProbabilityTgt2IronVsEhadData{"ANNPlaneProbabilityTgt2IronVsEhadData", "ANNPlaneProbabilityTgt2IronVsEhadData", 100, 0, 1, 100, 0, 20};
+    util::LazyHist<TH2D> ANNPlaneProbabilityTgt2LeadVsEhadData{"ANNPlaneProbabilityTgt2LeadVsEhadData", "ANNPlaneProbabilityTgt2LeadVsEhadData", 100, 0, 1, 100, 0, 20};
+    util::LazyHist<TH2D> ANNPlaneProbabilityTgt3IronVsEhadData{"ANNPlaneProbabilityTgt3IronVsEhadData", "ANNPlaneProbabilityTgt3IronVsEhadData", 100, 0, 1, 100, 0, 20};
+    util::LazyHist<TH2D> ANNPlaneProbabilityTgt3LeadVsEhadData{"ANNPlaneProbabilityTgt3LeadVsEhadData", "ANNPlaneProbabilityTgt3LeadVsEhadData", 100, 0, 1, 100, 0, 20};
+    util::LazyHist<TH2D> ANNPlaneProbabilityTgt3CarbonVsEhadData{"ANNPlaneProbabilityTgt3CarbonVsEhadData", "ANNPlaneProbabilityTgt3CarbonVsEhadData", 100, 0, 1, 100, 0, 20};
+    util::LazyHist<TH2D> ANNPlaneProbabilityTgt4LeadVsEhadData{"ANNPlaneProbabilityTgt4LeadVsEhadData", "ANNPlaneProbabilityTgt4LeadVsEhadData", 100, 0, 1, 100, 0, 20};
+    util::LazyHist<TH2D> ANNPlaneProbabilityTgt5IronVsEhadData{"ANNPlaneProbabilityTgt5IronVsEhadData", "ANNPlaneProbabilityTgt5IronVsEhadData", 100, 0, 1, 100, 0, 20};
+    util::LazyHist<TH2D> ANNPlaneProbabilityTgt5LeadVsEhadData{"ANNPlaneProbabilityTgt5LeadVsEhadData", "ANNPlaneProbabilityTgt5LeadVsEhadData", 100, 0, 1, 100, 0, 20};
+    util::LazyHist<TH2D> ANNPlaneProbabilityWaterVsEhadData{"ANNPlaneProbabilityWaterVsEhadData", "ANNPlaneProbabilityWaterVsEhadData", 100, 0, 1, 100, 0, 20};
+
+    util::LazyHist<TH2D> ANNPlaneProbabilityVsEhadMC{"ANNPlaneProbabilityVsEhadMC", "ANNPlaneProbabilityVsEhadMC", 100, 0, 1, 100, 0, 20};
+    util::LazyHist<TH2D> ANNPlaneProbabilityTrackerVsEhadMC{"ANNPlaneProbabilityTrackerVsEhadMC", "ANNPlaneProbabilityTrackerVsEhadMC", 100, 0, 1, 100, 0, 20};
+    util::LazyHist<TH2D> ANNPlaneProbabilityTgt2IronVsEhadMC{"ANNPlaneProbabilityTgt2IronVsEhadMC", "ANNPlaneProbabilityTgt2IronVsEhadMC", 100, 0, 1, 100, 0, 20};
+    util::LazyHist<TH2D> ANNPlaneProbabilityTgt2LeadVsEhadMC{"ANNPlaneProbabilityTgt2LeadVsEhadMC", "ANNPlaneProbabilityTgt2LeadVsEhadMC", 100, 0, 1, 100, 0, 20};
+    util::LazyHist<TH2D> ANNPlaneProbabilityTgt3IronVsEhadMC{"ANNPlaneProbabilityTgt3IronVsEhadMC", "ANNPlaneProbabilityTgt3IronVsEhadMC", 100, 0, 1, 100, 0, 20};
+    util::LazyHist<TH2D> ANNPlaneProbabilityTgt3LeadVsEhadMC{"ANNPlaneProbabilityTgt3LeadVsEhadMC", "ANNPlaneProbabilityTgt3LeadVsEhadMC", 100, 0, 1, 100, 0, 20};
+    util::LazyHist<TH2D> ANNPlaneProbabilityTgt3CarbonVsEhadMC{"ANNPlaneProbabilityTgt3CarbonVsEhadMC", "ANNPlaneProbabilityTgt3CarbonVsEhadMC", 100, 0, 1, 100, 0, 20};
+    util::LazyHist<TH2D> ANNPlaneProbabilityTgt4LeadVsEhadMC{"ANNPlaneProbabilityTgt4LeadVsEhadMC", "ANNPlaneProbabilityTgt4LeadVsEhadMC", 100, 0, 1, 100, 0, 20};
+    util::LazyHist<TH2D> ANNPlaneProbabilityTgt5IronVsEhadMC{"ANNPlaneProbabilityTgt5IronVsEhadMC", "ANNPlaneProbabilityTgt5IronVsEhadMC", 100, 0, 1, 100, 0, 20};
+    util::LazyHist<TH2D> ANNPlaneProbabilityTgt5LeadVsEhadMC{"ANNPlaneProbabilityTgt5LeadVsEhadMC", "ANNPlaneProbabilityTgt5LeadVsEhadMC", 100, 0, 1, 100, 0, 20};
+    util::LazyHist<TH2D> ANNPlaneProbabilityWaterVsEhadMC{"ANNPlaneProbabilityWaterVsEhadMC", "ANNPlaneProbabilityWaterVsEhadMC", 100, 0, 1, 100, 0, 20};
+
+    //ERecoil
+    util::LazyHist<TH1D> ErecoilMC{"ErecoilMC", "ErecoilMC", 1000, 0, 20};
+    util::LazyHist<TH1D> ErecoilData{"ErecoilData", "ErecoilData", 1000, 0, 20};
+    util::LazyHist<TH2D> TruthVerticesMCERecoil_ByModule{"TruthVerticesMCERecoil_ByModule", "TruthVerticesMCERecoil_ByModule", vertexBins.size()-1, &vertexBins[0], 1000, 0, 20};
+    util::LazyHist<TH2D> ANNVerticesMCERecoil_ByModule{"ANNVerticesMCERecoil_ByModule", "ANNVerticesMCERecoil_ByModule", vertexBins.size()-1, &vertexBins[0], 1000, 0, 20};
+    util::LazyHist<TH2D> TBVerticesMCERecoil_ByModule{"TBVerticesMCERecoil_ByModule", "TBVerticesMCERecoil_ByModule", vertexBins.size()-1, &vertexBins[0], 1000, 0, 20};
+    util::LazyHist<TH2D> ANNVerticesDataERecoil_ByModule{"ANNVerticesDataERecoil_ByModule", "ANNVerticesDataERecoil_ByModule", vertexBins.size()-1, &vertexBins[0], 1000, 0, 20};
+    util::LazyHist<TH2D> TBVerticesDataERecoil_ByModule{"TBVerticesDataERecoil_ByModule", "TBVerticesDataERecoil_ByModule", vertexBins.size()-1, &vertexBins[0], 1000, 0, 20};
+
+    util::LazyHist<TH2D> ANNVerticesData_ByZPosVsERecoil{"ANNVerticesData_ByZPosVsERecoil", "ANNVerticesData_ByZPosVsERecoil", 9000, 4200, 8700, 100, 0, 20};
+    util::LazyHist<TH2D> ANNVerticesMC_ByZPosVsERecoil{"ANNVerticesMC_ByZPosVsERecoil", "ANNVerticesMC_ByZPosVsERecoil", 9000, 4200, 8700, 100, 0, 20};
+
+    util::LazyHist<TH2D> ANNVerticesMC_BySegmentVsERecoil{"ANNVerticesMC_BySegmentVsERecoil", "ANNVerticesMC_BySegmentVsERecoil", 220, 0, 220, 1000, 0, 20};
+    util::LazyHist<TH2D> TruthVerticesMC_BySegmentVsERecoil{"TruthVerticesMC_BySegmentVsERecoil", "TruthVerticesMC_BySegmentVsERecoil", 220, 0, 220, 1000, 0, 20};
+    util::LazyHist<TH2D> ANNVerticesData_BySegmentVsERecoil{"ANNVerticesData_BySegmentVsERecoil", "ANNVerticesData_BySegmentVsERecoil", 220, 0, 220, 1000, 0, 20};
+
+    //Multiplicity
+    util::LazyHist<TH2D> TruthVerticesMCMultiplicity_ByModule{"TruthVerticesMCMultiplicity_ByModule", "TruthVerticesMCMultiplicity_ByModule", vertexBins.size()-1, &vertexBins[0], 10, 0, 10};
+    util::LazyHist<TH2D> ANNVerticesMCMultiplicity_ByModule{"ANNVerticesMCMultiplicity_ByModule", "ANNVerticesMCMultiplicity_ByModule", vertexBins.size()-1, &vertexBins[0], 10, 0, 10};
+    util::LazyHist<TH2D> TBVerticesMCMultiplicity_ByModule{"TBVerticesMCMultiplicity_ByModule", "TBVerticesMCMultiplicity_ByModule", vertexBins.size()-1, &vertexBins[0], 10, 0, 10};
+    util::LazyHist<TH2D> ANNVerticesDataMultiplicity_ByModule{"ANNVerticesDataMultiplicity_ByModule", "ANNVerticesDataMultiplicity_ByModule", vertexBins.size()-1, &vertexBins[0], 10, 0, 10};
+    util::LazyHist<TH2D> TBVerticesDataMultiplicity_ByModule{"TBVerticesDataMultiplicity_ByModule", "TBVerticesDataMultiplicity_ByModule", vertexBins.size()-1, &vertexBins[0], 10, 0, 10};
+
+    //ANN Confidence
+    util::LazyHist<TH2D> TruthVerticesMCANNConf_ByModule{"TruthVerticesMCANNConf_ByModule", "TruthVerticesMCANNConf_ByModule", vertexBins.size()-1, &vertexBins[0], 100, 0, 1};
+    util::LazyHist<TH2D> ANNVerticesMCANNConf_ByModule{"ANNVerticesMCANNConf_ByModule", "ANNVerticesMCANNConf_ByModule", vertexBins.size()-1, &vertexBins[0], 100, 0, 1};
+    util::LazyHist<TH2D> ANNVerticesDataANNConf_ByModule{"ANNVerticesDataANNConf_ByModule", "ANNVerticesDataANNConf_ByModule", vertexBins.size()-1, &vertexBins[0], 100, 0, 1};
+
+    util::LazyHist<TH2D> ANNVerticesData_ByZPosVsANNConf{"ANNVerticesData_ByZPosVsANNConf", "ANNVerticesData_ByZPosVsANNConf", 9000, 4200, 8700, 100, 0, 1};
+    util::LazyHist<TH2D> ANNVerticesMC_ByZPosVsANNConf{"ANNVerticesMC_ByZPosVsANNConf", "ANNVerticesMC_ByZPosVsANNConf", 9000, 4200, 8700, 100, 0, 1};
+
+    //For events misreconstructed in each target, what's the probability distribution
+    util::LazyHist<TH1D> ANNConfMisrecoInTgt2Iron{"ANNConfMisrecoInTgt2Iron", "ANNConfMisrecoInTgt2Iron", 100, 0, 1};
+    util::LazyHist<TH1D> ANNConfMisrecoInTgt2Lead{"ANNConfMisrecoInTgt2Lead", "ANNConfMisrecoInTgt2Lead", 100, 0, 1};
+    util::LazyHist<TH1D> ANNConfMisrecoInTgt3Iron{"ANNConfMisrecoInTgt3Iron", "ANNConfMisrecoInTgt3Iron", 100, 0, 1};
+    util::LazyHist<TH1D> ANNConfMisrecoInTgt3Lead{"ANNConfMisrecoInTgt3Lead", "ANNConfMisrecoInTgt3Lead", 100, 0, 1};
+    util::LazyHist<TH1D> ANNConfMisrecoInTgt3Carbon{"ANNConfMisrecoInTgt3Carbon", "ANNConfMisrecoInTgt3Carbon", 100, 0, 1};
+    util::LazyHist<TH1D> ANNConfMisrecoInTgt4Lead{"ANNConfMisrecoInTgt4Lead", "ANNConfMisrecoInTgt4Lead", 100, 0, 1};
+    util::LazyHist<TH1D> ANNConfMisrecoInTgt5Iron{"ANNConfMisrecoInTgt5Iron", "ANNConfMisrecoInTgt5Iron", 100, 0, 1};
+    util::LazyHist<TH1D> ANNConfMisrecoInTgt5Lead{"ANNConfMisrecoInTgt5Lead", "ANNConfMisrecoInTgt5Lead", 100, 0, 1};
+    util::LazyHist<TH1D> ANNConfMisrecoInWater{"ANNConfMisrecoInWater", "ANNConfMisrecoInWater", 100, 0, 1};
+
+    util::LazyHist<TH2D> ANNPlaneProbabilityVsPmuMC{"ANNPlaneProbabilityVsPmuMC", "ANNPlaneProbabilityVsPmuMC", 100, 0, 1, 50, 0, 50};
+    util::LazyHist<TH2D> ANNPlaneProbabilityVsPmuData{"ANNPlaneProbabilityVsPmuData", "ANNPlaneProbabilityVsPmuData", 100, 0, 1, 50, 0, 50};
+
+    //Efficiency as a function of ANNConfidence and EHad bin
+
+    util::LazyHist<TH2D> ANNPlaneProbabilityVsEhadNumerator{"ANNPlaneProbabilityVsEhadNumerator", "ANNPlaneProbabilityVsEhadNumerator", 100, 0, 1, 100, 0, 20};
+    util::LazyHist<TH2D> ANNPlaneProbabilityTrackerVsEhadNumerator{"ANNPlaneProbabilityTrackerVsEhadNumerator", "ANNPlaneProbabilityTrackerVsEhadNumerator", 100, 0, 1, 100, 0, 20};
+    util::LazyHist<TH2D> ANNPlaneProbabilityTgt2IronVsEhadNumerator{"ANNPlaneProbabilityTgt2IronVsEhadNumerator", "ANNPlaneProbabilityTgt2IronVsEhadNumerator", 100, 0, 1, 100, 0, 20};
+    util::LazyHist<TH2D> ANNPlaneProbabilityTgt2LeadVsEhadNumerator{"ANNPlaneProbabilityTgt2LeadVsEhadNumerator", "ANNPlaneProbabilityTgt2LeadVsEhadNumerator", 100, 0, 1, 100, 0, 20};
+    util::LazyHist<TH2D> ANNPlaneProbabilityTgt3IronVsEhadNumerator{"ANNPlaneProbabilityTgt3IronVsEhadNumerator", "ANNPlaneProbabilityTgt3IronVsEhadNumerator", 100, 0, 1, 100, 0, 20};
+    util::LazyHist<TH2D> ANNPlaneProbabilityTgt3LeadVsEhadNumerator{"ANNPlaneProbabilityTgt3LeadVsEhadNumerator", "ANNPlaneProbabilityTgt3LeadVsEhadNumerator", 100, 0, 1, 100, 0, 20};
+    util::LazyHist<TH2D> ANNPlaneProbabilityTgt3CarbonVsEhadNumerator{"ANNPlaneProbabilityTgt3CarbonVsEhadNumerator", "ANNPlaneProbabilityTgt3CarbonVsEhadNumerator", 100, 0, 1, 100, 0, 20};
+    util::LazyHist<TH2D> ANNPlaneProbabilityTgt4LeadVsEhadNumerator{"ANNPlaneProbabilityTgt4LeadVsEhadNumerator", "ANNPlaneProbabilityTgt4LeadVsEhadNumerator", 100, 0, 1, 100, 0, 20};
+    util::LazyHist<TH2D> ANNPlaneProbabilityTgt5IronVsEhadNumerator{"ANNPlaneProbabilityTgt5IronVsEhadNumerator", "ANNPlaneProbabilityTgt5IronVsEhadNumerator", 100, 0, 1, 100, 0, 20};
+    util::LazyHist<TH2D> ANNPlaneProbabilityTgt5LeadVsEhadNumerator{"ANNPlaneProbabilityTgt5LeadVsEhadNumerator", "ANNPlaneProbabilityTgt5LeadVsEhadNumerator", 100, 0, 1, 100, 0, 20};
+    util::LazyHist<TH2D> ANNPlaneProbabilityWaterVsEhadNumerator{"ANNPlaneProbabilityWaterVsEhadNumerator", "ANNPlaneProbabilityWaterVsEhadNumerator", 100, 0, 1, 100, 0, 20};
+
+    util::LazyHist<TH2D> ANNPlaneProbabilityVsEhadDenominator{"ANNPlaneProbabilityVsEhadDenominator", "ANNPlaneProbabilityVsEhadDenominator", 100, 0, 1, 100, 0, 20};
+    util::LazyHist<TH2D> ANNPlaneProbabilityTrackerVsEhadDenominator{"ANNPlaneProbabilityTrackerVsEhadDenominator", "ANNPlaneProbabilityTrackerVsEhadDenominator", 100, 0, 1, 100, 0, 20};
+    util::LazyHist<TH2D> ANNPlaneProbabilityTgt2IronVsEhadDenominator{"ANNPlaneProbabilityTgt2IronVsEhadDenominator", "ANNPlaneProbabilityTgt2IronVsEhadDenominator", 100, 0, 1, 100, 0, 20};
+    util::LazyHist<TH2D> ANNPlaneProbabilityTgt2LeadVsEhadDenominator{"ANNPlaneProbabilityTgt2LeadVsEhadDenominator", "ANNPlaneProbabilityTgt2LeadVsEhadDenominator", 100, 0, 1, 100, 0, 20};
+    util::LazyHist<TH2D> ANNPlaneProbabilityTgt3IronVsEhadDenominator{"ANNPlaneProbabilityTgt3IronVsEhadDenominator", "ANNPlaneProbabilityTgt3IronVsEhadDenominator", 100, 0, 1, 100, 0, 20};
+    util::LazyHist<TH2D> ANNPlaneProbabilityTgt3LeadVsEhadDenominator{"ANNPlaneProbabilityTgt3LeadVsEhadDenominator", "ANNPlaneProbabilityTgt3LeadVsEhadDenominator", 100, 0, 1, 100, 0, 20};
+    util::LazyHist<TH2D> ANNPlaneProbabilityTgt3CarbonVsEhadDenominator{"ANNPlaneProbabilityTgt3CarbonVsEhadDenominator", "ANNPlaneProbabilityTgt3CarbonVsEhadDenominator", 100, 0, 1, 100, 0, 20};
+    util::LazyHist<TH2D> ANNPlaneProbabilityTgt4LeadVsEhadDenominator{"ANNPlaneProbabilityTgt4LeadVsEhadDenominator", "ANNPlaneProbabilityTgt4LeadVsEhadDenominator", 100, 0, 1, 100, 0, 20};
+    util::LazyHist<TH2D> ANNPlaneProbabilityTgt5IronVsEhadDenominator{"ANNPlaneProbabilityTgt5IronVsEhadDenominator", "ANNPlaneProbabilityTgt5IronVsEhadDenominator", 100, 0, 1, 100, 0, 20};
+    util::LazyHist<TH2D> ANNPlaneProbabilityTgt5LeadVsEhadDenominator{"ANNPlaneProbabilityTgt5LeadVsEhadDenominator", "ANNPlaneProbabilityTgt5LeadVsEhadDenominator", 100, 0, 1, 100, 0, 20};
+    util::LazyHist<TH2D> ANNPlaneProbabilityWaterVsEhadDenominator{"ANNPlaneProbabilityWaterVsEhadDenominator", "ANNPlaneProbabilityWaterVsEhadDenominator", 100, 0, 1, 100, 0, 20};
+
+    //Curvature signifiance
+    util::LazyHist<TH2D> TruthVerticesMCCurvSig_ByModule{"TruthVerticesMCCurvSig_ByModule", "TruthVerticesMCCurvSig_ByModule", vertexBins.size()-1, &vertexBins[0], 100, 0, 10};
+    util::LazyHist<TH2D> ANNVerticesMCCurvSig_ByModule{"ANNVerticesMCCurvSig_ByModule", "ANNVerticesMCCurvSig_ByModule", vertexBins.size()-1, &vertexBins[0], 100, 0, 10};
+    util::LazyHist<TH2D> TBVerticesMCCurvSig_ByModule{"TBVerticesMCCurvSig_ByModule", "TBVerticesMCCurvSig_ByModule", vertexBins.size()-1, &vertexBins[0], 100, 0, 10};
+    util::LazyHist<TH2D> ANNVerticesDataCurvSig_ByModule{"ANNVerticesDataCurvSig_ByModule", "ANNVerticesDataCurvSig_ByModule", vertexBins.size()-1, &vertexBins[0], 100, 0, 10};
+    util::LazyHist<TH2D> TBVerticesDataCurvSig_ByModule{"TBVerticesDataCurvSig_ByModule", "TBVerticesDataCurvSig_ByModule", vertexBins.size()-1, &vertexBins[0], 100, 0, 10};
+
+    //Migration ANN only
+    util::LazyHist<TH2D> ANNVerticesConfusion_ByModule{"ANNVerticesConfusion_ByModule", "ANNVerticesConfusion_ByModule", vertexBins.size()-1, &vertexBins[0], vertexBins.size()-1, &vertexBins[0]};
+    util::LazyHist<TH2D> ANNVerticesConfusion_ByZPos{"ANNVerticesConfusion_ByZPos", "ANNVerticesConfusion_ByZPos", 4500, 4200, 8700, 4500, 4200, 8700};
+
+    //==============================================================================
+};
+
+//Fills VertexValidations through the Study interface.  Selected() applies the validation cuts, so give it every
+//event before any other cuts, and TruthSignal() every entry in the Truth tree.  The MC Study fills the signal
+//numerators in Selected() too.  The MC and data Studies share their histograms, so only the MC Study writes them.
+class VertexValidationStudy: public Study
+{
+  public:
+    VertexValidationStudy(std::shared_ptr<VertexValidations> validations, const bool isData): Study(), fValidations(validations), fIsData(isData)
+    {
+    }
+
+    void SaveOrDraw(TDirectory& outDir)
+    {
+      if(!fIsData) fValidations->Write(outDir);
+    }
+
+    VertexValidations& Validations() { return *fValidations; }
+
+  private:
+    std::shared_ptr<VertexValidations> fValidations;
+    const bool fIsData;
+
+    void fillSelected(const CVUniverse& univ, const MichelEvent& /*evt*/, const double weight)
+    {
+      if(univ.ShortName() != "cv") return;
+      if(fIsData) fValidations->FillData(univ);
+      else fValidations->FillMC(univ, weight);
+    }
+
+    //FillMC() checks the signal definition itself
+    void fillSelectedSignal(const CVUniverse& /*univ*/, const MichelEvent& /*evt*/, const double /*weight*/) {}
+
+    void fillTruthSignal(const CVUniverse& univ, const MichelEvent& /*evt*/, const double weight)
+    {
+      if(univ.ShortName() == "cv") fValidations->FillEffDenom(univ, weight);
+    }
+};
+
+#endif //VERTEXVALIDATIONS_H
@@ -15,10 +15,38 @@
 #include "PlotUtils/AngleSystematics.h"
 #include "PlotUtils/MLVertexSystematics.h"
 
+#include <set>
+#include <sstream>
+#include <algorithm>
+#include <stdexcept>
+
 typedef std::map<std::string, std::vector<CVUniverse*>> UniverseMap;
 
-UniverseMap GetStandardSystematics(PlotUtils::ChainWrapper* chain)
+// Groups of error bands that GetStandardSystematics() can be limited to so that
+// each grid job only carries some of the universes.
+const std::vector<std::string> StandardSystematicGroups = {"flux", "genie", "rpa", "2p2h", "muon_minerva", "muon_minos",
+                                                           "minos_efficiency", "muon_resolution", "geant", "angle", "ml_vertex"};
+
+// Comma-separated list of StandardSystematicGroups like "flux,genie"
+std::set<std::string> ParseSystematicGroups(const std::string& list)
+{
+  std::set<std::string> groups;
+  std::stringstream groupNames(list);
+  std::string group;
+  while (std::getline(groupNames, group, ','))
+  {
+    if (std::find(StandardSystematicGroups.begin(), StandardSystematicGroups.end(), group) == StandardSystematicGroups.end())
+      throw std::runtime_error("No group of systematics called \"" + group + "\"");
+    groups.insert(group);
+  }
+  return groups;
+}
+
+// Only makes the universes for groups when that isn't empty
+UniverseMap GetStandardSystematics(PlotUtils::ChainWrapper* chain, const std::set<std::string>& groups = {})
 {
+  auto wanted = [&groups](const std::string& group) { return groups.empty() || groups.count(group); };
+
   // return map
   UniverseMap error_bands;
 
@@ -28,61 +56,91 @@ UniverseMap GetStandardSystematics(PlotUtils::ChainWrapper* chain)
   //========================================================================
   // FLUX
   //========================================================================
-  UniverseMap bands_flux =
-      PlotUtils::GetFluxSystematicsMap<CVUniverse>(chain, CVUniverse::GetNFluxUniverses());
-  error_bands.insert(bands_flux.begin(), bands_flux.end());
+  if (wanted("flux"))
+  {
+    UniverseMap bands_flux =
+        PlotUtils::GetFluxSystematicsMap<CVUniverse>(chain, CVUniverse::GetNFluxUniverses());
+    error_bands.insert(bands_flux.begin(), bands_flux.end());
+  }
 
   //========================================================================
   // GENIE
   //========================================================================
   // Standard
-  UniverseMap bands_genie =
-      PlotUtils::GetGenieSystematicsMap<CVUniverse>(chain); //PlotUtils::GetStandardGenieSystematicsMap<CVUniverse>(chain);
-  error_bands.insert(bands_genie.begin(), bands_genie.end());
+  if (wanted("genie"))
+  {
+    UniverseMap bands_genie =
+        PlotUtils::GetGenieSystematicsMap<CVUniverse>(chain); //PlotUtils::GetStandardGenieSystematicsMap<CVUniverse>(chain);
+    error_bands.insert(bands_genie.begin(), bands_genie.end());
+  }
 
   //========================================================================
   // MnvTunes
   //========================================================================
   // RPA
-  UniverseMap bands_rpa = PlotUtils::GetRPASystematicsMap<CVUniverse>(chain);
-  error_bands.insert(bands_rpa.begin(), bands_rpa.end());
+  if (wanted("rpa"))
+  {
+    UniverseMap bands_rpa = PlotUtils::GetRPASystematicsMap<CVUniverse>(chain);
+    error_bands.insert(bands_rpa.begin(), bands_rpa.end());
+  }
 
   // 2P2H
-  UniverseMap bands_2p2h = PlotUtils::Get2p2hSystematicsMap<CVUniverse>(chain);
-  error_bands.insert(bands_2p2h.begin(), bands_2p2h.end());
+  if (wanted("2p2h"))
+  {
+    UniverseMap bands_2p2h = PlotUtils::Get2p2hSystematicsMap<CVUniverse>(chain);
+    error_bands.insert(bands_2p2h.begin(), bands_2p2h.end());
+  }
 
   //========================================================================
   // Muons
   //========================================================================
   // Muon reco in MINERvA -- Catchall systematic for pmu reco in minerva.
   // Lateral-only. Shifts pmu.
-  UniverseMap bands_muon_minerva =
-      PlotUtils::GetMinervaMuonSystematicsMap<CVUniverse>(chain);
-  error_bands.insert(bands_muon_minerva.begin(), bands_muon_minerva.end());
+  if (wanted("muon_minerva"))
+  {
+    UniverseMap bands_muon_minerva =
+        PlotUtils::GetMinervaMuonSystematicsMap<CVUniverse>(chain);
+    error_bands.insert(bands_muon_minerva.begin(), bands_muon_minerva.end());
+  }
 
   // Muons in MINOS -- Catchall systematic for wiggle solution -- correlates
   // flux universes and minos muon momentum reco.
   // Lateral AND Vertical systematic. Shifts Pmu and GetFluxAndCVUniverse.
   //
   // Expect a non-zero systematic even when no pmu involved.
-  UniverseMap bands_muon_minos =
-     PlotUtils::GetMinosMuonSystematicsMap<CVUniverse>(chain);
-  error_bands.insert(bands_muon_minos.begin(), bands_muon_minos.end());
+  if (wanted("muon_minos"))
+  {
+    UniverseMap bands_muon_minos =
+       PlotUtils::GetMinosMuonSystematicsMap<CVUniverse>(chain);
+    error_bands.insert(bands_muon_minos.begin(), bands_muon_minos.end());
+  }
 
   // Vertical only
-  UniverseMap bands_minoseff =
-      PlotUtils::GetMinosEfficiencySystematicsMap<CVUniverse>(chain);
-  error_bands.insert(bands_minoseff.begin(), bands_minoseff.end());
-
-  UniverseMap bands_muon_resolution = PlotUtils::GetMuonResolutionSystematicsMap<CVUniverse>(chain);
-  error_bands.insert(bands_muon_resolution.begin(), bands_muon_resolution.end());
-
-  UniverseMap bands_geant = PlotUtils::GetGeantHadronSystematicsMap<CVUniverse>(chain);
-  error_bands.insert(bands_geant.begin(), bands_geant.end());
+  if (wanted("minos_efficiency"))
+  {
+    UniverseMap bands_minoseff =
+        PlotUtils::GetMinosEfficiencySystematicsMap<CVUniverse>(chain);
+    error_bands.insert(bands_minoseff.begin(), bands_minoseff.end());
+  }
+
+  if (wanted("muon_resolution"))
+  {
+    UniverseMap bands_muon_resolution = PlotUtils::GetMuonResolutionSystematicsMap<CVUniverse>(chain);
+    error_bands.insert(bands_muon_resolution.begin(), bands_muon_resolution.end());
+  }
+
+  if (wanted("geant"))
+  {
+    UniverseMap bands_geant = PlotUtils::GetGeantHadronSystematicsMap<CVUniverse>(chain);
+    error_bands.insert(bands_geant.begin(), bands_geant.end());
+  }
 
   // Beam angle
-  UniverseMap bands_angle = PlotUtils::GetAngleSystematicsMap<CVUniverse>(chain);
-  error_bands.insert(bands_angle.begin(), bands_angle.end());
+  if (wanted("angle"))
+  {
+    UniverseMap bands_angle = PlotUtils::GetAngleSystematicsMap<CVUniverse>(chain);
+    error_bands.insert(bands_angle.begin(), bands_angle.end());
+  }
 
   // Hadron inelastics cross sections
   //TODO: There's some special recoil function I need to write for the response systematics to work correctly
@@ -92,8 +150,11 @@ UniverseMap GetStandardSystematics(PlotUtils::ChainWrapper* chain)
   //========================================================================
   // ML Vertex uncertainty
   //========================================================================
-  UniverseMap ml_vertex_systematics = PlotUtils::GetMLVertexSystematicsMap<CVUniverse>(chain);
-  error_bands.insert(ml_vertex_systematics.begin(), ml_vertex_systematics.end());
+  if (wanted("ml_vertex"))
+  {
+    UniverseMap ml_vertex_systematics = PlotUtils::GetMLVertexSystematicsMap<CVUniverse>(chain);
+    error_bands.insert(ml_vertex_systematics.begin(), ml_vertex_systematics.end());
+  }
 
   return error_bands;
 }
@@ -0,0 +1,124 @@
+//File: BenchmarkCategorizedLookup.cpp
+//Brief: Times LazyCategorized<> and Categorized<> lookups with the background, interaction type, and sideband labels
+//       that Variable1DNukeNew fills for every selected entry.  The "hashed" lookups use an int wrapped in a struct,
+//       so they take the unordered_map path that every lookup took before the array index.  Both paths have to find
+//       the same HIST for every category, so this fails if they don't.
+//Usage: BenchmarkCategorizedLookup [lookups per label set]
+
+//util includes
+#include "util/LazyCategorized.h"
+#include "util/Categorized.h"
+
+//c++ includes
+#include <iostream>
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+#include <map>
+
+namespace
+{
+  //Just enough of a histogram to see which one a lookup found
+  struct FakeHist
+  {
+    FakeHist(const char* name, const char* /*title*/): name(name), fills(0) {}
+    void Fill(const double) { ++fills; }
+
+    std::string name;
+    long long fills;
+  };
+
+  //Not integral, so it's hashed like any other CATEGORY
+  struct HashedInt
+  {
+    int value;
+    bool operator ==(const HashedInt& other) const { return value == other.value; }
+    bool operator <(const HashedInt& other) const { return value < other.value; }
+  };
+}
+
+namespace std
+{
+  template <>
+  struct hash<HashedInt>
+  {
+    size_t operator ()(const HashedInt& cat) const { return std::hash<int>()(cat.value); }
+  };
+}
+
+namespace
+{
+  //Keys of util::BKGLabelsWithPlasticSidebands, util::GENIELabels, and util::SidebandCategories
+  const std::map<std::string, std::map<int, std::string>> labelSets = {
+    {"background", {{0, "NC_Bkg"}, {1, "Wrong_Sign_Bkg"}, {2, "Upstream_Plastic_Bkg"}, {3, "Downstream_Plastic_Bkg"},
+                    {4, "Water_Tank_Bkg"}, {5, "True_In_Other_Target_Bkg"}, {6, "True_Vtx_Elsewhere_Bkg"}}},
+    {"intType", {{1, "QE"}, {8, "2p2h"}, {2, "RES"}, {3, "DIS"}}},
+    {"sideband", {{0, "US"}, {1, "DS"}, {2, "Signal"}}}
+  };
+
+  template <class CATEGORY>
+  std::map<CATEGORY, std::string> convert(const std::map<int, std::string>& labels)
+  {
+    std::map<CATEGORY, std::string> converted;
+    for(const auto& label: labels) converted[CATEGORY{label.first}] = label.second;
+    return converted;
+  }
+
+  //Nanoseconds per lookup
+  template <class CATEGORIZED, class CATEGORY>
+  double time(CATEGORIZED& hists, const std::vector<int>& values)
+  {
+    const auto start = std::chrono::steady_clock::now();
+    for(const auto value: values) hists[CATEGORY{value}].Fill(1);
+    const auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(stop - start).count() / values.size();
+  }
+}
+
+int main(const int argc, const char** argv)
+{
+  const size_t nLookups = (argc > 1) ? std::stoul(argv[1]) : 10000000;
+  std::mt19937 generator(20261018);
+  int status = 0;
+
+  for(const auto& labels: labelSets)
+  {
+    //Like real fills, mostly categories with a few uncategorized values mixed in
+    const int lowest = labels.second.begin()->first - 1, highest = labels.second.rbegin()->first + 1;
+    std::uniform_int_distribution<int> distribution(lowest, highest);
+    std::vector<int> values(nLookups);
+    for(auto& value: values) value = distribution(generator);
+
+    util::LazyCategorized<FakeHist, int> lazyDense(labels.first, "", labels.second);
+    util::LazyCategorized<FakeHist, HashedInt> lazyHashed(labels.first, "", convert<HashedInt>(labels.second));
+    util::Categorized<FakeHist, int> eagerDense(labels.first, "", labels.second);
+    util::Categorized<FakeHist, HashedInt> eagerHashed(labels.first, "", convert<HashedInt>(labels.second));
+
+    const double lazyHashedTime = time<decltype(lazyHashed), HashedInt>(lazyHashed, values),
+                 lazyDenseTime = time<decltype(lazyDense), int>(lazyDense, values),
+                 eagerHashedTime = time<decltype(eagerHashed), HashedInt>(eagerHashed, values),
+                 eagerDenseTime = time<decltype(eagerDense), int>(eagerDense, values);
+
+    std::cout << labels.first << ": LazyCategorized " << lazyHashedTime << " ns hashed, " << lazyDenseTime << " ns dense.  "
+              << "Categorized " << eagerHashedTime << " ns hashed, " << eagerDenseTime << " ns dense.\n";
+
+    for(int value = lowest; value <= highest; ++value)
+    {
+      if(lazyDense[value].name != lazyHashed[HashedInt{value}].name || eagerDense[value].name != eagerHashed[HashedInt{value}].name
+         || lazyDense[value].name != eagerDense[value].name)
+      {
+        std::cerr << labels.first << " category " << value << " went to different histograms: " << lazyDense[value].name << " and "
+                  << lazyHashed[HashedInt{value}].name << "\n";
+        status = 1;
+      }
+    }
+
+    lazyDense.deleteHists();
+    lazyHashed.deleteHists();
+    eagerDense.deleteHists();
+    eagerHashed.deleteHists();
+  }
+
+  return status;
+}
@@ -0,0 +1,111 @@
+//File: BenchmarkScaledChi2.cpp
+//Brief: Times one sideband fit chi2 evaluation the way getChi2() used to do it, with MnvPlotter::Chi2DataMC(), and
+//       with util::ScaledChi2.  The histograms have as many bins and universes as a sideband distribution with the
+//       full systematics.  Fails if the two chi2s don't agree at every scale factor tried.
+//Usage: BenchmarkScaledChi2 [evaluations] [bins]
+
+//util includes
+#include "util/ScaledChi2.h"
+
+//PlotUtils includes
+#include "PlotUtils/MnvH1D.h"
+#include "PlotUtils/MnvPlotter.h"
+
+#ifndef NCINTEX
+#include "Cintex/Cintex.h"
+#endif
+
+//c++ includes
+#include <iostream>
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include <cmath>
+
+namespace
+{
+  //Vertical error bands and how many universes each has, like the flux and a few GENIE knobs
+  const std::map<std::string, int> bands = {{"Flux", 100}, {"GENIE_MaCCQE", 2}, {"GENIE_MaRES", 2}, {"Low_recoil_fit", 3}, {"MuonResolution", 2}};
+
+  //A smooth distribution with Poisson-like statistical errors and correlated fluctuations in each universe
+  PlotUtils::MnvH1D* makeHist(const std::string& name, const int nBins, const double norm, std::mt19937& generator)
+  {
+    auto hist = new PlotUtils::MnvH1D(name.c_str(), name.c_str(), nBins, 0, nBins);
+    for(int bin = 1; bin <= nBins; ++bin)
+    {
+      const double content = norm * (1 + std::exp(-std::pow((bin - nBins / 3.) / (nBins / 5.), 2)));
+      hist->SetBinContent(bin, content);
+      hist->SetBinError(bin, std::sqrt(content));
+    }
+
+    std::normal_distribution<double> shift(0, 0.05), wiggle(0, 0.01);
+    for(const auto& band: bands)
+    {
+      hist->AddVertErrorBand(band.first, band.second);
+      for(int whichUniv = 0; whichUniv < band.second; ++whichUniv)
+      {
+        auto universe = hist->GetVertErrorBand(band.first)->GetHist(whichUniv);
+        const double tilt = shift(generator);
+        for(int bin = 1; bin <= nBins; ++bin)
+        {
+          universe->SetBinContent(bin, hist->GetBinContent(bin) * (1 + tilt * bin / nBins + wiggle(generator)));
+        }
+      }
+    }
+    return hist;
+  }
+}
+
+int main(const int argc, const char** argv)
+{
+#ifndef NCINTEX
+  ROOT::Cintex::Cintex::Enable(); // Needed to look up dictionaries for PlotUtils classes like MnvH1D
+#endif
+  TH1::AddDirectory(kFALSE);
+
+  const int nEvaluations = (argc > 1) ? std::stoi(argv[1]) : 200, nBins = (argc > 2) ? std::stoi(argv[2]) : 40;
+  std::mt19937 generator(41);
+  std::unique_ptr<PlotUtils::MnvH1D> data(makeHist("data", nBins, 1000, generator)), mc(makeHist("mc", nBins, 900, generator));
+
+  //Minuit tries scale factors near 1
+  std::vector<double> scales;
+  for(int evaluation = 0; evaluation < nEvaluations; ++evaluation) scales.push_back(0.8 + 0.4 * evaluation / nEvaluations);
+
+  PlotUtils::MnvPlotter plotter;
+  plotter.ApplyStyle(PlotUtils::kCCQENuInclusiveStyle);
+  std::vector<double> before, after;
+  auto start = std::chrono::steady_clock::now();
+  for(const double scale: scales)
+  {
+    int ndof;
+    auto tmpHist = data->Clone();
+    before.push_back(plotter.Chi2DataMC(tmpHist, mc.get(), ndof, scale, true, true));
+    delete tmpHist;
+  }
+  const double beforeTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+  start = std::chrono::steady_clock::now();
+  const util::ScaledChi2 chi2(*data, *mc, true);
+  const double setupTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  start = std::chrono::steady_clock::now();
+  for(const double scale: scales) after.push_back(chi2(scale));
+  const double afterTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+  std::cout << nBins << " bins: Chi2DataMC() " << beforeTime / nEvaluations << " ms per evaluation.  ScaledChi2 "
+            << setupTime << " ms to set up and " << afterTime / nEvaluations * 1e3 << " us per evaluation.\n";
+
+  int status = 0;
+  for(size_t whichScale = 0; whichScale < scales.size(); ++whichScale)
+  {
+    if(std::fabs(before[whichScale] - after[whichScale]) > 1e-6 * std::max(1., std::fabs(before[whichScale])))
+    {
+      std::cerr << "chi2 at a scale of " << scales[whichScale] << " is " << before[whichScale] << " from Chi2DataMC() but "
+                << after[whichScale] << " from ScaledChi2\n";
+      status = 1;
+    }
+  }
+  return status;
+}
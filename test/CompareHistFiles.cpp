@@ -0,0 +1,167 @@
+//File: CompareHistFiles.cpp
+//Brief: Makes sure that two output files of the same program have the same histograms.  Every TH1, every universe of
+//       every MnvH1D and MnvH2D, every TParameter<double> like the POT, and every SparseMigration after it's turned
+//       back into the dense objects has to agree.  Subdirectories are compared too.  Other objects, like cut
+//       summaries and input file lists, are ignored.
+//Usage: CompareHistFiles <expected.root> <actual.root>
+//Returns 0 if the files agree, 1 if they don't, and 2 if one can't be read.
+
+//util includes
+#include "util/SparseMigration.h"
+#include "util/GetIngredient.h"
+
+//test includes
+#include "test/CompareHists.h"
+
+//PlotUtils includes
+#include "PlotUtils/MnvH1D.h"
+#include "PlotUtils/MnvH2D.h"
+
+//ROOT includes
+#include "TFile.h"
+#include "TKey.h"
+#include "TClass.h"
+#include "TTree.h"
+#include "TParameter.h"
+#include "TDirectoryFile.h"
+
+#ifndef NCINTEX
+#include "Cintex/Cintex.h"
+#endif
+
+//c++ includes
+#include <iostream>
+#include <memory>
+#include <string>
+#include <set>
+#include <cmath>
+
+namespace
+{
+  const std::string sparseSuffix = "_sparse";
+
+  bool endsWith(const std::string& str, const std::string& suffix)
+  {
+    return str.size() >= suffix.size() && str.compare(str.size() - suffix.size(), suffix.size(), suffix) == 0;
+  }
+
+  //The dense objects that a SparseMigration TTree called name stands for
+  int compareSparseMigration(TDirectoryFile& expected, TDirectoryFile& actual, const std::string& name, const std::string& what)
+  {
+    const std::string migrationName = name.substr(0, name.size() - sparseSuffix.size());
+    std::unique_ptr<TH1> recoBinning(util::GetIngredient<TH1>(expected, migrationName + "_sparse_recoBinning"));
+    if(recoBinning->GetDimension() == 1)
+    {
+      std::unique_ptr<PlotUtils::MnvH2D> expectedMigration(util::GetMigration(expected, migrationName)),
+                                         actualMigration(util::GetMigration(actual, migrationName));
+      return test::compareMnvHist(*expectedMigration, *actualMigration, what);
+    }
+
+    const std::string prefix = migrationName.substr(0, migrationName.rfind("_migration"));
+    PlotUtils::MnvH2D *migration = nullptr, *reco = nullptr, *truth = nullptr;
+    util::GetMigrationObjects(expected, prefix, migration, reco, truth);
+    std::unique_ptr<PlotUtils::MnvH2D> expectedMigration(migration), expectedReco(reco), expectedTruth(truth);
+    util::GetMigrationObjects(actual, prefix, migration, reco, truth);
+    std::unique_ptr<PlotUtils::MnvH2D> actualMigration(migration), actualReco(reco), actualTruth(truth);
+    return test::compareMnvHist(*expectedMigration, *actualMigration, what) + test::compareMnvHist(*expectedReco, *actualReco, what + " reco")
+           + test::compareMnvHist(*expectedTruth, *actualTruth, what + " truth");
+  }
+
+  int compareDirectories(TDirectoryFile& expected, TDirectoryFile& actual, const std::string& path)
+  {
+    std::set<std::string> names; //Keys can have more than one cycle
+    for(auto dir: {&expected, &actual})
+    {
+      TIter nextKey(dir->GetListOfKeys());
+      while(const auto key = nextKey()) names.insert(key->GetName());
+    }
+
+    int nDifferent = 0;
+    for(const auto& name: names)
+    {
+      const std::string what = path + name;
+      const auto expectedKey = expected.GetKey(name.c_str()), actualKey = actual.GetKey(name.c_str());
+      if(!expectedKey || !actualKey)
+      {
+        std::cerr << what << " is only in the " << (expectedKey ? "expected" : "actual") << " file\n";
+        ++nDifferent;
+        continue;
+      }
+      if(std::string(expectedKey->GetClassName()) != actualKey->GetClassName())
+      {
+        std::cerr << what << " is a " << expectedKey->GetClassName() << " versus a " << actualKey->GetClassName() << "\n";
+        ++nDifferent;
+        continue;
+      }
+
+      const auto type = TClass::GetClass(expectedKey->GetClassName());
+      if(!type) continue;
+      if(type->InheritsFrom(TDirectoryFile::Class()))
+      {
+        nDifferent += compareDirectories(*util::GetIngredient<TDirectoryFile>(expected, name), *util::GetIngredient<TDirectoryFile>(actual, name), what + "/");
+      }
+      else if(type->InheritsFrom(TTree::Class()) && endsWith(name, sparseSuffix))
+      {
+        nDifferent += compareSparseMigration(expected, actual, name, what);
+      }
+      else if(type->InheritsFrom(TH1::Class()))
+      {
+        std::unique_ptr<TH1> expectedHist(util::GetIngredient<TH1>(expected, name)), actualHist(util::GetIngredient<TH1>(actual, name));
+        if(auto mnv = dynamic_cast<PlotUtils::MnvH1D*>(expectedHist.get())) nDifferent += test::compareMnvHist(*mnv, dynamic_cast<PlotUtils::MnvH1D&>(*actualHist), what);
+        else if(auto mnv = dynamic_cast<PlotUtils::MnvH2D*>(expectedHist.get())) nDifferent += test::compareMnvHist(*mnv, dynamic_cast<PlotUtils::MnvH2D&>(*actualHist), what);
+        else nDifferent += test::compareHist(*expectedHist, *actualHist, what);
+      }
+      else if(type->InheritsFrom(TParameter<double>::Class()))
+      {
+        const double expectedValue = util::GetIngredient<TParameter<double>>(expected, name)->GetVal(),
+                     actualValue = util::GetIngredient<TParameter<double>>(actual, name)->GetVal();
+        if(std::fabs(expectedValue - actualValue) > 1e-9 * std::max(1., std::fabs(expectedValue)))
+        {
+          std::cerr << what << ": " << expectedValue << " versus " << actualValue << "\n";
+          ++nDifferent;
+        }
+      }
+    }
+    return nDifferent;
+  }
+}
+
+int main(const int argc, const char** argv)
+{
+#ifndef NCINTEX
+  ROOT::Cintex::Cintex::Enable(); // Needed to look up dictionaries for PlotUtils classes like MnvH1D
+#endif
+  TH1::AddDirectory(kFALSE);
+
+  if(argc != 3)
+  {
+    std::cerr << "Expected 2 files to compare, but got " << argc - 1 << ".\nUsage: CompareHistFiles <expected.root> <actual.root>\n";
+    return 2;
+  }
+
+  std::unique_ptr<TFile> expected(TFile::Open(argv[1], "READ")), actual(TFile::Open(argv[2], "READ"));
+  if(!expected || !actual)
+  {
+    std::cerr << "Failed to open " << (expected ? argv[2] : argv[1]) << "\n";
+    return 2;
+  }
+
+  int nDifferent = 0;
+  try
+  {
+    nDifferent = compareDirectories(*expected, *actual, "");
+  }
+  catch(const std::exception& e)
+  {
+    std::cerr << "Failed to compare " << argv[1] << " to " << argv[2] << ": " << e.what() << "\n";
+    return 2;
+  }
+
+  if(nDifferent > 0)
+  {
+    std::cerr << nDifferent << " differences between " << argv[1] << " and " << argv[2] << "\n";
+    return 1;
+  }
+  std::cout << argv[1] << " and " << argv[2] << " are the same\n";
+  return 0;
+}
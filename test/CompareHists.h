@@ -0,0 +1,91 @@
+//File: CompareHists.h
+//Brief: Bin by bin comparisons for the tests.  MnvH1Ds and MnvH2Ds are compared universe by universe in every
+//       vertical and lateral error band too.  Each function prints the bins that don't match and returns how many
+//       there were.
+
+#ifndef TEST_COMPAREHISTS_H
+#define TEST_COMPAREHISTS_H
+
+//PlotUtils includes
+#include "PlotUtils/MnvH1D.h"
+#include "PlotUtils/MnvH2D.h"
+
+//ROOT includes
+#include "TH1.h"
+
+//c++ includes
+#include <iostream>
+#include <string>
+#include <cmath>
+#include <algorithm>
+
+namespace test
+{
+  //Contents and errors of every bin, including under/overflow, have to agree to a fraction of tolerance
+  inline int compareHist(const TH1& expected, const TH1& actual, const std::string& what, const double tolerance = 1e-9)
+  {
+    if(expected.GetNcells() != actual.GetNcells())
+    {
+      std::cerr << what << ": " << expected.GetNcells() << " bins versus " << actual.GetNcells() << "\n";
+      return 1;
+    }
+
+    int nDifferent = 0;
+    for(int bin = 0; bin < expected.GetNcells(); ++bin)
+    {
+      const double scale = tolerance * std::max(1., std::fabs(expected.GetBinContent(bin)));
+      if(std::fabs(expected.GetBinContent(bin) - actual.GetBinContent(bin)) > scale
+         || std::fabs(expected.GetBinError(bin) - actual.GetBinError(bin)) > scale)
+      {
+        std::cerr << what << " bin " << bin << ": " << expected.GetBinContent(bin) << " +/- " << expected.GetBinError(bin)
+                  << " versus " << actual.GetBinContent(bin) << " +/- " << actual.GetBinError(bin) << "\n";
+        ++nDifferent;
+      }
+    }
+    return nDifferent;
+  }
+
+  //BANDS is a vector of std::string error band names.  EXPECTED and ACTUAL look up an error band by name.
+  template <class BANDS, class EXPECTED, class ACTUAL>
+  int compareBands(const BANDS& expectedNames, const BANDS& actualNames, EXPECTED&& expectedBand, ACTUAL&& actualBand, const std::string& what, const double tolerance)
+  {
+    if(expectedNames != actualNames)
+    {
+      std::cerr << what << " has different error bands\n";
+      return 1;
+    }
+
+    int nDifferent = 0;
+    for(const auto& name: expectedNames)
+    {
+      const auto expectedHists = expectedBand(name)->GetHists(), actualHists = actualBand(name)->GetHists();
+      if(expectedHists.size() != actualHists.size())
+      {
+        std::cerr << what << " " << name << " has " << expectedHists.size() << " universes versus " << actualHists.size() << "\n";
+        ++nDifferent;
+        continue;
+      }
+      for(size_t whichUniv = 0; whichUniv < expectedHists.size(); ++whichUniv)
+      {
+        nDifferent += compareHist(*expectedHists[whichUniv], *actualHists[whichUniv], what + " " + name + " universe " + std::to_string(whichUniv), tolerance);
+      }
+    }
+    return nDifferent;
+  }
+
+  //MNVHIST is a PlotUtils::MnvH1D or PlotUtils::MnvH2D
+  template <class MNVHIST>
+  int compareMnvHist(const MNVHIST& expected, const MNVHIST& actual, const std::string& what, const double tolerance = 1e-9)
+  {
+    int nDifferent = compareHist(expected, actual, what + " CV", tolerance);
+    nDifferent += compareBands(expected.GetVertErrorBandNames(), actual.GetVertErrorBandNames(),
+                               [&expected](const std::string& name) { return expected.GetVertErrorBand(name); },
+                               [&actual](const std::string& name) { return actual.GetVertErrorBand(name); }, what, tolerance);
+    nDifferent += compareBands(expected.GetLatErrorBandNames(), actual.GetLatErrorBandNames(),
+                               [&expected](const std::string& name) { return expected.GetLatErrorBand(name); },
+                               [&actual](const std::string& name) { return actual.GetLatErrorBand(name); }, what, tolerance);
+    return nDifferent;
+  }
+}
+
+#endif //TEST_COMPAREHISTS_H
@@ -0,0 +1,38 @@
+#!/bin/bash
+
+#Usage: ComparePreFilter.sh <runEventLoopTargets> <CompareHistFiles> [target code]
+#Runs runEventLoopTargets over the same playlists with and without --no-prefilter and makes sure that every histogram
+#in every output file is the same.  The playlists are PREFILTER_TEST_DATA and PREFILTER_TEST_MC.  Only every
+#PREFILTER_TEST_SAMPLE'th (default 20) cluster of entries is read to keep it short.  The target code defaults to 2026.
+#Exits with 77, which ctest counts as skipped, when the playlists aren't set.
+
+if [ -z "$PREFILTER_TEST_DATA" ] || [ -z "$PREFILTER_TEST_MC" ]; then
+  echo "Set PREFILTER_TEST_DATA and PREFILTER_TEST_MC to playlists to compare runs with and without the pre-filter."
+  exit 77
+fi
+
+EVENT_LOOP=$(readlink -f $1)
+COMPARE=$(readlink -f $2)
+TARGET=${3:-2026}
+DATA_PLAYLIST=$(readlink -f $PREFILTER_TEST_DATA)
+MC_PLAYLIST=$(readlink -f $PREFILTER_TEST_MC)
+
+#Both runs have to run the event loop with every systematic
+unset MNV_EVENTLOOP_CACHE MNV101_SKIP_SYST
+
+WORK_DIR=$(mktemp -d)
+mkdir $WORK_DIR/prefilter $WORK_DIR/noprefilter
+(cd $WORK_DIR/prefilter && $EVENT_LOOP $DATA_PLAYLIST $MC_PLAYLIST $TARGET --sample ${PREFILTER_TEST_SAMPLE:-20}) || exit 1
+(cd $WORK_DIR/noprefilter && $EVENT_LOOP $DATA_PLAYLIST $MC_PLAYLIST $TARGET --sample ${PREFILTER_TEST_SAMPLE:-20} --no-prefilter) || exit 1
+
+STATUS=0
+for FILE in $WORK_DIR/noprefilter/*.root; do
+  $COMPARE $FILE $WORK_DIR/prefilter/$(basename $FILE) || STATUS=1
+done
+
+if [ $STATUS -eq 0 ]; then
+  rm -r $WORK_DIR
+else
+  echo "Kept both runs' outputs in $WORK_DIR"
+fi
+exit $STATUS
@@ -0,0 +1,183 @@
+//File: TestSparseMigration.cpp
+//Brief: Fills the dense migration objects that the event loops used to write and a SparseMigration with the same
+//       entries, writes both to a file, and reads both back through util::GetMigration() and
+//       util::GetMigrationObjects().  Fails unless every bin content and error of the CV and of every universe is
+//       the same in both formats.  Entries go in the under/overflow bins too, and universes get different weights.
+//       One of the bands is lateral, so it has to come back as a lateral error band.
+//Usage: TestSparseMigration [output file]
+
+//util includes
+#include "util/SparseMigration.h"
+
+//test includes
+#include "test/CompareHists.h"
+
+//PlotUtils includes
+#include "PlotUtils/MnvH2D.h"
+#include "MinervaUnfold/MnvResponse.h"
+
+//ROOT includes
+#include "TH1D.h"
+#include "TH2D.h"
+#include "TFile.h"
+
+#ifndef NCINTEX
+#include "Cintex/Cintex.h"
+#endif
+
+//c++ includes
+#include <iostream>
+#include <random>
+#include <memory>
+#include <string>
+#include <vector>
+#include <map>
+
+namespace
+{
+  //All SparseMigration needs from a universe
+  struct FakeUniverse
+  {
+    std::string name;
+    bool vertical;
+    std::string ShortName() const { return name; }
+    bool IsVerticalOnly() const { return vertical; }
+  };
+
+  const std::vector<double> binsX = {0, 1, 2, 4, 7}, binsY = {0, 0.5, 1.5, 3};
+
+  std::map<std::string, std::vector<FakeUniverse*>> makeBands(std::vector<std::unique_ptr<FakeUniverse>>& universes)
+  {
+    std::map<std::string, std::vector<FakeUniverse*>> bands;
+    for(const auto& band: std::map<std::string, int>{{"cv", 1}, {"Flux", 3}, {"GENIE_MaCCQE", 2}, {"Muon_Energy_MINOS", 2}})
+    {
+      for(int whichUniv = 0; whichUniv < band.second; ++whichUniv)
+      {
+        universes.emplace_back(new FakeUniverse{band.first, band.first != "Muon_Energy_MINOS"});
+        bands[band.first].push_back(universes.back().get());
+      }
+    }
+    return bands;
+  }
+}
+
+int main(const int argc, const char** argv)
+{
+#ifndef NCINTEX
+  ROOT::Cintex::Cintex::Enable(); // Needed to look up dictionaries for PlotUtils classes like MnvH1D
+#endif
+  TH1::AddDirectory(kFALSE);
+
+  const std::string fileName = (argc > 1) ? argv[1] : "TestSparseMigration.root";
+  std::vector<std::unique_ptr<FakeUniverse>> universes;
+  const auto bands = makeBands(universes);
+
+  std::mt19937 generator(34);
+  std::uniform_real_distribution<double> valueX(-1, 8), valueY(-0.5, 3.5), weight(0.2, 1.8);
+
+  //1D variable: a dense MnvH2D like Hist2DWrapper made and a SparseMigration
+  TH1D binning1D("pTmu", "pTmu", binsX.size() - 1, binsX.data());
+  util::SparseMigration sparse1D("pTmu_migration", binning1D, binning1D, bands);
+  PlotUtils::MnvH2D dense1D("pTmu_migration", "pTmu", binsX.size() - 1, binsX.data(), binsX.size() - 1, binsX.data());
+  dense1D.Sumw2();
+  for(const auto& band: bands)
+  {
+    if(band.first == "cv") continue;
+    if(band.second.front()->IsVerticalOnly()) dense1D.AddVertErrorBand(band.first, band.second.size());
+    else dense1D.AddLatErrorBand(band.first, band.second.size());
+  }
+
+  //2D variable: the MnvResponse that the event loops used to fill and a SparseMigration.  The lateral bands are added
+  //to its migration objects afterwards.
+  std::map<const std::string, int> response_bands;
+  for(const auto& band: bands)
+  {
+    if(band.second.front()->IsVerticalOnly()) response_bands[band.second.front()->ShortName()] = band.second.size();
+  }
+  TH2D binning2D("pTmu_pZmu", "pTmu_pZmu", binsX.size() - 1, binsX.data(), binsY.size() - 1, binsY.data());
+  util::SparseMigration sparse2D("pTmu_pZmu_migration", binning2D, binning2D, bands);
+  MinervaUnfold::MnvResponse dense2D("pTmu_pZmu", "pTmu_pZmu", binsX, binsY, response_bands);
+
+  for(int entry = 0; entry < 2000; ++entry)
+  {
+    const double recoX = valueX(generator), truthX = recoX + valueX(generator) / 4., recoY = valueY(generator), truthY = recoY + valueY(generator) / 4.;
+    for(const auto& band: bands)
+    {
+      for(size_t whichUniv = 0; whichUniv < band.second.size(); ++whichUniv)
+      {
+        const double univWeight = weight(generator);
+        const bool vertical = band.second[whichUniv]->IsVerticalOnly();
+        const double univRecoX = vertical ? recoX : recoX + 0.3 * (whichUniv + 1); //Lateral universes move events between bins
+        sparse1D.FillUniverse(band.second[whichUniv], univRecoX, truthX, univWeight);
+        if(band.first == "cv") dense1D.Fill(recoX, truthX, univWeight);
+        else if(vertical) dense1D.GetVertErrorBand(band.first)->GetHist(whichUniv)->Fill(recoX, truthX, univWeight);
+        else dense1D.GetLatErrorBand(band.first)->GetHist(whichUniv)->Fill(univRecoX, truthX, univWeight);
+
+        //Like the event loops, every universe fills the 2D response's CV
+        sparse2D.Fill(recoX, recoY, truthX, truthY, univWeight);
+        dense2D.Fill(recoX, recoY, truthX, truthY, univWeight);
+      }
+    }
+  }
+
+  PlotUtils::MnvH2D *migration = nullptr, *reco = nullptr, *truth = nullptr;
+  dense2D.GetMigrationObjects(migration, reco, truth);
+  std::unique_ptr<PlotUtils::MnvH2D> denseMigration(migration), denseReco(reco), denseTruth(truth);
+  for(const auto& band: bands)
+  {
+    if(band.second.front()->IsVerticalOnly()) continue;
+    for(auto hist: {migration, reco, truth})
+    {
+      hist->AddLatErrorBand(band.first, band.second.size());
+      for(size_t whichUniv = 0; whichUniv < band.second.size(); ++whichUniv) hist->GetLatErrorBand(band.first)->GetHist(whichUniv)->Reset();
+    }
+  }
+
+  {
+    std::unique_ptr<TFile> dense(TFile::Open(("dense_" + fileName).c_str(), "RECREATE")), sparse(TFile::Open(("sparse_" + fileName).c_str(), "RECREATE"));
+    if(!dense || !sparse)
+    {
+      std::cerr << "Failed to create the test files for " << fileName << "\n";
+      return 4;
+    }
+    dense->cd();
+    dense1D.Write();
+    denseMigration->Write();
+    denseReco->Write();
+    denseTruth->Write();
+    sparse1D.Write(*sparse);
+    sparse2D.Write(*sparse);
+  }
+
+  std::unique_ptr<TFile> dense(TFile::Open(("dense_" + fileName).c_str(), "READ")), sparse(TFile::Open(("sparse_" + fileName).c_str(), "READ"));
+  int nFailures = 0;
+  try
+  {
+    std::unique_ptr<PlotUtils::MnvH2D> dense1DRead(util::GetMigration(*dense, "pTmu_migration")), sparse1DRead(util::GetMigration(*sparse, "pTmu_migration"));
+    nFailures += test::compareMnvHist(*dense1DRead, *sparse1DRead, "1D migration");
+
+    PlotUtils::MnvH2D *sparseMigration = nullptr, *sparseReco = nullptr, *sparseTruth = nullptr;
+    util::GetMigrationObjects(*dense, "pTmu_pZmu", migration, reco, truth);
+    util::GetMigrationObjects(*sparse, "pTmu_pZmu", sparseMigration, sparseReco, sparseTruth);
+    denseMigration.reset(migration);
+    denseReco.reset(reco);
+    denseTruth.reset(truth);
+    std::unique_ptr<PlotUtils::MnvH2D> ownSparseMigration(sparseMigration), ownSparseReco(sparseReco), ownSparseTruth(sparseTruth);
+    nFailures += test::compareMnvHist(*migration, *sparseMigration, "2D migration");
+    nFailures += test::compareMnvHist(*reco, *sparseReco, "2D reco");
+    nFailures += test::compareMnvHist(*truth, *sparseTruth, "2D truth");
+  }
+  catch(const std::runtime_error& e)
+  {
+    std::cerr << "Failed to read back the migrations: " << e.what() << "\n";
+    return 3;
+  }
+
+  if(nFailures > 0)
+  {
+    std::cerr << nFailures << " bins are different between the dense and sparse migrations\n";
+    return 1;
+  }
+  std::cout << "Dense and sparse migrations are the same\n";
+  return 0;
+}
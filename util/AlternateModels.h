@@ -0,0 +1,373 @@
+//File: AlternateModels.h
+//Brief: The MINERvA tune and warps that an event loop reweights its MC with, as a list of named Reweighter
+//       components, and AlternateModels to fill CV-only histograms with other tunes and warps in the same event loop.
+//       The nominal model comes from the MnvTune environment variable and the NO_2P2H_WARP, AMU_DIS_WARP,
+//       LOW_Q2_PION_WARP, and SUSA_2P2H_WARP switches.  An alternate model is <name>=<tune>[,<warp>...] like
+//       SuSA=431,SUSA_2P2H_WARP.  Each component that several alternate models share is only evaluated once per entry.
+
+#ifndef UTIL_ALTERNATEMODELS_H
+#define UTIL_ALTERNATEMODELS_H
+
+//Includes from this package
+#include "event/CVUniverse.h"
+#include "event/MichelEvent.h"
+
+//util includes
+#include "util/COHPionReweighter.h"
+#include "util/DiffractiveReweighter.h"
+
+//PlotUtils includes
+#include "PlotUtils/VariableBase.h"
+#include "PlotUtils/Reweighter.h"
+#include "PlotUtils/FluxAndCVReweighter.h"
+#include "PlotUtils/GENIEReweighter.h"
+#include "PlotUtils/LowRecoil2p2hReweighter.h"
+#include "PlotUtils/RPAReweighter.h"
+#include "PlotUtils/MINOSEfficiencyReweighter.h"
+#include "PlotUtils/LowQ2PiReweighter.h"
+#include "PlotUtils/AMUDISReweighter.h"
+#include "PlotUtils/SuSAFromValencia2p2hReweighter.h"
+#include "PlotUtils/FSIReweighter.h"
+#include "PlotUtils/BodekRitchieReweighter.h"
+
+//ROOT includes
+#include "TH1D.h"
+#include "TH2D.h"
+#include "TNamed.h"
+#include "TDirectory.h"
+
+//c++ includes
+#include <vector>
+#include <string>
+#include <set>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <cctype>
+#include <cstdlib>
+#include <iostream>
+#include <algorithm>
+#include <stdexcept>
+
+namespace util
+{
+  const std::vector<std::string> warpNames = {"NO_2P2H_WARP", "AMU_DIS_WARP", "LOW_Q2_PION_WARP", "SUSA_2P2H_WARP"};
+
+  struct ModelConfig
+  {
+    std::string name;
+    int tuneA = 1, tuneB = 0, tuneC = 0; //Tune version vA.B.C
+    std::set<std::string> warps;
+
+    //Tune versions look like 431.  Returns false for anything else.
+    bool SetTune(const std::string& tune)
+    {
+      if(tune.size() != 3 || !std::all_of(tune.begin(), tune.end(), [](const char digit) { return std::isdigit(digit); })) return false;
+      tuneA = tune[0] - '0';
+      tuneB = tune[1] - '0';
+      tuneC = tune[2] - '0';
+      return true;
+    }
+
+    std::string TuneName() const
+    {
+      return "v" + std::to_string(tuneA) + "." + std::to_string(tuneB) + "." + std::to_string(tuneC);
+    }
+
+    //The model an event loop has always used
+    static ModelConfig FromEnvironment()
+    {
+      ModelConfig model;
+      model.name = "nominal";
+      const char* tune = getenv("MnvTune");
+      if(tune != nullptr && !model.SetTune(tune)) std::cout << "Unrecognised tune " << tune << ", using default\n";
+      for(const auto& warp: warpNames)
+      {
+        if(getenv(warp.c_str()) != nullptr) model.warps.insert(warp);
+      }
+      return model;
+    }
+
+    //From a command line argument like SuSA=431,SUSA_2P2H_WARP
+    static ModelConfig Parse(const std::string& arg)
+    {
+      const auto equals = arg.find('=');
+      ModelConfig model;
+      model.name = arg.substr(0, equals);
+      if(equals == std::string::npos || model.name.empty() || !std::all_of(model.name.begin(), model.name.end(), [](const char letter) { return std::isalnum(letter) || letter == '_'; }))
+        throw std::runtime_error("Can't make a model from \"" + arg + "\".  Expected <name>=<tune>[,<warp>...] where <name> is only letters, numbers, and _s");
+
+      std::stringstream parts(arg.substr(equals + 1));
+      std::string tune;
+      std::getline(parts, tune, ',');
+      if(!model.SetTune(tune)) throw std::runtime_error("Model " + model.name + " has an unrecognised tune: \"" + tune + "\".  Expected something like 431.");
+      for(std::string warp; std::getline(parts, warp, ',');)
+      {
+        if(std::find(warpNames.begin(), warpNames.end(), warp) == warpNames.end()) throw std::runtime_error("Model " + model.name + " has an unknown warp: " + warp);
+        model.warps.insert(warp);
+      }
+      return model;
+    }
+
+    //Names of the Reweighters in this model for MakeReweighter()
+    std::vector<std::string> Components() const
+    {
+      std::vector<std::string> components;
+      //Setting the A component of mnvtune vA.B.C
+      if(tuneA == 1) components = {"FluxAndCV", "GENIE", "MINOSEfficiency", "RPA", "LowRecoil2p2h"};
+      if(tuneA == 2) components = {"FluxAndCV", "GENIE", "MINOSEfficiency", "RPA", "LowRecoil2p2h", "LowQ2Pi_JOINT"}; //Is JOINT the correct option for mnvtune2?
+      if(tuneA == 3) components = {"FluxAndCV", "GENIE", "MINOSEfficiency", "RPA", "SuSA2p2h", "BodekRitchie"}; //Is 2 the right mode for BodekRitchie?
+      if(tuneA == 4) components = {"FluxAndCV", "GENIEDeuteriumPionTune", "MINOSEfficiency", "RPA", "LowRecoil2p2h"}; //Other decisions to add for MnvTunev4.3.1
+      //Setting the B component of mnvtune vA.B.C
+      if(tuneB == 3) components.insert(components.end(), {"LowQ2Pi_MENU1PI", "Diffractive", "COHPion"});
+      //Setting the C component of mnvtune vA.B.C
+      if(tuneC == 1) components.push_back("FSI");
+
+      //Warps
+      const auto lowRecoil2p2h = std::find(components.begin(), components.end(), "LowRecoil2p2h");
+      if(warps.count("SUSA_2P2H_WARP")) //Replacing LowRecoil2p2hReweighter with SuSAFromValencia2p2hReweighter
+      {
+        if(lowRecoil2p2h != components.end()) *lowRecoil2p2h = "SuSA2p2h";
+        else if(std::find(components.begin(), components.end(), "SuSA2p2h") == components.end())
+        {
+          std::cout << "WARNING - SUSA_2P2H_WARP - no LowRecoil2p2hTune found to replace in " << name << ", applying SuSAFromValencia2p2hReweighter anyway\n";
+          components.push_back("SuSA2p2h");
+        }
+        else std::cout << "WARNING - SUSA_2P2H_WARP - no LowRecoil2p2hTune found to replace in " << name << " and SuSA2p2h already set, so I'm doing nothing\n";
+      }
+      if(warps.count("NO_2P2H_WARP")) //Removing LowRecoil2p2hReweighter
+      {
+        const auto found = std::find(components.begin(), components.end(), "LowRecoil2p2h");
+        if(found != components.end()) components.erase(found);
+        else std::cout << "Warning - NO_2P2H_WARP - Could not apply warp to " << name << " since there were no 2p2h reweighters found\n";
+      }
+      if(warps.count("AMU_DIS_WARP")) components.push_back("AMUDIS");
+      if(warps.count("LOW_Q2_PION_WARP")) components.push_back("LowQ2Pi_JOINT"); //Low Q2 pion suppression (mnvtunev2)
+      return components;
+    }
+  };
+
+  //Every component that MakeReweighter() knows about
+  const std::vector<std::string> reweighterComponents = {"FluxAndCV", "GENIE", "GENIEDeuteriumPionTune", "MINOSEfficiency", "RPA", "LowRecoil2p2h", "SuSA2p2h",
+                                                         "BodekRitchie", "LowQ2Pi_JOINT", "LowQ2Pi_MENU1PI", "Diffractive", "COHPion", "FSI", "AMUDIS"};
+
+  inline std::unique_ptr<PlotUtils::Reweighter<CVUniverse, MichelEvent>> MakeReweighter(const std::string& component)
+  {
+    using Reweighter = PlotUtils::Reweighter<CVUniverse, MichelEvent>;
+    if(component == "FluxAndCV") return std::unique_ptr<Reweighter>(new PlotUtils::FluxAndCVReweighter<CVUniverse, MichelEvent>());
+    if(component == "GENIE") return std::unique_ptr<Reweighter>(new PlotUtils::GENIEReweighter<CVUniverse, MichelEvent>(true, false));
+    if(component == "GENIEDeuteriumPionTune") return std::unique_ptr<Reweighter>(new PlotUtils::GENIEReweighter<CVUniverse, MichelEvent>(true, true));
+    if(component == "MINOSEfficiency") return std::unique_ptr<Reweighter>(new PlotUtils::MINOSEfficiencyReweighter<CVUniverse, MichelEvent>());
+    if(component == "RPA") return std::unique_ptr<Reweighter>(new PlotUtils::RPAReweighter<CVUniverse, MichelEvent>());
+    if(component == "LowRecoil2p2h") return std::unique_ptr<Reweighter>(new PlotUtils::LowRecoil2p2hReweighter<CVUniverse, MichelEvent>());
+    if(component == "SuSA2p2h") return std::unique_ptr<Reweighter>(new PlotUtils::SuSAFromValencia2p2hReweighter<CVUniverse, MichelEvent>());
+    if(component == "BodekRitchie") return std::unique_ptr<Reweighter>(new PlotUtils::BodekRitchieReweighter<CVUniverse, MichelEvent>(2));
+    if(component == "LowQ2Pi_JOINT") return std::unique_ptr<Reweighter>(new PlotUtils::LowQ2PiReweighter<CVUniverse, MichelEvent>("JOINT"));
+    if(component == "LowQ2Pi_MENU1PI") return std::unique_ptr<Reweighter>(new PlotUtils::LowQ2PiReweighter<CVUniverse, MichelEvent>("MENU1PI"));
+    if(component == "Diffractive") return std::unique_ptr<Reweighter>(new PlotUtils::DiffractiveReweighter<CVUniverse, MichelEvent>());
+    if(component == "COHPion") return std::unique_ptr<Reweighter>(new PlotUtils::COHPionReweighter<CVUniverse, MichelEvent>());
+    if(component == "FSI") return std::unique_ptr<Reweighter>(new PlotUtils::FSIReweighter<CVUniverse, MichelEvent>(true, true));
+    if(component == "AMUDIS") return std::unique_ptr<Reweighter>(new PlotUtils::AMUDISReweighter<CVUniverse, MichelEvent>());
+    throw std::runtime_error("No Reweighter called " + component);
+  }
+
+  //CV weights for several models at once.  Only for the CV universe.
+  class AlternateModels
+  {
+    public:
+      AlternateModels(const std::vector<ModelConfig>& models)
+      {
+        std::map<std::string, size_t> componentIndices;
+        for(const auto& model: models)
+        {
+          fNames.push_back(model.name);
+          fModelComponents.emplace_back();
+          std::string description = "MnvTune " + model.TuneName() + " with";
+          for(const auto& component: model.Components())
+          {
+            auto found = componentIndices.find(component);
+            if(found == componentIndices.end())
+            {
+              found = componentIndices.emplace(component, fReweighters.size()).first;
+              fReweighters.push_back(MakeReweighter(component));
+            }
+            fModelComponents.back().push_back(found->second);
+            description += " " + component;
+          }
+          fDescriptions.push_back(description);
+        }
+        fComponentWeights.resize(fReweighters.size());
+        fWeights.resize(models.size());
+      }
+
+      const std::vector<std::string>& Names() const { return fNames; }
+      const std::vector<std::string>& Descriptions() const { return fDescriptions; }
+      size_t NComponents() const { return fReweighters.size(); }
+
+      //Call for every entry before Weights()
+      void SetEntry()
+      {
+        fWeightsAreSet = false;
+      }
+
+      //Each model's weight for the CV universe at this entry.  Calculated at most once per entry.
+      const std::vector<double>& Weights(const CVUniverse& cvUniv, const MichelEvent& evt)
+      {
+        if(fWeightsAreSet) return fWeights;
+
+        for(size_t whichComponent = 0; whichComponent < fReweighters.size(); ++whichComponent)
+          fComponentWeights[whichComponent] = fReweighters[whichComponent]->GetWeight(cvUniv, evt);
+        for(size_t whichModel = 0; whichModel < fModelComponents.size(); ++whichModel)
+        {
+          fWeights[whichModel] = 1;
+          for(auto component: fModelComponents[whichModel]) fWeights[whichModel] *= fComponentWeights[component];
+        }
+        fWeightsAreSet = true;
+        return fWeights;
+      }
+
+    private:
+      std::vector<std::string> fNames;
+      std::vector<std::string> fDescriptions;
+      std::vector<std::unique_ptr<PlotUtils::Reweighter<CVUniverse, MichelEvent>>> fReweighters; //Shared between models
+      std::vector<std::vector<size_t>> fModelComponents; //Indices in fReweighters for each model
+
+      std::vector<double> fComponentWeights;
+      std::vector<double> fWeights;
+      bool fWeightsAreSet = false;
+  };
+
+  //CV histograms of some Variables for each of the AlternateModels, named like <model>_<variable>_selected_mc_reco
+  class AlternateModelHists
+  {
+    public:
+      using Variable = PlotUtils::VariableBase<CVUniverse>;
+
+      //vars have to outlive the AlternateModelHists
+      AlternateModelHists(const AlternateModels& models, const std::vector<const Variable*>& vars): fVars(vars)
+      {
+        std::vector<std::string> varNames, axisLabels;
+        std::vector<std::vector<double>> bins;
+        for(auto var: fVars)
+        {
+          varNames.push_back(var->GetName());
+          axisLabels.push_back(var->GetAxisLabel());
+          bins.push_back(var->GetBinVec());
+        }
+        MakeHists(models.Names(), models.Descriptions(), varNames, axisLabels, bins);
+      }
+
+      //For values that were already calculated, like in a ReweightTree
+      AlternateModelHists(const std::vector<std::string>& models, const std::vector<std::string>& descriptions, const std::vector<std::string>& varNames,
+                          const std::vector<std::vector<double>>& bins)
+      {
+        MakeHists(models, descriptions, varNames, varNames, bins);
+      }
+
+      //weights are from AlternateModels::Weights()
+      void FillSelected(const CVUniverse& cvUniv, const std::vector<double>& weights, const bool isSignal)
+      {
+        for(size_t whichVar = 0; whichVar < fVars.size(); ++whichVar)
+        {
+          fReco[whichVar] = fVars[whichVar]->GetRecoValue(cvUniv);
+          fTruth[whichVar] = isSignal ? fVars[whichVar]->GetTrueValue(cvUniv) : 0;
+        }
+        FillSelected(fReco, fTruth, weights, isSignal);
+      }
+
+      //sampleWeight corrects for sampling the Truth tree like the nominal efficiency denominator
+      void FillEffDenom(const CVUniverse& cvUniv, const std::vector<double>& weights, const double sampleWeight = 1)
+      {
+        for(size_t whichVar = 0; whichVar < fVars.size(); ++whichVar) fTruth[whichVar] = fVars[whichVar]->GetTrueValue(cvUniv);
+        FillEffDenom(fTruth, weights, sampleWeight);
+      }
+
+      //One reco and true value for each Variable.  truth is only used for signal.
+      void FillSelected(const std::vector<double>& reco, const std::vector<double>& truth, const std::vector<double>& weights, const bool isSignal)
+      {
+        for(size_t whichModel = 0; whichModel < fHists.size(); ++whichModel)
+        {
+          for(size_t whichVar = 0; whichVar < reco.size(); ++whichVar)
+          {
+            auto& hists = fHists[whichModel][whichVar];
+            hists.selected->Fill(reco[whichVar], weights[whichModel]);
+            if(!isSignal) continue;
+            hists.selectedSignal->Fill(reco[whichVar], weights[whichModel]);
+            hists.efficiencyNumerator->Fill(truth[whichVar], weights[whichModel]);
+            hists.migration->Fill(reco[whichVar], truth[whichVar], weights[whichModel]);
+          }
+        }
+      }
+
+      void FillEffDenom(const std::vector<double>& truth, const std::vector<double>& weights, const double sampleWeight = 1)
+      {
+        for(size_t whichModel = 0; whichModel < fHists.size(); ++whichModel)
+        {
+          for(size_t whichVar = 0; whichVar < truth.size(); ++whichVar)
+            fHists[whichModel][whichVar].efficiencyDenominator->Fill(truth[whichVar], sampleWeight * weights[whichModel]);
+        }
+      }
+
+      void Write(TDirectory& dir)
+      {
+        dir.cd();
+        for(size_t whichModel = 0; whichModel < fHists.size(); ++whichModel)
+        {
+          TNamed((fModelNames[whichModel] + "_model").c_str(), fDescriptions[whichModel].c_str()).Write();
+          for(auto& hists: fHists[whichModel])
+          {
+            hists.selected->Write();
+            hists.selectedSignal->Write();
+            hists.efficiencyNumerator->Write();
+            hists.efficiencyDenominator->Write();
+            hists.migration->Write();
+          }
+        }
+      }
+
+    private:
+      struct Hists
+      {
+        std::unique_ptr<TH1D> selected, selectedSignal, efficiencyNumerator, efficiencyDenominator;
+        std::unique_ptr<TH2D> migration;
+      };
+
+      std::vector<const Variable*> fVars; //Empty if the values are already calculated
+      std::vector<std::string> fModelNames;
+      std::vector<std::string> fDescriptions;
+      std::vector<std::vector<Hists>> fHists; //By model, then Variable
+
+      //Per-event scratch space
+      std::vector<double> fReco, fTruth;
+
+      void MakeHists(const std::vector<std::string>& models, const std::vector<std::string>& descriptions, const std::vector<std::string>& varNames,
+                     const std::vector<std::string>& axisLabels, const std::vector<std::vector<double>>& bins)
+      {
+        fModelNames = models;
+        fDescriptions = descriptions;
+        fReco.resize(varNames.size());
+        fTruth.resize(varNames.size());
+        for(const auto& model: models)
+        {
+          fHists.emplace_back();
+          for(size_t whichVar = 0; whichVar < varNames.size(); ++whichVar)
+          {
+            const std::string prefix = model + "_" + varNames[whichVar];
+            const std::string title = varNames[whichVar] + " in model " + model;
+            const auto& edges = bins[whichVar];
+            auto make1D = [&](const std::string& suffix)
+            {
+              std::unique_ptr<TH1D> hist(new TH1D((prefix + suffix).c_str(), (title + ";" + axisLabels[whichVar]).c_str(), edges.size() - 1, edges.data()));
+              hist->SetDirectory(nullptr);
+              return hist;
+            };
+            fHists.back().push_back(Hists{make1D("_selected_mc_reco"), make1D("_selected_signal_reco"), make1D("_efficiency_numerator"), make1D("_efficiency_denominator"),
+                                          std::unique_ptr<TH2D>(new TH2D((prefix + "_migration").c_str(), (title + ";reco;truth").c_str(), edges.size() - 1, edges.data(), edges.size() - 1, edges.data()))});
+            fHists.back().back().migration->SetDirectory(nullptr);
+          }
+        }
+      }
+  };
+}
+
+#endif //UTIL_ALTERNATEMODELS_H
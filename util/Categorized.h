@@ -4,6 +4,8 @@
 //       which NamedCategory<> a value belongs to.  Useful for putting together
 //       stacked histograms that compare different "channels" with how they
 //       contribute to the total histogram for a value.
+//       Small ranges of integer CATEGORYs, like background and interaction
+//       channel labels, are looked up in an array instead of being hashed.
 //Author: Andrew Olivier aolivier@ur.rochester.edu
 
 #ifndef UTIL_CATEGORIZED_CPP
@@ -17,8 +19,11 @@
 #include <vector>
 #ifndef __CINT__
 #include <unordered_map>
+#include <type_traits>
+#include <algorithm>
 #endif //__CINT__
 #include <set>
+#include <map>
 
 namespace util
 {
@@ -30,6 +35,31 @@ namespace util
     std::string name;
   };
 
+  #ifndef __CINT__ //Hide "std::enable_if<>" c++11 feature from CINT
+  namespace detail
+  {
+    //Integer categories that span fewer values than this are looked up in an array
+    const long long maxDenseCategories = 256;
+
+    //Converts integral and enum CATEGORYs to an array index.  Everything else has to be hashed.
+    template <class CATEGORY, class = void>
+    struct denseIndex
+    {
+      static bool get(const CATEGORY& /*cat*/, long long& /*index*/) { return false; }
+    };
+
+    template <class CATEGORY>
+    struct denseIndex<CATEGORY, typename std::enable_if<std::is_integral<CATEGORY>::value || std::is_enum<CATEGORY>::value>::type>
+    {
+      static bool get(const CATEGORY& cat, long long& index)
+      {
+        index = static_cast<long long>(cat);
+        return true;
+      }
+    };
+  }
+  #endif //__CINT__
+
   //A Categorized holds a total HIST along with a HIST for each category.
   //It works similarly to a Binned<>, but each entry either exactly matches
   //one CATEGORY or is put in the Other CATEGORY.
@@ -57,6 +87,7 @@ namespace util
         }
 
         fOther = new HIST((baseName + "_Other").c_str(), ("Other;" + axes).c_str(), args...);
+        BuildDenseIndex();
       }
 
       //CATEGORY is a pointer to an object with a name() member variable
@@ -70,6 +101,7 @@ namespace util
         }
 
         fOther = new HIST((baseName + "_Other"), ("Other;" + axes).c_str(), args...);
+        BuildDenseIndex();
       }
 
       //CATEGORY is a pointer to an object with a name() member variable
@@ -83,6 +115,7 @@ namespace util
         }
 
         fOther = new HIST((baseName + "_Other"), ("Other;" + axes).c_str(), args...);
+        BuildDenseIndex();
       }
 
       //Use a std::map<> instead of CATEGORIES
@@ -97,11 +130,22 @@ namespace util
         }
 
         fOther = new HIST((baseName + "_Other").c_str(), ("Other;" + axes).c_str(), args...);
+        BuildDenseIndex();
       }
       #endif //__CINT__
 
       HIST& operator [](const CATEGORY& cat) const
       {
+        #ifndef __CINT__
+        long long index;
+        if(!fDense.empty() && detail::denseIndex<CATEGORY>::get(cat, index))
+        {
+          index -= fDenseMin;
+          if(index < 0 || index >= static_cast<long long>(fDense.size())) return *fOther;
+          return *fDense[index];
+        }
+        #endif //__CINT__
+
         //Find out whether category is kept track of separately
         const auto found = fCatToHist.find(cat);
         if(found == fCatToHist.end()) return *fOther; //If not, lump this entry in with other uncategorized entries
@@ -130,6 +174,22 @@ namespace util
         #endif //__CINT__
       }
 
+      //Delete each HIST this object manages exactly once.  Only for HISTs that no TFile is responsible for,
+      //like the HistWrappers around histograms that were written to a file that has since been Close()d.
+      void deleteHists()
+      {
+        #ifndef __CINT__ //Hide "auto" c++11 feature from CINT
+        std::set<HIST*> toDelete;
+        for(auto& category: fCatToHist) toDelete.insert(category.second);
+        toDelete.insert(fOther);
+        for(auto hist: toDelete) delete hist;
+
+        fCatToHist.clear();
+        fDense.clear();
+        fOther = nullptr;
+        #endif //__CINT__
+      }
+
       //TODO: I think this is needed for nested Categorized<Categorized<HistWrapper<>, >, > because
       //      HistWrapper calls SetDirectory(0) on its MnvH1D.
       /*void SetDirectory(TDirectory* dir)
@@ -144,6 +204,35 @@ namespace util
       std::unordered_map<CATEGORY, HIST*> fCatToHist;
       #endif //__CINT__
       HIST* fOther; //All entries that don't fit in any other CATEGORY end up in this HIST
+
+      //fCatToHist as an array from fDenseMin with fOther in the gaps.  Empty when CATEGORY isn't an integer or the
+      //categories are spread out too far, like target codes.
+      std::vector<HIST*> fDense;
+      long long fDenseMin = 0;
+
+      #ifndef __CINT__
+      void BuildDenseIndex()
+      {
+        long long min = 0, max = 0, index;
+        bool first = true;
+        for(const auto& category: fCatToHist)
+        {
+          if(!detail::denseIndex<CATEGORY>::get(category.first, index)) return;
+          min = first ? index : std::min(min, index);
+          max = first ? index : std::max(max, index);
+          first = false;
+        }
+        if(first || max - min >= detail::maxDenseCategories) return;
+
+        fDenseMin = min;
+        fDense.assign(max - min + 1, fOther);
+        for(const auto& category: fCatToHist)
+        {
+          detail::denseIndex<CATEGORY>::get(category.first, index);
+          fDense[index - min] = category.second;
+        }
+      }
+      #endif //__CINT__
   };
 }
 
@@ -0,0 +1,257 @@
+//File: DeltaHistWrapper.h
+//Brief: Fills an MnvH1D or MnvH2D for each systematic universe like a PlotUtils::HistWrapper or Hist2DWrapper,
+//       but only keeps each universe's difference from the CV, as floats, until SyncCVHistos() is called.
+//       Most universes only move each bin by a few percent, so float round-off on the residuals is orders of
+//       magnitude below the statistical precision of any bin, while a universe takes half the memory of the
+//       TH1D/TH2D an MnvVertErrorBand would hold.  That adds up for big 2D variables like pTmu_pZmu with
+//       hundreds of universes.
+//       SyncCVHistos() expands the residuals into ordinary vertical error bands.  Bin contents and errors come
+//       out the same as a HistWrapper's to float precision on the difference from the CV.  After that, it fills
+//       the MnvH1D/MnvH2D directly just like a HistWrapper.
+//       Lateral universes move events between bins, so they aren't close to the CV bin by bin.  Their bands are
+//       lateral error bands from the start, and they're filled directly like a HistWrapper or Hist2DWrapper would.
+//       Filling the CV moves every universe's residual.  Instead of going through every universe each time, each
+//       cell saves up its CV fills and subtracts them from the universes once every cvFlushFills fills, and the rest
+//       in SyncCVHistos().  That's often enough that the residuals never grow big enough to lose float precision.
+
+#ifndef UTIL_DELTAHISTWRAPPER_H
+#define UTIL_DELTAHISTWRAPPER_H
+
+//c++ includes
+#include <string>
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace util
+{
+  //MNVHIST is a PlotUtils::MnvH1D or PlotUtils::MnvH2D.  The 1D constructor and FillUniverse() only work with an
+  //MnvH1D, and the 2D ones only work with an MnvH2D.
+  template <class MNVHIST, class UNIVERSE>
+  class DeltaHistWrapper
+  {
+    public:
+      //Same arguments as HistWrapper<>
+      DeltaHistWrapper(const char* name, const char* title, const std::vector<double>& bins,
+                       const std::map<std::string, std::vector<UNIVERSE*>>& error_bands): hist(new MNVHIST(name, title, bins.size() - 1, bins.data()))
+      {
+        init(error_bands);
+      }
+
+      //For data, where all universes are the CV
+      DeltaHistWrapper(const char* name, const char* title, const std::vector<double>& bins,
+                       const std::vector<UNIVERSE*>& univs): DeltaHistWrapper(name, title, bins, std::map<std::string, std::vector<UNIVERSE*>>{{"cv", univs}})
+      {
+      }
+
+      //Same arguments as Hist2DWrapper<>
+      DeltaHistWrapper(const char* name, const char* title, const std::vector<double>& binsX, const std::vector<double>& binsY,
+                       const std::map<std::string, std::vector<UNIVERSE*>>& error_bands): hist(new MNVHIST(name, title, binsX.size() - 1, binsX.data(),
+                                                                                                             binsY.size() - 1, binsY.data()))
+      {
+        init(error_bands);
+      }
+
+      DeltaHistWrapper(const char* name, const char* title, const std::vector<double>& binsX, const std::vector<double>& binsY,
+                       const std::vector<UNIVERSE*>& univs): DeltaHistWrapper(name, title, binsX, binsY, std::map<std::string, std::vector<UNIVERSE*>>{{"cv", univs}})
+      {
+      }
+
+      void FillUniverse(const UNIVERSE* univ, const double x, const double weight)
+      {
+        const auto found = fUniverseIndex.find(univ);
+        if(found == fUniverseIndex.end())
+        {
+          fLateralHists.at(univ)->Fill(x, weight);
+          return;
+        }
+
+        const int whichUniv = found->second;
+        if(whichUniv == CV)
+        {
+          hist->Fill(x, weight);
+          if(!fExpanded) addToCV(hist->FindBin(x), weight);
+        }
+        else if(fExpanded) fUniverseHists[whichUniv]->Fill(x, weight);
+        else addToUniverse(whichUniv, hist->FindBin(x), weight);
+      }
+
+      void FillUniverse(const UNIVERSE* univ, const double x, const double y, const double weight)
+      {
+        const auto found = fUniverseIndex.find(univ);
+        if(found == fUniverseIndex.end())
+        {
+          fLateralHists.at(univ)->Fill(x, y, weight);
+          return;
+        }
+
+        const int whichUniv = found->second;
+        if(whichUniv == CV)
+        {
+          hist->Fill(x, y, weight);
+          if(!fExpanded) addToCV(hist->FindBin(x, y), weight);
+        }
+        else if(fExpanded) fUniverseHists[whichUniv]->Fill(x, y, weight);
+        else addToUniverse(whichUniv, hist->FindBin(x, y), weight);
+      }
+
+      //Expands the residuals into vertical error bands the first time it's called.  Then makes sure that all error
+      //bands know about the CV like HistWrapper::SyncCVHistos().
+      void SyncCVHistos()
+      {
+        if(!fExpanded) expand();
+
+        const auto syncCV = [this](auto errorBand)
+                            {
+                              for(int cell = 0; cell < fNCells; ++cell)
+                              {
+                                errorBand->SetBinContent(cell, hist->GetBinContent(cell));
+                                errorBand->SetBinError(cell, hist->GetBinError(cell));
+                              }
+                            };
+        for(const auto& band: fBands)
+        {
+          if(band.name == "cv") continue;
+          if(band.vertical) syncCV(hist->GetVertErrorBand(band.name));
+          else syncCV(hist->GetLatErrorBand(band.name));
+        }
+      }
+
+      //Observer pointer like HistWrapper::hist.  Only has its vertical error bands after SyncCVHistos().  Lateral
+      //error bands are there from the start.
+      MNVHIST* hist;
+
+    private:
+      //TH1D* or TH2D*.  Vertical and lateral error bands hold the same kind of histogram.
+      using UnivHist = decltype(std::declval<MNVHIST&>().GetVertErrorBand("")->GetHist(0));
+
+      static constexpr int CV = -1;
+      static constexpr int cvFlushFills = 1024; //How many times a cell of the CV is filled before it's subtracted from the universes
+
+      struct Band
+      {
+        std::string name;
+        int nUniverses;
+        bool vertical; //Lateral bands skip the residuals
+      };
+
+      void init(const std::map<std::string, std::vector<UNIVERSE*>>& error_bands)
+      {
+        hist->SetDirectory(nullptr);
+        if(hist->GetSumw2N() == 0) hist->Sumw2();
+        fNCells = hist->GetNcells();
+        fExpanded = false;
+
+        int nUniverses = 0;
+        for(const auto& band: error_bands)
+        {
+          //Hist2DWrapper decides what kind of band it is from the first universe too
+          const bool vertical = (band.first == "cv") || band.second.empty() || band.second.front()->IsVerticalOnly();
+          fBands.push_back(Band{band.first, static_cast<int>(band.second.size()), vertical});
+          if(vertical)
+          {
+            for(const auto univ: band.second) fUniverseIndex[univ] = (band.first == "cv")?CV:nUniverses++;
+          }
+          else
+          {
+            hist->AddLatErrorBand(band.first, band.second.size());
+            auto errorBand = hist->GetLatErrorBand(band.first);
+            for(size_t whichUniv = 0; whichUniv < band.second.size(); ++whichUniv) fLateralHists[band.second[whichUniv]] = errorBand->GetHist(whichUniv);
+          }
+        }
+
+        fSumw.resize(static_cast<size_t>(nUniverses) * fNCells, 0);
+        fSumw2.resize(static_cast<size_t>(nUniverses) * fNCells, 0);
+        fCVSumw.resize(fNCells, 0);
+        fCVSumw2.resize(fNCells, 0);
+        fCVFills.resize(fNCells, 0);
+      }
+
+      void addToCV(const int cell, const double weight)
+      {
+        fCVSumw[cell] += weight;
+        fCVSumw2[cell] += weight * weight;
+        if(++fCVFills[cell] == cvFlushFills) subtractCV(cell);
+      }
+
+      //Every universe's residual moves down by what the CV went up since the last time
+      void subtractCV(const int cell)
+      {
+        if(fCVFills[cell] == 0) return;
+
+        const double sumw = fCVSumw[cell], sumw2 = fCVSumw2[cell];
+        for(size_t index = cell; index < fSumw.size(); index += fNCells)
+        {
+          fSumw[index] -= sumw;
+          fSumw2[index] -= sumw2;
+        }
+
+        fCVSumw[cell] = 0;
+        fCVSumw2[cell] = 0;
+        fCVFills[cell] = 0;
+      }
+
+      void addToUniverse(const int whichUniv, const int cell, const double weight)
+      {
+        const size_t index = static_cast<size_t>(whichUniv) * fNCells + cell;
+        fSumw[index] += weight;
+        fSumw2[index] += weight * weight;
+      }
+
+      void expand()
+      {
+        for(int cell = 0; cell < fNCells; ++cell) subtractCV(cell);
+
+        int whichUniv = 0;
+        for(const auto& band: fBands)
+        {
+          if(band.name == "cv" || !band.vertical) continue;
+
+          hist->AddVertErrorBand(band.name, band.nUniverses);
+          auto errorBand = hist->GetVertErrorBand(band.name);
+          for(int bandUniv = 0; bandUniv < band.nUniverses; ++bandUniv, ++whichUniv)
+          {
+            auto univHist = errorBand->GetHist(bandUniv);
+            const size_t offset = static_cast<size_t>(whichUniv) * fNCells;
+            for(int cell = 0; cell < fNCells; ++cell)
+            {
+              const double cvError = hist->GetBinError(cell);
+              univHist->SetBinContent(cell, hist->GetBinContent(cell) + fSumw[offset + cell]);
+              univHist->SetBinError(cell, std::sqrt(std::max(0., cvError * cvError + fSumw2[offset + cell])));
+            }
+            fUniverseHists.push_back(univHist);
+          }
+        }
+
+        std::vector<float>().swap(fSumw);
+        std::vector<float>().swap(fSumw2);
+        std::vector<double>().swap(fCVSumw);
+        std::vector<double>().swap(fCVSumw2);
+        std::vector<int>().swap(fCVFills);
+        fExpanded = true;
+      }
+
+      int fNCells; //Including under/overflow
+      bool fExpanded;
+      std::vector<Band> fBands;
+      std::unordered_map<const void*, int> fUniverseIndex; //CV for universes in the cv band.  Only vertical universes.
+      std::unordered_map<const void*, UnivHist> fLateralHists; //Each lateral universe's histogram in its error band
+
+      //Each vertical non-CV universe's sum of weights and sum of squared weights minus the CV's.  Universe index * fNCells + cell.
+      std::vector<float> fSumw;
+      std::vector<float> fSumw2;
+
+      //CV fills of each cell that haven't been subtracted from fSumw and fSumw2 yet
+      std::vector<double> fCVSumw;
+      std::vector<double> fCVSumw2;
+      std::vector<int> fCVFills;
+
+      //The vertical universes' histograms inside hist's error bands once they've been expanded
+      std::vector<UnivHist> fUniverseHists;
+  };
+}
+
+#endif //UTIL_DELTAHISTWRAPPER_H
@@ -0,0 +1,180 @@
+//File: DerivedKinematics.h
+//Brief: Reads the friend trees that MakeDerivedKinematics writes.  They hold quantities that CVUniverse and
+//       getTgtCode() would otherwise work out from raw branches for every entry in every program: Bjorken x and y,
+//       the ANN muon pT, the ANN segment Z positions, and target codes with and without the extended targets.
+//       Each AnaTuple tree <T> gets a <T>Derived tree with the values and a <T>DerivedFiles tree that says how many
+//       entries each AnaTuple file contributed.  That's what lines up a chain made from any subset of the files,
+//       like a grid subrun or --incremental's new files, with the friend entries that go with it.
+//       Attach() a DerivedKinematics to a chain before making its universes, and they'll read from it.
+
+#ifndef UTIL_DERIVEDKINEMATICS_H
+#define UTIL_DERIVEDKINEMATICS_H
+
+//ROOT includes
+#include "TFile.h"
+#include "TTree.h"
+#include "TDirectory.h"
+
+//c++ includes
+#include <vector>
+#include <string>
+#include <map>
+#include <memory>
+#include <algorithm>
+#include <stdexcept>
+
+namespace PlotUtils
+{
+  class ChainWrapper;
+}
+
+namespace util
+{
+  const std::string derivedTreeSuffix = "Derived", derivedFilesTreeSuffix = "DerivedFiles";
+
+  //Everything in a friend tree entry.  Defaults are what the CVUniverse functions return for events they can't handle.
+  struct DerivedValues
+  {
+    //Reco kinematics for the CV.  Lateral systematics shift the muon and recoil, so they have to calculate their own.
+    Double_t bjorkenX = 0, bjorkenY = 0, annMuonPTGeV = 0;
+
+    //Reco vertex quantities.  No systematic moves the vertex, so every universe can use these.
+    Int_t annTgtCode = -1, annTgtCodeExtended = -1;
+    Double_t annZPosSegment0 = -999, annZPosWeighted = -999;
+    Int_t annFirstWeightedCutoff = 0;
+
+    //Only in trees with truth information
+    Int_t truthTgtCode = -1, truthTgtCodeExtended = -1;
+  };
+
+  struct DerivedBranch
+  {
+    std::string name;
+    void* address;
+    char type; //ROOT leaflist type code
+  };
+
+  inline std::vector<DerivedBranch> derivedRecoBranches(DerivedValues& values)
+  {
+    return {{"bjorkenX", &values.bjorkenX, 'D'},
+            {"bjorkenY", &values.bjorkenY, 'D'},
+            {"annMuonPTGeV", &values.annMuonPTGeV, 'D'},
+            {"annTgtCode", &values.annTgtCode, 'I'},
+            {"annTgtCodeExtended", &values.annTgtCodeExtended, 'I'},
+            {"annZPosSegment0", &values.annZPosSegment0, 'D'},
+            {"annZPosWeighted", &values.annZPosWeighted, 'D'},
+            {"annFirstWeightedCutoff", &values.annFirstWeightedCutoff, 'I'}};
+  }
+
+  inline std::vector<DerivedBranch> derivedTruthBranches(DerivedValues& values)
+  {
+    return {{"truthTgtCode", &values.truthTgtCode, 'I'},
+            {"truthTgtCodeExtended", &values.truthTgtCodeExtended, 'I'}};
+  }
+
+  class DerivedKinematics
+  {
+    public:
+      //chainFiles are the files in the chain in the order it reads them, like readPlaylistFiles() returns.  Throws
+      //if the friend trees don't have every one of them or the entries don't add up to chainEntries.
+      DerivedKinematics(const std::string& fileName, const std::string& treeName, const std::vector<std::string>& chainFiles, const Long64_t chainEntries)
+      {
+        fFile.reset(TFile::Open(fileName.c_str(), "READ"));
+        if(!fFile) throw std::runtime_error("Failed to open " + fileName + " for derived kinematics");
+
+        fTree = dynamic_cast<TTree*>(fFile->Get((treeName + derivedTreeSuffix).c_str()));
+        auto filesTree = dynamic_cast<TTree*>(fFile->Get((treeName + derivedFilesTreeSuffix).c_str()));
+        if(!fTree || !filesTree) throw std::runtime_error(fileName + " doesn't have derived kinematics for " + treeName + " trees.  Make it with MakeDerivedKinematics.");
+
+        //Where each AnaTuple file's entries start in the friend tree
+        std::map<std::string, std::pair<Long64_t, Long64_t>> friendFiles; //File name to first entry and number of entries
+        std::string* file = nullptr;
+        Long64_t nEntries = 0, friendStart = 0;
+        filesTree->SetBranchAddress("file", &file);
+        filesTree->SetBranchAddress("entries", &nEntries);
+        for(Long64_t entry = 0; entry < filesTree->GetEntries(); ++entry)
+        {
+          filesTree->GetEntry(entry);
+          friendFiles[*file] = std::make_pair(friendStart, nEntries);
+          friendStart += nEntries;
+        }
+        filesTree->ResetBranchAddresses();
+        delete file;
+
+        Long64_t chainStart = 0;
+        for(const auto& chainFile: chainFiles)
+        {
+          const auto found = friendFiles.find(chainFile);
+          if(found == friendFiles.end()) throw std::runtime_error(fileName + " doesn't have derived kinematics for " + chainFile);
+          fChainStarts.push_back(chainStart);
+          fFriendStarts.push_back(found->second.first);
+          chainStart += found->second.second;
+        }
+        if(chainStart != chainEntries)
+        {
+          throw std::runtime_error(fileName + " has derived kinematics for " + std::to_string(chainStart) + " " + treeName + " entries, but the chain has "
+                                   + std::to_string(chainEntries) + ".  The AnaTuples changed since it was made.");
+        }
+
+        fHasReco = SetAddresses(derivedRecoBranches(fValues));
+        fHasTruth = SetAddresses(derivedTruthBranches(fValues));
+      }
+
+      DerivedKinematics(const DerivedKinematics&) = delete;
+      DerivedKinematics& operator=(const DerivedKinematics&) = delete;
+
+      bool HasReco() const { return fHasReco; }
+      bool HasTruth() const { return fHasTruth; }
+
+      //The values that go with an entry in the chain.  Only reads the friend tree when the entry changes.
+      const DerivedValues& Get(const Long64_t chainEntry) const
+      {
+        if(chainEntry == fEntry) return fValues;
+
+        const size_t whichFile = std::upper_bound(fChainStarts.begin(), fChainStarts.end(), chainEntry) - fChainStarts.begin() - 1;
+        fTree->GetEntry(fFriendStarts[whichFile] + chainEntry - fChainStarts[whichFile]);
+        fEntry = chainEntry;
+        return fValues;
+      }
+
+      //CVUniverses look up the DerivedKinematics for their chain when they're constructed
+      static void Attach(const PlotUtils::ChainWrapper* chain, std::shared_ptr<DerivedKinematics> derived)
+      {
+        Registry()[chain] = derived;
+      }
+
+      static const DerivedKinematics* For(const PlotUtils::ChainWrapper* chain)
+      {
+        const auto found = Registry().find(chain);
+        return (found == Registry().end()) ? nullptr : found->second.get();
+      }
+
+    private:
+      std::unique_ptr<TFile> fFile;
+      TTree* fTree; //Owned by fFile
+      std::vector<Long64_t> fChainStarts, fFriendStarts; //First entry of each chain file in the chain and in fTree
+      bool fHasReco = false, fHasTruth = false;
+
+      mutable DerivedValues fValues;
+      mutable Long64_t fEntry = -1;
+
+      //Only reads a group of branches if all of them are there
+      bool SetAddresses(const std::vector<DerivedBranch>& branches)
+      {
+        for(const auto& branch: branches)
+        {
+          if(!fTree->GetBranch(branch.name.c_str())) return false;
+        }
+        for(const auto& branch: branches) fTree->SetBranchAddress(branch.name.c_str(), branch.address);
+        return true;
+      }
+
+      static std::map<const PlotUtils::ChainWrapper*, std::shared_ptr<DerivedKinematics>>& Registry()
+      {
+        static std::map<const PlotUtils::ChainWrapper*, std::shared_ptr<DerivedKinematics>> registry;
+        return registry;
+      }
+  };
+}
+
+#endif //UTIL_DERIVEDKINEMATICS_H
@@ -0,0 +1,56 @@
+//File: EntrySampler.h
+//Brief: Picks a deterministic 1 in N subset of a TChain's entries for quick previews.  Entries are grouped into
+//       contiguous clusters so that reading stays mostly sequential, and every Nth cluster is kept, so the sample is
+//       spread evenly over every file in the playlist.  Fraction() is exactly the fraction of entries that Keep()
+//       accepts.  Scale the POT for a chain by its Fraction() to normalize a sampled job.
+
+#ifndef UTIL_ENTRYSAMPLER_H
+#define UTIL_ENTRYSAMPLER_H
+
+//ROOT includes
+#include "Rtypes.h"
+
+//c++ includes
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+namespace util
+{
+  class EntrySampler
+  {
+    public:
+      //sampleEvery of 1 keeps every entry
+      EntrySampler(const Long64_t nEntries, const int sampleEvery = 1, const Long64_t clusterSize = 1000): fNEntries(nEntries), fSampleEvery(sampleEvery), fClusterSize(clusterSize)
+      {
+        if(fSampleEvery < 1) throw std::runtime_error("Can't keep 1 in every " + std::to_string(fSampleEvery) + " clusters of entries");
+      }
+
+      bool Keep(const Long64_t entry) const
+      {
+        return (entry / fClusterSize) % fSampleEvery == 0;
+      }
+
+      Long64_t NKept() const
+      {
+        Long64_t nKept = 0;
+        for(Long64_t clusterStart = 0; clusterStart < fNEntries; clusterStart += fClusterSize * fSampleEvery)
+        {
+          nKept += std::min(fClusterSize, fNEntries - clusterStart);
+        }
+        return nKept;
+      }
+
+      double Fraction() const
+      {
+        return (fNEntries > 0)?static_cast<double>(NKept()) / fNEntries:1.;
+      }
+
+    private:
+      Long64_t fNEntries;
+      int fSampleEvery;
+      Long64_t fClusterSize;
+  };
+}
+
+#endif //UTIL_ENTRYSAMPLER_H
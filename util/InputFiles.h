@@ -0,0 +1,97 @@
+//File: InputFiles.h
+//Brief: Keep track of which AnaTuple files went into an event loop output file.  Each output file gets an
+//       InputFiles TTree with one entry per file.  Merging outputs with MergeHistograms or hadd concatenates
+//       those trees, so a merged file still knows everything that went into it.  That's what lets
+//       runEventLoopTargets --incremental process only the files that were added to a playlist since.
+
+#ifndef UTIL_INPUTFILES_H
+#define UTIL_INPUTFILES_H
+
+//ROOT includes
+#include "TFile.h"
+#include "TTree.h"
+#include "TDirectory.h"
+
+//c++ includes
+#include <string>
+#include <vector>
+#include <set>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+
+namespace util
+{
+  const std::string inputFilesTreeName = "InputFiles";
+
+  //Files in a playlist file with 1 file name per line like the ones in PlaylistFiles/
+  inline std::vector<std::string> readPlaylistFiles(const std::string& playlist)
+  {
+    std::ifstream in(playlist);
+    if(!in.is_open()) throw std::runtime_error("Failed to open playlist file " + playlist);
+
+    std::vector<std::string> files;
+    std::string file;
+    while(in >> file) files.push_back(file);
+    return files;
+  }
+
+  inline void writeInputFiles(TDirectory& dir, const std::vector<std::string>& files)
+  {
+    std::string file;
+    TTree inputFiles(inputFilesTreeName.c_str(), "AnaTuple files that were used to make this file");
+    inputFiles.SetDirectory(&dir);
+    inputFiles.Branch("file", &file);
+    for(const auto& name: files)
+    {
+      file = name;
+      inputFiles.Fill();
+    }
+    dir.cd();
+    inputFiles.Write();
+    inputFiles.SetDirectory(nullptr);
+  }
+
+  //The files that went into an output file written by writeInputFiles().  Throws if it doesn't have that information.
+  inline std::set<std::string> readInputFiles(const std::string& outputFileName)
+  {
+    std::unique_ptr<TFile> outputFile(TFile::Open(outputFileName.c_str(), "READ"));
+    if(!outputFile) throw std::runtime_error("Failed to open " + outputFileName);
+
+    auto inputFiles = dynamic_cast<TTree*>(outputFile->Get(inputFilesTreeName.c_str()));
+    if(!inputFiles) throw std::runtime_error(outputFileName + " doesn't record which files went into it.  It was made before "
+                                             + inputFilesTreeName + " was added.");
+
+    std::set<std::string> files;
+    std::string* file = nullptr;
+    inputFiles->SetBranchAddress("file", &file);
+    for(Long64_t entry = 0; entry < inputFiles->GetEntries(); ++entry)
+    {
+      inputFiles->GetEntry(entry);
+      files.insert(*file);
+    }
+    inputFiles->ResetBranchAddresses();
+    delete file;
+
+    return files;
+  }
+
+  //Writes a playlist file next to playlist with only the files that aren't in alreadyUsed.  Returns its name.
+  inline std::string writeNewPlaylistFiles(const std::string& playlist, const std::set<std::string>& alreadyUsed, std::vector<std::string>& newFiles)
+  {
+    newFiles.clear();
+    for(const auto& file: readPlaylistFiles(playlist))
+    {
+      if(!alreadyUsed.count(file)) newFiles.push_back(file);
+    }
+
+    const std::string newPlaylist = playlist + "new.txt";
+    std::ofstream out(newPlaylist);
+    if(!out.is_open()) throw std::runtime_error("Failed to open " + newPlaylist + " for writing");
+    for(const auto& file: newFiles) out << file << "\n";
+
+    return newPlaylist;
+  }
+}
+
+#endif //UTIL_INPUTFILES_H
@@ -0,0 +1,171 @@
+//File: LazyCategorized.h
+//Brief: Like a Categorized<>, but each category's HIST is only constructed the first time
+//       something asks for it.  Most categories of the sideband and background sets are
+//       never filled for a given target.  For example, nothing is ever reconstructed in the
+//       sidebands of the pseudotargets.  So there's no reason to pay for a HistWrapper with
+//       every systematic universe for each of them.
+//       Call materialize() before writing when a downstream program expects every category
+//       to be in the file even if it's empty, or visitUnused() to write the empty ones without
+//       keeping all of them in memory at once.
+//       Small ranges of integer CATEGORYs are looked up in an array like in Categorized<>.
+
+#ifndef UTIL_LAZYCATEGORIZED_H
+#define UTIL_LAZYCATEGORIZED_H
+
+//Local includes
+#include "util/SafeROOTName.h"
+#include "util/Categorized.h" //detail::denseIndex
+
+//c++ includes
+#include <string>
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <functional>
+#include <vector>
+#include <algorithm>
+#include <memory>
+
+namespace util
+{
+  //HIST is constructed with a c-string name, a c-string title, then whatever ARGS are given to the constructor.
+  //CATEGORY is hashable for std::unordered_map<> and ordered for std::map<>.
+  template <class HIST, class CATEGORY>
+  class LazyCategorized
+  {
+    public:
+      //Same arguments as the std::map<> constructor of Categorized<>.  args are copied until the last HIST is made.
+      template <class ...HISTARGS>
+      LazyCategorized(const std::string& baseName, const std::string& axes,
+                      const std::map<CATEGORY, std::string>& categories, HISTARGS... args): fBaseName(baseName), fAxes(axes),
+                                                                                             fCategories(categories), fOther(nullptr),
+                                                                                             fFactory([args...](const std::string& name, const std::string& title)
+                                                                                                      {
+                                                                                                        return new HIST(name.c_str(), title.c_str(), args...);
+                                                                                                      })
+      {
+        BuildDenseIndex();
+      }
+
+      //Constructs the HIST for cat if this is the first time it's been used
+      HIST& operator [](const CATEGORY& cat)
+      {
+        long long index;
+        if(!fDenseKnown.empty() && detail::denseIndex<CATEGORY>::get(cat, index))
+        {
+          index -= fDenseMin;
+          if(index < 0 || index >= static_cast<long long>(fDenseKnown.size()) || !fDenseKnown[index]) return other();
+          if(!fDense[index]) fDense[index] = &Make(cat);
+          return *fDense[index];
+        }
+
+        const auto found = fCatToHist.find(cat);
+        if(found != fCatToHist.end()) return *found->second;
+
+        if(!fCategories.count(cat)) return other(); //Lump this entry in with other uncategorized entries
+        return Make(cat);
+      }
+
+      //Apply a callable object, of type FUNC, to each histogram that has been constructed so far.
+      //FUNC takes only a reference to the histogram as argument.
+      template <class FUNC>
+      void visit(FUNC&& func)
+      {
+        for(auto& category: fCatToHist) func(*(category.second));
+        if(fOther) func(*fOther);
+      }
+
+      //Construct every category's HIST that hasn't been used yet.  They'll be empty.
+      void materialize()
+      {
+        for(const auto& category: fCategories) (*this)[category.first];
+        other();
+      }
+
+      //Construct each category's HIST that hasn't been used yet, including Other, one at a time.  Apply func to it,
+      //then delete it before making the next one.  They aren't remembered, so operator [] and visit() never see them.
+      //func is responsible for anything the HIST points to, like a histogram it wrote to a file.
+      template <class FUNC>
+      void visitUnused(FUNC&& func)
+      {
+        for(const auto& category: fCategories)
+        {
+          if(fCatToHist.count(category.first)) continue;
+          std::unique_ptr<HIST> hist(fFactory(SafeROOTName(fBaseName + "_" + category.second), category.second + ";" + fAxes));
+          func(*hist);
+        }
+
+        if(!fOther)
+        {
+          std::unique_ptr<HIST> hist(fFactory(fBaseName + "_Other", "Other;" + fAxes));
+          func(*hist);
+        }
+      }
+
+      //Delete each HIST that was constructed.  Only for HISTs that no TFile is responsible for,
+      //like the HistWrappers around histograms that were written to a file that has since been Close()d.
+      void deleteHists()
+      {
+        for(auto& category: fCatToHist) delete category.second;
+        delete fOther;
+
+        fCatToHist.clear();
+        std::fill(fDense.begin(), fDense.end(), nullptr);
+        fOther = nullptr;
+      }
+
+    private:
+      //cat has to be in fCategories
+      HIST& Make(const CATEGORY& cat)
+      {
+        const auto& name = fCategories.find(cat)->second;
+        auto hist = fFactory(SafeROOTName(fBaseName + "_" + name), name + ";" + fAxes);
+        fCatToHist[cat] = hist;
+        return *hist;
+      }
+
+      void BuildDenseIndex()
+      {
+        long long index;
+        if(fCategories.empty() || !detail::denseIndex<CATEGORY>::get(fCategories.begin()->first, index)) return;
+
+        //fCategories is sorted, so its ends are the smallest and largest categories
+        long long max;
+        detail::denseIndex<CATEGORY>::get(fCategories.begin()->first, fDenseMin);
+        detail::denseIndex<CATEGORY>::get(fCategories.rbegin()->first, max);
+        if(max - fDenseMin >= detail::maxDenseCategories) return;
+
+        fDense.assign(max - fDenseMin + 1, nullptr);
+        fDenseKnown.assign(max - fDenseMin + 1, false);
+        for(const auto& category: fCategories)
+        {
+          detail::denseIndex<CATEGORY>::get(category.first, index);
+          fDenseKnown[index - fDenseMin] = true;
+        }
+      }
+
+      HIST& other()
+      {
+        if(!fOther) fOther = fFactory(fBaseName + "_Other", "Other;" + fAxes);
+        return *fOther;
+      }
+
+      std::string fBaseName;
+      std::string fAxes;
+      std::map<CATEGORY, std::string> fCategories;
+
+      //Only the HISTs that have been used so far.  Observer pointers like in Categorized<>.
+      std::unordered_map<CATEGORY, HIST*> fCatToHist;
+      HIST* fOther; //All entries that don't fit in any other CATEGORY end up in this HIST
+
+      //fCatToHist as an array from fDenseMin.  Empty when CATEGORY isn't an integer or the categories are spread out
+      //too far.  fDenseKnown says which slots are categories and fDense is nullptr until a category's HIST is made.
+      std::vector<HIST*> fDense;
+      std::vector<char> fDenseKnown;
+      long long fDenseMin = 0;
+
+      std::function<HIST*(const std::string&, const std::string&)> fFactory;
+  };
+}
+
+#endif //UTIL_LAZYCATEGORIZED_H
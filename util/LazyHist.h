@@ -0,0 +1,139 @@
+//File: LazyHist.h
+//Brief: A histogram that is declared up front with its name and binning, but not allocated until it's first used.
+//       The validation programs declare hundreds of histograms, some with 9000 bins, and most jobs only fill some of them.
+//       Every LazyHist registers itself with the LazyHistRegistry, which reports how much memory the allocated
+//       histograms use and writes all of them in one pass.
+
+#ifndef UTIL_LAZYHIST_H
+#define UTIL_LAZYHIST_H
+
+//ROOT includes
+#include "TH1.h"
+#include "TDirectory.h"
+
+//c++ includes
+#include <string>
+#include <vector>
+#include <memory>
+#include <functional>
+#include <algorithm>
+#include <iostream>
+
+namespace util
+{
+  class LazyHistBase
+  {
+    public:
+      LazyHistBase(const std::string& name);
+      virtual ~LazyHistBase();
+
+      const std::string& GetName() const { return fName; }
+
+      //nullptr if this histogram was never used
+      virtual TH1* GetIfAllocated() const = 0;
+
+      //A new histogram with this name and binning that belongs to the caller.  Used to write histograms that were never filled.
+      virtual std::unique_ptr<TH1> MakeEmpty() const = 0;
+
+    private:
+      std::string fName;
+  };
+
+  //Keeps track of every LazyHist in declaration order
+  class LazyHistRegistry
+  {
+    public:
+      static LazyHistRegistry& Get()
+      {
+        static LazyHistRegistry registry;
+        return registry;
+      }
+
+      void Add(LazyHistBase* hist) { fHists.push_back(hist); }
+      void Remove(LazyHistBase* hist) { fHists.erase(std::remove(fHists.begin(), fHists.end(), hist), fHists.end()); }
+
+      //Write every registered histogram to dir.  Histograms that were never filled are written empty, one at a
+      //time, so that the output file has the same contents as if they had all been allocated up front.
+      void Write(TDirectory& dir, const bool writeEmpty = true) const
+      {
+        dir.cd();
+        for (const auto hist: fHists)
+        {
+          if (TH1* allocated = hist->GetIfAllocated()) allocated->Write();
+          else if (writeEmpty) hist->MakeEmpty()->Write();
+        }
+      }
+
+      //Assumes double precision bins like TH1D and TH2D
+      void PrintMemoryUsage(std::ostream& os) const
+      {
+        size_t nAllocated = 0;
+        double bytes = 0;
+        for (const auto hist: fHists)
+        {
+          if (TH1* allocated = hist->GetIfAllocated())
+          {
+            ++nAllocated;
+            bytes += (allocated->GetNcells() + allocated->GetSumw2N()) * sizeof(double);
+          }
+        }
+        os << "Allocated " << nAllocated << " of " << fHists.size() << " declared histograms using " << bytes / 1024. / 1024. << " MB for bin contents and errors.\n";
+      }
+
+    private:
+      LazyHistRegistry() = default;
+
+      std::vector<LazyHistBase*> fHists;
+  };
+
+  inline LazyHistBase::LazyHistBase(const std::string& name): fName(name)
+  {
+    LazyHistRegistry::Get().Add(this);
+  }
+
+  inline LazyHistBase::~LazyHistBase()
+  {
+    LazyHistRegistry::Get().Remove(this);
+  }
+
+  //Takes the same constructor arguments as HIST.  They're copied, so pointers like bin edges must outlive the LazyHist.
+  template <class HIST>
+  class LazyHist: public LazyHistBase
+  {
+    public:
+      template <class ...ARGS>
+      LazyHist(const char* name, ARGS... args): LazyHistBase(name),
+                                                fFactory([nameCopy = std::string(name), args...]() { return new HIST(nameCopy.c_str(), args...); })
+      {
+      }
+
+      HIST* get()
+      {
+        if (!fHist)
+        {
+          fHist.reset(fFactory());
+          fHist->SetDirectory(nullptr); //Don't let an input file that happens to be gDirectory delete it
+        }
+        return fHist.get();
+      }
+
+      HIST* operator ->() { return get(); }
+      HIST& operator *() { return *get(); }
+      operator HIST*() { return get(); }
+
+      TH1* GetIfAllocated() const override { return fHist.get(); }
+
+      std::unique_ptr<TH1> MakeEmpty() const override
+      {
+        std::unique_ptr<TH1> empty(fFactory());
+        empty->SetDirectory(nullptr);
+        return empty;
+      }
+
+    private:
+      std::function<HIST*()> fFactory;
+      std::unique_ptr<HIST> fHist;
+  };
+}
+
+#endif //UTIL_LAZYHIST_H
@@ -0,0 +1,151 @@
+//File: MergeBandShards.h
+//Brief: Combine output files from event loop jobs that ran over the same AnaTuples with different groups of
+//       systematics, like runEventLoopTargets --bands flux and --bands genie.  Every such file has the same CV, so
+//       the CV, POT, input file list, and anything else that isn't a systematic comes from the first file that has
+//       it.  MnvH1Ds, MnvH2Ds, and SparseMigrations get every error band from any file that has it.
+//       Merge each group of band shards like this before adding files from different AnaTuples with MergeFiles().
+//       Data files aren't sharded.  Only the shard that ran with --data writes them.
+
+#ifndef UTIL_MERGEBANDSHARDS_H
+#define UTIL_MERGEBANDSHARDS_H
+
+//util includes
+#include "util/MergeFiles.h"
+#include "util/SparseMigration.h"
+
+//PlotUtils includes
+#include "PlotUtils/MnvH1D.h"
+#include "PlotUtils/MnvH2D.h"
+
+//ROOT includes
+#include "TFile.h"
+#include "TDirectoryFile.h"
+
+//c++ includes
+#include <vector>
+#include <string>
+#include <set>
+#include <memory>
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+
+namespace util
+{
+  const std::string sparseBandsSuffix = "_sparse_bands";
+
+  //MNVHIST is a PlotUtils::MnvH1D or PlotUtils::MnvH2D
+  template <class MNVHIST>
+  void AddMissingBands(MNVHIST& to, MNVHIST& from, const std::string& name)
+  {
+    //Different CVs mean that the jobs didn't run over the same files with the same code
+    const double cvSum = to.Integral(), otherCVSum = from.Integral();
+    if(std::fabs(cvSum - otherCVSum) > 1e-6 * std::max(1., std::fabs(cvSum)))
+      throw std::runtime_error("Can't combine the error bands of band shards with different CVs for " + name + ": "
+                               + std::to_string(cvSum) + " versus " + std::to_string(otherCVSum));
+
+    for(const auto& band: from.GetVertErrorBandNames())
+    {
+      if(!to.HasVertErrorBand(band)) to.AddVertErrorBand(band, from.GetVertErrorBand(band)->GetHists());
+    }
+    for(const auto& band: from.GetLatErrorBandNames())
+    {
+      if(!to.HasLatErrorBand(band)) to.AddLatErrorBand(band, from.GetLatErrorBand(band)->GetHists());
+    }
+  }
+
+  //The first file's copy of name with the error bands from all of the others
+  inline void MergeShardObject(const std::vector<TDirectory*>& inputs, TDirectory& output, const std::string& name)
+  {
+    std::unique_ptr<TObject> merged;
+    for(auto input: inputs)
+    {
+      if(!input->GetKey(name.c_str())) continue;
+      std::unique_ptr<TObject> obj(input->Get(name.c_str()));
+      if(!merged) merged = std::move(obj);
+      else if(auto hist = dynamic_cast<PlotUtils::MnvH1D*>(merged.get())) AddMissingBands(*hist, dynamic_cast<PlotUtils::MnvH1D&>(*obj), name);
+      else if(auto hist = dynamic_cast<PlotUtils::MnvH2D*>(merged.get())) AddMissingBands(*hist, dynamic_cast<PlotUtils::MnvH2D&>(*obj), name);
+      else break; //Not a systematic
+    }
+
+    if(merged) output.WriteTObject(merged.get(), name.c_str());
+  }
+
+  inline void MergeShardMigration(const std::vector<TDirectory*>& inputs, TDirectory& output, const std::string& name)
+  {
+    std::unique_ptr<SparseMigration> merged;
+    for(auto input: inputs)
+    {
+      auto dir = dynamic_cast<TDirectoryFile*>(input);
+      if(!dir || !dir->GetKey((name + sparseBandsSuffix).c_str())) continue;
+      auto migration = SparseMigration::Read(*dir, name);
+      if(!merged) merged = std::move(migration);
+      else merged->AddMissingBands(*migration);
+    }
+
+    if(merged) merged->Write(output);
+  }
+
+  inline void MergeShardDirectories(const std::vector<TDirectory*>& inputs, TDirectory& output)
+  {
+    const auto objects = ListObjects(inputs);
+
+    //A SparseMigration is 4 objects that are all merged together
+    std::set<std::string> migrations;
+    for(const auto& object: objects)
+    {
+      const std::string& name = object.first;
+      if(name.size() > sparseBandsSuffix.size() && name.compare(name.size() - sparseBandsSuffix.size(), std::string::npos, sparseBandsSuffix) == 0)
+        migrations.insert(name.substr(0, name.size() - sparseBandsSuffix.size()));
+    }
+
+    for(const auto& object: objects)
+    {
+      const std::string& name = object.first;
+      const auto sparse = name.rfind("_sparse");
+      if(sparse != std::string::npos && migrations.count(name.substr(0, sparse)))
+      {
+        if(name.compare(sparse, std::string::npos, sparseBandsSuffix) == 0) MergeShardMigration(inputs, output, name.substr(0, sparse));
+      }
+      else if(object.second && object.second->InheritsFrom(TDirectory::Class()))
+      {
+        std::vector<TDirectory*> subdirs;
+        for(auto input: inputs)
+        {
+          if(auto subdir = input->GetDirectory(name.c_str())) subdirs.push_back(subdir);
+        }
+        auto outSubdir = output.mkdir(name.c_str());
+        MergeShardDirectories(subdirs, *outSubdir);
+      }
+      else if(object.second && object.second->InheritsFrom(TTree::Class()))
+      {
+        //Copy the first file's tree
+        auto first = std::find_if(inputs.begin(), inputs.end(), [&name](TDirectory* input) { return input->GetKey(name.c_str()) != nullptr; });
+        MergeTrees({*first}, output, name);
+      }
+      else
+        MergeShardObject(inputs, output, name);
+    }
+  }
+
+  inline void MergeBandShards(const std::vector<std::string>& inputNames, const std::string& outputName)
+  {
+    std::vector<std::unique_ptr<TFile>> inputs;
+    std::vector<TDirectory*> dirs;
+    for(const auto& inputName: inputNames)
+    {
+      inputs.emplace_back(TFile::Open(inputName.c_str(), "READ"));
+      if(!inputs.back())
+        throw std::runtime_error("Failed to open " + inputName);
+      dirs.push_back(inputs.back().get());
+    }
+
+    std::unique_ptr<TFile> output(TFile::Open(outputName.c_str(), "RECREATE"));
+    if(!output)
+      throw std::runtime_error("Could not create a file called " + outputName);
+    MergeShardDirectories(dirs, *output);
+    output->Close();
+  }
+}
+
+#endif //UTIL_MERGEBANDSHARDS_H
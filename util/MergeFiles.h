@@ -0,0 +1,156 @@
+//File: MergeFiles.h
+//Brief: Merge ROOT files from the event loops like hadd does, but one object at a time so that memory use
+//       doesn't grow with the size of the files.  MnvH1Ds and MnvH2Ds are added with all of their error band
+//       universes, TParameters like POTUsed are summed, TTrees are concatenated, and anything else is copied
+//       from the first file that has it.  Objects are written in the order they first appear in the inputs.
+
+#ifndef UTIL_MERGEFILES_H
+#define UTIL_MERGEFILES_H
+
+//ROOT includes
+#include "TH1.h"
+#include "TFile.h"
+#include "TKey.h"
+#include "TTree.h"
+#include "TList.h"
+#include "TClass.h"
+
+//c++ includes
+#include <vector>
+#include <string>
+#include <set>
+#include <memory>
+#include <stdexcept>
+#include <cstdio>
+
+namespace util
+{
+  inline void MergeDirectories(const std::vector<TDirectory*>& inputs, TDirectory& output);
+
+  //Sum of the objects called name in every input that has one.  Only keeps the running sum and the object
+  //currently being added in memory.
+  inline void MergeObject(const std::vector<TDirectory*>& inputs, TDirectory& output, const std::string& name)
+  {
+    TObject* sum = nullptr;
+    for(auto input: inputs)
+    {
+      TObject* obj = input->Get(name.c_str());
+      if(!obj) continue;
+      if(!sum)
+      {
+        sum = obj;
+        continue;
+      }
+
+      //TH1::Add() is virtual, so this adds error bands too for MnvH1Ds and MnvH2Ds.  TH1::Merge() wouldn't.
+      if(auto hist = dynamic_cast<TH1*>(sum))
+      {
+        if(!hist->Add(static_cast<TH1*>(obj)))
+          throw std::runtime_error("Failed to add " + name + " from " + input->GetName());
+      }
+      else if(auto merge = sum->IsA()->GetMerge()) //TParameter<> and friends.  Same as hadd.
+      {
+        TList toMerge;
+        toMerge.Add(obj);
+        merge(sum, &toMerge, nullptr);
+      }
+      delete obj; //Anything else keeps the first file's copy
+    }
+
+    if(!sum) return;
+    output.WriteTObject(sum, name.c_str());
+    delete sum;
+  }
+
+  inline void MergeTrees(const std::vector<TDirectory*>& inputs, TDirectory& output, const std::string& name)
+  {
+    TTree* merged = nullptr;
+    for(auto input: inputs)
+    {
+      auto tree = dynamic_cast<TTree*>(input->Get(name.c_str()));
+      if(!tree) continue;
+      if(!merged)
+      {
+        output.cd();
+        merged = tree->CloneTree(0);
+        merged->SetDirectory(&output);
+      }
+      merged->CopyEntries(tree);
+      delete tree;
+    }
+
+    if(!merged) return;
+    output.cd();
+    merged->Write();
+    delete merged;
+  }
+
+  //Names and classes in the order they first appear.  Each key is only listed once no matter how many cycles it has.
+  inline std::vector<std::pair<std::string, TClass*>> ListObjects(const std::vector<TDirectory*>& inputs)
+  {
+    std::vector<std::pair<std::string, TClass*>> objects;
+    std::set<std::string> seen;
+    for(auto input: inputs)
+    {
+      TIter nextKey(input->GetListOfKeys());
+      while(auto key = static_cast<TKey*>(nextKey()))
+      {
+        if(seen.insert(key->GetName()).second)
+          objects.emplace_back(key->GetName(), TClass::GetClass(key->GetClassName()));
+      }
+    }
+    return objects;
+  }
+
+  inline void MergeDirectories(const std::vector<TDirectory*>& inputs, TDirectory& output)
+  {
+    for(const auto& object: ListObjects(inputs))
+    {
+      const std::string& name = object.first;
+      if(object.second && object.second->InheritsFrom(TDirectory::Class()))
+      {
+        std::vector<TDirectory*> subdirs;
+        for(auto input: inputs)
+        {
+          if(auto subdir = input->GetDirectory(name.c_str())) subdirs.push_back(subdir);
+        }
+        auto outSubdir = output.mkdir(name.c_str());
+        MergeDirectories(subdirs, *outSubdir);
+      }
+      else if(object.second && object.second->InheritsFrom(TTree::Class()))
+        MergeTrees(inputs, output, name);
+      else
+        MergeObject(inputs, output, name);
+    }
+  }
+
+  inline void MergeFiles(const std::vector<std::string>& inputNames, const std::string& outputName)
+  {
+    std::vector<std::unique_ptr<TFile>> inputs;
+    std::vector<TDirectory*> dirs;
+    for(const auto& inputName: inputNames)
+    {
+      inputs.emplace_back(TFile::Open(inputName.c_str(), "READ"));
+      if(!inputs.back())
+        throw std::runtime_error("Failed to open " + inputName);
+      dirs.push_back(inputs.back().get());
+    }
+
+    std::unique_ptr<TFile> output(TFile::Open(outputName.c_str(), "RECREATE"));
+    if(!output)
+      throw std::runtime_error("Could not create a file called " + outputName);
+    MergeDirectories(dirs, *output);
+    output->Close();
+  }
+
+  //Add the objects in addition to existing, an output file from an earlier job, in place
+  inline void MergeInto(const std::string& existing, const std::string& addition)
+  {
+    const std::string merged = existing + ".merging";
+    MergeFiles({existing, addition}, merged);
+    if(std::rename(merged.c_str(), existing.c_str()) != 0)
+      throw std::runtime_error("Failed to replace " + existing + " with " + merged);
+  }
+}
+
+#endif //UTIL_MERGEFILES_H
@@ -5,6 +5,12 @@
 #include <algorithm>
 #include <string>
 #include <filesystem>
+#include <sstream>
+#include <stdexcept>
+#include <iostream>
+#include <sys/resource.h> //getrusage()
+
+#include "TSystem.h"
 
 #include "PlotUtils/Cut.h"
 #include "event/MichelEvent.h"
@@ -722,6 +728,27 @@ namespace util
         return -1;
     }
 
+    //Which of the volumes the validation plots are broken down by a vertex is in.  Used to do the TargetUtils checks once
+    //per vertex position instead of once per point in a scan.
+    struct ValidationVolumes
+    {
+        bool iron2, lead2, iron3, lead3, carbon3, lead4, iron5, lead5, water, tracker;
+    };
+
+    ValidationVolumes getValidationVolumes(PlotUtils::TargetUtils& tgtUtil, double vtx_x, double vtx_y, double vtx_z)
+    {
+        return {tgtUtil.InIron2VolMC(vtx_x, vtx_y, vtx_z, 850, true),
+                tgtUtil.InLead2VolMC(vtx_x, vtx_y, vtx_z, 850, true),
+                tgtUtil.InIron3VolMC(vtx_x, vtx_y, vtx_z, 850, true),
+                tgtUtil.InLead3VolMC(vtx_x, vtx_y, vtx_z, 850, true),
+                tgtUtil.InCarbon3VolMC(vtx_x, vtx_y, vtx_z, 850, true),
+                tgtUtil.InLead4VolMC(vtx_x, vtx_y, vtx_z),
+                tgtUtil.InIron5VolMC(vtx_x, vtx_y, vtx_z, 850, true),
+                tgtUtil.InLead5VolMC(vtx_x, vtx_y, vtx_z, 850, true),
+                tgtUtil.InWaterTargetVolMC(vtx_x, vtx_y, vtx_z),
+                tgtUtil.InTracker(vtx_x, vtx_y, vtx_z)};
+    }
+
     template<class HIST>
     void AddHist(HIST& hist1, HIST* hist2, double scale = 1)
     {
@@ -750,6 +777,61 @@ namespace util
         }
     } */
 
+    //Parse a list of unfolding iteration counts like "5", "5,1,2,3,10" or "5,1-20,30" in the order given, dropping duplicates
+    //Used by the extraction programs so that one run can scan several numbers of iterations. The first entry is the nominal one.
+    //Throws std::invalid_argument for anything that isn't a number, for numbers less than 1, and for ranges that go backwards like "20-1".
+    std::vector<int> parseIterationList(const std::string& list)
+    {
+        const auto toInt = [&list](const std::string& number)
+        {
+            size_t end = 0;
+            int value = 0;
+            try { value = std::stoi(number, &end); }
+            catch(const std::logic_error&) { end = 0; } //Not a number or too big for an int
+            if(end == 0 || end != number.size()) throw std::invalid_argument("\"" + number + "\" in \"" + list + "\" is not a number of unfolding iterations");
+            return value;
+        };
+
+        std::vector<int> iterations;
+        std::stringstream ss(list);
+        std::string item;
+        while (std::getline(ss, item, ','))
+        {
+            if (item.empty()) continue;
+            int first, last;
+            const size_t dash = item.find('-', 1);
+            if (dash == std::string::npos) first = last = toInt(item);
+            else
+            {
+                first = toInt(item.substr(0, dash));
+                last = toInt(item.substr(dash+1));
+                if (first > last) throw std::invalid_argument("Range of unfolding iterations " + item + " goes backwards");
+            }
+            for (int iter = first; iter <= last; ++iter)
+            {
+                if (iter < 1) throw std::invalid_argument("Number of unfolding iterations must be at least 1 but got " + std::to_string(iter));
+                if (std::find(iterations.begin(), iterations.end(), iter) == iterations.end()) iterations.push_back(iter);
+            }
+        }
+        return iterations;
+    }
+
+    //Resident memory of this process right now
+    double getResidentMemoryMB()
+    {
+        ProcInfo_t procInfo;
+        gSystem->GetProcInfo(&procInfo);
+        return procInfo.fMemResident / 1024.;
+    }
+
+    //Current and peak resident memory of this process.  Used to check that long multi-target jobs stay under the grid memory limit.
+    void printMemoryUsage(std::ostream& os, const std::string& when)
+    {
+        rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+        os << "Memory usage " << when << ": " << getResidentMemoryMB() << " MB resident, " << usage.ru_maxrss / 1024. << " MB peak\n";
+    }
+
     //Helper function used to find directories containing root files
     std::vector<std::string> findContainingDirectories(std::string dir, std::string type, bool recursiveSearch = true, bool skipTest = true, int curdepth = 0, int maxdepth = 2)
     {
@@ -841,6 +923,9 @@ namespace util
     int mod, plane;
     if (truth) // Truth
     {
+        //MakeDerivedKinematics already worked the whole thing out
+        if (const auto derived = universe->GetDerivedTruth()) return useExtendedTarget ? derived->truthTgtCodeExtended : derived->truthTgtCode;
+
         //First step, what target does the tuple say it's in
         int truthTgtCode = universe->GetTruthTargetCode();
         if (truthTgtCode > 0) return truthTgtCode; //Maybe do a more explicit check for if it's a valid target code?
@@ -859,6 +944,8 @@ namespace util
     }
     else // ANN
     {
+        if (const auto derived = universe->GetDerivedReco()) return useExtendedTarget ? derived->annTgtCodeExtended : derived->annTgtCode;
+
         //First step, what target does the tuple say it's in
         int ANNTgtCode = universe->GetANNTargetCode();
         if (ANNTgtCode > 0) return ANNTgtCode; //Maybe do a more explicit check for if it's a valid target code?
@@ -1066,6 +1153,9 @@ namespace reco
         {
         }
 
+        double GetMin() const { return fMin; }
+        double GetMax() const { return fMax; }
+
         private:
         bool checkCut(const UNIVERSE& univ, EVENT& /*evt*/) const override
         {
@@ -1084,6 +1174,8 @@ namespace reco
         {
         }
 
+        double GetMin() const { return fMin; }
+
         private:
         bool checkCut(const UNIVERSE& univ, EVENT& /*evt*/) const override
         {
@@ -1135,6 +1227,9 @@ namespace reco
         {
         }
 
+        int GetTargetCode() const { return fTargetCode; }
+        bool UsesExtendedTarget() const { return fUseExtendedTarget; }
+
         private:
         bool checkCut(const UNIVERSE& univ, EVENT& /*evt*/) const override
         {   
@@ -1188,11 +1283,12 @@ namespace util
 
   //Boiler plate precuts for CC inclusive NuMu ME Analysis
   const double apothem = 850; //All in mm
+  const double maxMuonAngle = 17; //degrees
   PlotUtils::Cutter<CVUniverse, MichelEvent>::reco_t GetAnalysisCuts(int pdg)
   {
     PlotUtils::Cutter<CVUniverse, MichelEvent>::reco_t cuts;
     cuts.emplace_back(new reco::Apothem<CVUniverse, MichelEvent>(apothem));
-    cuts.emplace_back(new reco::MaxMuonAngle<CVUniverse, MichelEvent>(17.));
+    cuts.emplace_back(new reco::MaxMuonAngle<CVUniverse, MichelEvent>(maxMuonAngle));
     cuts.emplace_back(new reco::HasMINOSMatch<CVUniverse, MichelEvent>());
     cuts.emplace_back(new reco::NoDeadtime<CVUniverse, MichelEvent>(1, "Deadtime"));
     if (pdg>0)  cuts.emplace_back(new reco::IsNeutrino<CVUniverse, MichelEvent>()); //Used minos curvature
@@ -1210,7 +1306,7 @@ namespace util
   {
     PlotUtils::Cutter<CVUniverse, MichelEvent>::truth_t phasespace;
     phasespace.emplace_back(new truth::Apothem<CVUniverse>(apothem));
-    phasespace.emplace_back(new truth::MuonAngle<CVUniverse>(17.));
+    phasespace.emplace_back(new truth::MuonAngle<CVUniverse>(maxMuonAngle));
     phasespace.emplace_back(new truth::MuonEnergyMinGeV<CVUniverse>(2, "EMu Min"));
     phasespace.emplace_back(new truth::MuonEnergyMaxGeV<CVUniverse>(20, "EMu Max"));
     return phasespace;
@@ -0,0 +1,114 @@
+//File: ResultCache.h
+//Brief: A directory of event loop output files indexed by a hash of everything that went into them: the input
+//       file lists, the target, the environment variables that pick the tune and warps, and the executable
+//       itself, which covers the cuts and binning compiled into it.  A rerun with the same hash copies the
+//       stored files instead of running the event loop again.
+//       Libraries like PlotUtils aren't part of the hash beyond the environment variables that point to them,
+//       so clear the cache after updating them.
+
+#ifndef UTIL_RESULTCACHE_H
+#define UTIL_RESULTCACHE_H
+
+//ROOT includes
+#include "TMD5.h"
+#include "TSystem.h"
+
+//c++ includes
+#include <string>
+#include <vector>
+#include <fstream>
+#include <sstream>
+#include <memory>
+#include <cstdlib>
+#include <stdexcept>
+
+namespace util
+{
+  class ResultCache
+  {
+    public:
+      //configuration describes everything the outputs depend on other than the target
+      ResultCache(const std::string& cacheDir, const std::string& configuration): fCacheDir(cacheDir), fConfiguration(configuration)
+      {
+      }
+
+      //Hash of the executable that's running so that changing any code that's compiled in changes the hash.
+      //Throws if the executable can't be found.
+      static std::string CodeVersion()
+      {
+        std::unique_ptr<TMD5> checksum(TMD5::FileChecksum("/proc/self/exe"));
+        if(!checksum) throw std::runtime_error("Can't read /proc/self/exe to find out which version of the code this is");
+        return checksum->AsString();
+      }
+
+      //Contents of a playlist file along with its name
+      static std::string DescribePlaylist(const std::string& playlist)
+      {
+        std::ifstream in(playlist);
+        if(!in.is_open()) throw std::runtime_error("Failed to open playlist file " + playlist);
+        std::stringstream contents;
+        contents << playlist << ":\n" << in.rdbuf();
+        return contents.str();
+      }
+
+      //Values of environment variables, with unset ones told apart from empty ones
+      static std::string DescribeEnvironment(const std::vector<std::string>& names)
+      {
+        std::string description;
+        for(const auto& name: names)
+        {
+          const char* value = std::getenv(name.c_str());
+          description += name + (value ? "=" + std::string(value) : " unset") + "\n";
+        }
+        return description;
+      }
+
+      std::string Hash(const int target) const
+      {
+        const std::string toHash = fConfiguration + "target " + std::to_string(target) + "\n";
+        TMD5 md5;
+        md5.Update(reinterpret_cast<const UChar_t*>(toHash.data()), toHash.size());
+        md5.Final();
+        return md5.AsString();
+      }
+
+      //Copies the stored output files for target into the current directory.  Returns false if there aren't any.
+      bool Restore(const int target) const
+      {
+        const std::string entry = fCacheDir + "/" + Hash(target);
+        std::ifstream manifest(entry + "/" + manifestName);
+        if(!manifest.is_open()) return false;
+
+        std::string file;
+        while(manifest >> file)
+        {
+          if(gSystem->CopyFile((entry + "/" + file).c_str(), file.c_str(), kTRUE) != 0)
+            throw std::runtime_error("Failed to copy " + file + " out of the result cache at " + entry);
+        }
+        return true;
+      }
+
+      //Copies outputFiles for target into the cache.  The manifest is written last, so an interrupted Store() is never Restore()d.
+      void Store(const int target, const std::vector<std::string>& outputFiles) const
+      {
+        const std::string entry = fCacheDir + "/" + Hash(target);
+        gSystem->mkdir(entry.c_str(), kTRUE);
+        for(const auto& file: outputFiles)
+        {
+          if(gSystem->CopyFile(file.c_str(), (entry + "/" + file).c_str(), kTRUE) != 0)
+            throw std::runtime_error("Failed to copy " + file + " into the result cache at " + entry);
+        }
+
+        std::ofstream manifest(entry + "/" + manifestName);
+        for(const auto& file: outputFiles) manifest << file << "\n";
+      }
+
+    private:
+      static constexpr const char* manifestName = "files.txt";
+
+      std::string fCacheDir;
+      std::string fConfiguration;
+  };
+}
+
+#endif //UTIL_RESULTCACHE_H
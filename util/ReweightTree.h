@@ -0,0 +1,154 @@
+//File: ReweightTree.h
+//Brief: Saves every Reweighter component's factor for each event that a target selects or puts in its efficiency
+//       denominator, along with the event's entry number and its 1D Variables' reco and true values.  Any tune or
+//       warp's CV weight is a product of some of these factors, so RehistogramWeights can make CV histograms for any
+//       model without reading the AnaTuples again.  Tune v4 changes how universes calculate weights, so trees made
+//       with MnvTune v4 only work for v4 models and vice versa.
+//       The trees are Selected and EffDenom.  Each Variable's bins are saved as a TVectorD called <var>_bins.
+
+#ifndef UTIL_REWEIGHTTREE_H
+#define UTIL_REWEIGHTTREE_H
+
+//util includes
+#include "util/AlternateModels.h"
+
+//PlotUtils includes
+#include "PlotUtils/VariableBase.h"
+
+//ROOT includes
+#include "TFile.h"
+#include "TTree.h"
+#include "TVectorD.h"
+#include "TParameter.h"
+#include "TNamed.h"
+#include "TDirectory.h"
+
+//c++ includes
+#include <vector>
+#include <string>
+#include <memory>
+#include <stdexcept>
+
+namespace util
+{
+  const std::string reweightSelectedTreeName = "Selected", reweightEffDenomTreeName = "EffDenom", reweightBinsSuffix = "_bins";
+
+  //Every Reweighter in reweighterComponents.  Each one is evaluated at most once per entry no matter how many
+  //ReweightTrees share it.
+  class ReweighterFactors
+  {
+    public:
+      ReweighterFactors()
+      {
+        for(const auto& component: reweighterComponents) fReweighters.push_back(MakeReweighter(component));
+        fFactors.resize(fReweighters.size());
+      }
+
+      const std::vector<double>& Factors(const long long entry, const CVUniverse& cvUniv, const MichelEvent& evt)
+      {
+        //The reco and Truth trees both start at entry 0, but they have different CV universes
+        if(entry == fEntry && &cvUniv == fUniv) return fFactors;
+
+        for(size_t whichComponent = 0; whichComponent < fReweighters.size(); ++whichComponent)
+          fFactors[whichComponent] = fReweighters[whichComponent]->GetWeight(cvUniv, evt);
+        fEntry = entry;
+        fUniv = &cvUniv;
+        return fFactors;
+      }
+
+    private:
+      std::vector<std::unique_ptr<PlotUtils::Reweighter<CVUniverse, MichelEvent>>> fReweighters;
+      std::vector<double> fFactors;
+      long long fEntry = -1;
+      const CVUniverse* fUniv = nullptr;
+  };
+
+  class ReweightTrees
+  {
+    public:
+      using Variable = PlotUtils::VariableBase<CVUniverse>;
+
+      //The trees go straight into fileName so that they don't have to fit in memory.  vars have to outlive the ReweightTrees.
+      ReweightTrees(const std::string& fileName, std::shared_ptr<ReweighterFactors> factors, const std::vector<const Variable*>& vars):
+        fFactors(factors), fVars(vars), fReco(vars.size()), fTruth(vars.size()), fFactorValues(reweighterComponents.size())
+      {
+        TDirectory::TContext restoreDir(gDirectory); //Don't leave gDirectory pointing at this file
+        fFile.reset(TFile::Open(fileName.c_str(), "RECREATE"));
+        if(!fFile) throw std::runtime_error("Failed to open a file named " + fileName + " for the reweighter factors");
+
+        fSelected = new TTree(reweightSelectedTreeName.c_str(), "Reweighter factors for selected events"); //Owned by fFile
+        fEffDenom = new TTree(reweightEffDenomTreeName.c_str(), "Reweighter factors for efficiency denominator events");
+        for(auto tree: {fSelected, fEffDenom})
+        {
+          tree->Branch("entry", &fEntry, "entry/L");
+          for(size_t whichVar = 0; whichVar < fVars.size(); ++whichVar) tree->Branch((fVars[whichVar]->GetName() + "_true").c_str(), &fTruth[whichVar], (fVars[whichVar]->GetName() + "_true/F").c_str());
+          for(size_t whichComponent = 0; whichComponent < fFactorValues.size(); ++whichComponent)
+            tree->Branch(reweighterComponents[whichComponent].c_str(), &fFactorValues[whichComponent], (reweighterComponents[whichComponent] + "/F").c_str());
+        }
+        fSelected->Branch("isSignal", &fIsSignal, "isSignal/O");
+        for(size_t whichVar = 0; whichVar < fVars.size(); ++whichVar) fSelected->Branch((fVars[whichVar]->GetName() + "_reco").c_str(), &fReco[whichVar], (fVars[whichVar]->GetName() + "_reco/F").c_str());
+      }
+
+      ReweightTrees(const ReweightTrees&) = delete;
+      ReweightTrees& operator=(const ReweightTrees&) = delete;
+
+      //For the CV universe only
+      void FillSelected(const long long entry, const CVUniverse& cvUniv, const MichelEvent& evt, const bool isSignal)
+      {
+        for(size_t whichVar = 0; whichVar < fVars.size(); ++whichVar)
+        {
+          fReco[whichVar] = fVars[whichVar]->GetRecoValue(cvUniv);
+          fTruth[whichVar] = isSignal ? fVars[whichVar]->GetTrueValue(cvUniv) : 0;
+        }
+        fIsSignal = isSignal;
+        SetFactors(entry, cvUniv, evt);
+        fSelected->Fill();
+      }
+
+      void FillEffDenom(const long long entry, const CVUniverse& cvUniv, const MichelEvent& evt)
+      {
+        for(size_t whichVar = 0; whichVar < fVars.size(); ++whichVar) fTruth[whichVar] = fVars[whichVar]->GetTrueValue(cvUniv);
+        SetFactors(entry, cvUniv, evt);
+        fEffDenom->Fill();
+      }
+
+      //sampleWeight is the weight that the efficiency denominator needs besides the model's
+      void Write(const std::string& playlist, const double pot, const double sampleWeight)
+      {
+        fFile->cd();
+        fSelected->Write();
+        fEffDenom->Write();
+        for(auto var: fVars)
+        {
+          const auto bins = var->GetBinVec();
+          TVectorD(bins.size(), bins.data()).Write((var->GetName() + reweightBinsSuffix).c_str());
+        }
+        TNamed("PlaylistUsed", playlist.c_str()).Write();
+        TParameter<double>("POTUsed", pot).Write();
+        TParameter<double>("sampleWeight", sampleWeight).Write();
+        fFile->Close();
+      }
+
+    private:
+      std::shared_ptr<ReweighterFactors> fFactors;
+      std::vector<const Variable*> fVars;
+      std::unique_ptr<TFile> fFile;
+      TTree* fSelected;
+      TTree* fEffDenom;
+
+      //Branch addresses.  Floats are precise enough to make histograms, and they halve the file size.
+      Long64_t fEntry = 0;
+      Bool_t fIsSignal = false;
+      std::vector<Float_t> fReco, fTruth;
+      std::vector<Float_t> fFactorValues;
+
+      void SetFactors(const long long entry, const CVUniverse& cvUniv, const MichelEvent& evt)
+      {
+        fEntry = entry;
+        const auto& factors = fFactors->Factors(entry, cvUniv, evt);
+        for(size_t whichComponent = 0; whichComponent < factors.size(); ++whichComponent) fFactorValues[whichComponent] = factors[whichComponent];
+      }
+  };
+}
+
+#endif //UTIL_REWEIGHTTREE_H
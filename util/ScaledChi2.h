@@ -0,0 +1,128 @@
+//File: ScaledChi2.h
+//Brief: The chi2 between a data MnvH1D and an MC MnvH1D times a scale factor, like
+//       MnvPlotter::Chi2DataMC(data, mc, ndf, scale, true, useOnlyShapeErrors), for fits that try many scale factors.
+//       The covariance is the data's total error matrix plus the scaled MC's statistical error matrix, and only the
+//       MC statistical part depends on the scale.  So the constructor factors the covariance at a scale of 1 once:
+//       with C = L L^T from a Cholesky decomposition and L^-1 MCStat L^-T = Q Lambda Q^T,
+//       chi2(s) = sum_k (a_k - s b_k)^2 / (1 + (s^2 - 1) Lambda_k) with a = Q^T L^-1 data and b = Q^T L^-1 MC.
+//       Each call to operator() is then a single loop over the bins with no allocations.
+//       Like the SVD inverse in MnvPlotter, bins with no variance at all don't contribute.
+//       Only for useDataErrorMatrix = true.  Chi2DataMC() builds a different covariance without it, like the one
+//       SidebandTuning.py uses.
+
+#ifndef UTIL_SCALEDCHI2_H
+#define UTIL_SCALEDCHI2_H
+
+//PlotUtils includes
+#include "PlotUtils/MnvH1D.h"
+
+//ROOT includes
+#include "TMatrixD.h"
+#include "TMatrixDSym.h"
+#include "TMatrixDSymEigen.h"
+#include "TDecompChol.h"
+#include "TVectorD.h"
+
+//c++ includes
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <stdexcept>
+
+namespace util
+{
+  class ScaledChi2
+  {
+    public:
+      //Compares the bins between the underflow and overflow bins
+      ScaledChi2(const PlotUtils::MnvH1D& data, const PlotUtils::MnvH1D& mc, const bool useOnlyShapeErrors = false)
+      {
+        const TMatrixD dataCov = data.GetTotalErrorMatrix(true, false, useOnlyShapeErrors);
+        const TMatrixD mcStat = mc.GetStatErrorMatrix();
+
+        std::vector<int> bins;
+        for(int bin = 1; bin <= data.GetNbinsX(); ++bin)
+        {
+          if(dataCov(bin, bin) + mcStat(bin, bin) > 0) bins.push_back(bin);
+        }
+        const int nBins = bins.size();
+
+        TMatrixDSym cov(nBins);
+        for(int row = 0; row < nBins; ++row)
+        {
+          for(int col = 0; col < nBins; ++col) cov(row, col) = dataCov(bins[row], bins[col]) + mcStat(bins[row], bins[col]);
+        }
+
+        //cov = U^T U, so L^-1 is the transpose of U^-1
+        TDecompChol chol(cov);
+        if(!chol.Decompose()) throw std::runtime_error(std::string("Data/MC covariance for ") + data.GetName() + " isn't positive definite");
+        TMatrixD uInverse(chol.GetU());
+        uInverse.Invert();
+
+        //The MC statistical error matrix is diagonal
+        TMatrixDSym whitenedMCStat(nBins);
+        for(int row = 0; row < nBins; ++row)
+        {
+          for(int col = 0; col <= row; ++col)
+          {
+            double sum = 0;
+            for(int k = 0; k <= std::min(row, col); ++k) sum += uInverse(k, row) * mcStat(bins[k], bins[k]) * uInverse(k, col);
+            whitenedMCStat(row, col) = whitenedMCStat(col, row) = sum;
+          }
+        }
+
+        const TMatrixDSymEigen eigen(whitenedMCStat);
+        const TMatrixD& q = eigen.GetEigenVectors();
+        const TVectorD& lambda = eigen.GetEigenValues();
+
+        std::vector<double> whitenedData(nBins, 0), whitenedMC(nBins, 0);
+        for(int row = 0; row < nBins; ++row)
+        {
+          for(int k = 0; k <= row; ++k)
+          {
+            whitenedData[row] += uInverse(k, row) * data.GetBinContent(bins[k]);
+            whitenedMC[row] += uInverse(k, row) * mc.GetBinContent(bins[k]);
+          }
+        }
+
+        fData.assign(nBins, 0);
+        fMC.assign(nBins, 0);
+        fLambda.assign(nBins, 0);
+        for(int eigenvector = 0; eigenvector < nBins; ++eigenvector)
+        {
+          for(int row = 0; row < nBins; ++row)
+          {
+            fData[eigenvector] += q(row, eigenvector) * whitenedData[row];
+            fMC[eigenvector] += q(row, eigenvector) * whitenedMC[row];
+          }
+          fLambda[eigenvector] = lambda(eigenvector);
+        }
+      }
+
+      double operator()(const double mcScale) const
+      {
+        const double statScale = mcScale * mcScale - 1;
+        double chi2 = 0;
+        for(size_t k = 0; k < fData.size(); ++k)
+        {
+          const double diff = fData[k] - mcScale * fMC[k];
+          chi2 += diff * diff / (1 + statScale * fLambda[k]);
+        }
+        return chi2;
+      }
+
+      //Number of bins that go into the chi2
+      int NDF() const
+      {
+        return fData.size();
+      }
+
+    private:
+      //Data, MC, and MC statistical variance in the basis where the covariance at a scale of 1 is the identity
+      std::vector<double> fData;
+      std::vector<double> fMC;
+      std::vector<double> fLambda;
+  };
+}
+
+#endif //UTIL_SCALEDCHI2_H
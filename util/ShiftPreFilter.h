@@ -0,0 +1,148 @@
+//File: ShiftPreFilter.h
+//Brief: Skips MC entries that no universe can select before the event loop sets up any universe for them.  Each
+//       lateral error band declares how far one sigma of it can move the quantities that the pre-filter cuts on.
+//       The biggest shift in the job is the envelope.  An entry is skipped when the CV fails every selection's
+//       vertex Z, apothem, target, or muon angle cut by more than the envelope and isn't in any target's sideband.
+//       Vertical-only universes share the CV's quantities, so they can't pass either.  An error band that isn't
+//       vertical-only and isn't declared here throws, so that an unknown shift can't change the results.
+
+#ifndef UTIL_SHIFTPREFILTER_H
+#define UTIL_SHIFTPREFILTER_H
+
+//util includes
+#include "util/NukeUtils.h"
+
+//PlotUtils includes
+#include "PlotUtils/Cutter.h"
+
+//c++ includes
+#include <vector>
+#include <string>
+#include <map>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include <stdexcept>
+
+namespace util
+{
+  //How far one sigma of a lateral systematic can move each quantity
+  struct LateralShift
+  {
+    double vertex; //mm in any direction
+    double thetaMu; //radians
+  };
+
+  inline const std::map<std::string, LateralShift>& lateralShiftsPerSigma()
+  {
+    static const std::map<std::string, LateralShift> shifts = {
+      //Twice MINERvA's 1 mrad beam direction uncertainty.  Rotating the beam by an angle changes the muon angle by at most that much.
+      {"BeamAngleX", {0, 0.002}},
+      {"BeamAngleY", {0, 0.002}},
+      //MINERvA's and MINOS's muon energy scales and the muon momentum resolution only override GetPmu().  The muon
+      //angle comes from the muon track's direction through GetThetamu(), and the vertex comes from its own branches,
+      //so neither can move across a cut in these universes.  Give them real shifts here if they ever override
+      //GetThetamu() or the vertex.
+      {"Muon_Energy_MINERvA", {0, 0}},
+      {"Muon_Energy_MINOS", {0, 0}},
+      {"MuonResolution", {0, 0}}
+    };
+    return shifts;
+  }
+
+  class ShiftPreFilter
+  {
+    public:
+      using Cuts = PlotUtils::Cutter<CVUniverse, MichelEvent>;
+
+      //Throws if one of bands is lateral but not in lateralShiftsPerSigma()
+      ShiftPreFilter(const std::map<std::string, std::vector<CVUniverse*>>& bands): fEnvelope{0, 0}
+      {
+        for(const auto& band: bands)
+        {
+          if(band.first == "cv") continue;
+          for(const auto univ: band.second)
+          {
+            if(univ->IsVerticalOnly()) continue;
+
+            const auto shift = lateralShiftsPerSigma().find(band.first);
+            if(shift == lateralShiftsPerSigma().end()) throw std::runtime_error("Error band " + band.first + " is lateral, but it doesn't declare how far it shifts the cut variables");
+            fEnvelope.vertex = std::max(fEnvelope.vertex, shift->second.vertex * std::fabs(univ->GetSigma()));
+            fEnvelope.thetaMu = std::max(fEnvelope.thetaMu, shift->second.thetaMu * std::fabs(univ->GetSigma()));
+          }
+        }
+      }
+
+      //Call with each selection's precuts before they go into its Cutter.  Cuts the pre-filter doesn't know are ignored.
+      void AddSelection(const Cuts::reco_t& cuts)
+      {
+        Selection selection;
+        for(const auto& cut: cuts)
+        {
+          if(auto z = dynamic_cast<const reco::ZRangeANN<CVUniverse, MichelEvent>*>(cut.get()))
+          {
+            selection.zMin = std::max(selection.zMin, z->GetMin());
+            selection.zMax = std::min(selection.zMax, z->GetMax());
+          }
+          else if(dynamic_cast<const reco::Apothem<CVUniverse, MichelEvent>*>(cut.get())) selection.apothem = std::min(selection.apothem, util::apothem); //Doesn't tell what its apothem is, but GetAnalysisCuts() uses util::apothem
+          else if(dynamic_cast<const reco::MaxMuonAngle<CVUniverse, MichelEvent>*>(cut.get())) selection.thetaMax = std::min(selection.thetaMax, util::maxMuonAngle * M_PI / 180.); //Or its angle, but GetAnalysisCuts() uses util::maxMuonAngle
+          else if(auto target = dynamic_cast<const reco::IsInTarget<CVUniverse, MichelEvent>*>(cut.get())) selection.targets.emplace_back(target->GetTargetCode(), target->UsesExtendedTarget());
+        }
+        fSelections.push_back(selection);
+      }
+
+      //The event loop fills targetCode's sideband histograms before any cuts
+      void AddSideband(const int targetCode)
+      {
+        fSidebandTargets.push_back(targetCode);
+      }
+
+      //False if no universe can pass any selection or be in any sideband
+      bool Keep(CVUniverse& cvUniv)
+      {
+        const bool vertexFixed = (fEnvelope.vertex == 0);
+        if(!vertexFixed && !fSidebandTargets.empty()) return true;
+        for(const auto target: fSidebandTargets)
+        {
+          if(util::isTargetSideband(&cvUniv, 1, target, 1, true) || util::isTargetSideband(&cvUniv, 1, target, 0, true)) return true;
+        }
+
+        const double z = cvUniv.GetANNVertex().Z(), thetaMu = cvUniv.GetThetamu();
+        const auto vtx = cvUniv.GetVertex();
+        //Apothem of the smallest hexagon around the vertex like IsInHexagon() uses
+        const double apothem = std::max(std::fabs(vtx.X()), (std::fabs(vtx.X()) + std::sqrt(3.) * std::fabs(vtx.Y()))/2.);
+
+        for(const auto& selection: fSelections)
+        {
+          if(z + fEnvelope.vertex < selection.zMin || z - fEnvelope.vertex > selection.zMax) continue;
+          if(apothem - fEnvelope.vertex > selection.apothem * (1 + 1e-9)) continue; //Leave the boundary to the cut itself
+          if(thetaMu - fEnvelope.thetaMu >= selection.thetaMax) continue;
+          if(vertexFixed && std::any_of(selection.targets.begin(), selection.targets.end(),
+                                        [&cvUniv](const std::pair<int, bool>& target) { return util::getTgtCode(&cvUniv, false, target.second) != target.first; })) continue;
+          return true;
+        }
+
+        ++fNSkipped;
+        return false;
+      }
+
+      long long NSkipped() const { return fNSkipped; }
+
+    private:
+      //Every cut that the pre-filter knows about in one selection
+      struct Selection
+      {
+        double zMin = -std::numeric_limits<double>::infinity(), zMax = std::numeric_limits<double>::infinity();
+        double apothem = std::numeric_limits<double>::infinity();
+        double thetaMax = std::numeric_limits<double>::infinity();
+        std::vector<std::pair<int, bool>> targets; //Target code and whether it uses the extended target
+      };
+
+      LateralShift fEnvelope;
+      std::vector<Selection> fSelections;
+      std::vector<int> fSidebandTargets;
+      long long fNSkipped = 0;
+  };
+}
+
+#endif //UTIL_SHIFTPREFILTER_H
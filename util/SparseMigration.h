@@ -0,0 +1,430 @@
+//File: SparseMigration.h
+//Brief: A migration matrix that only stores the cells that were filled, separately for each systematic universe.
+//       Most reco/truth cells of a migration matrix are empty, and the 4D response for 2D variables is even
+//       sparser, but a dense MnvH2D keeps every cell for every universe.  A SparseMigration is filled in the
+//       event loop, written as a TTree of the non-empty cells, and only turned back into the dense MnvH2D or
+//       MnvResponse that MnvUnfold wants when the cross section extraction reads it with GetMigration() or
+//       GetMigrationObjects().  Both of those also read the dense objects in older files.
+
+#ifndef UTIL_SPARSEMIGRATION_H
+#define UTIL_SPARSEMIGRATION_H
+
+//util includes
+#include "util/GetIngredient.h"
+
+//PlotUtils includes
+#include "PlotUtils/MnvH2D.h"
+#include "MinervaUnfold/MnvResponse.h"
+
+//ROOT includes
+#include "TH1.h"
+#include "TH2D.h"
+#include "TTree.h"
+#include "TNamed.h"
+#include "TDirectory.h"
+#include "TDirectoryFile.h"
+
+//c++ includes
+#include <string>
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include <memory>
+#include <sstream>
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+
+namespace util
+{
+  class SparseMigration
+  {
+    public:
+      //One cell's sum of weights and sum of squared weights, like a TH1 with Sumw2()
+      struct Cell
+      {
+        double sumw = 0;
+        double sumw2 = 0;
+      };
+
+      //recoBinning and truthBinning are TH1Ds for 1D variables and TH2Ds for 2D variables.  They're copied.
+      //Universes are numbered like in a Hist2DWrapper: by band in the order of error_bands, cv included.  Bands
+      //are lateral if their first universe isn't IsVerticalOnly(), also like in a Hist2DWrapper.
+      template <class UNIVERSE>
+      SparseMigration(const std::string& name, const TH1& recoBinning, const TH1& truthBinning,
+                      const std::map<std::string, std::vector<UNIVERSE*>>& error_bands): SparseMigration(name, recoBinning, truthBinning)
+      {
+        for(const auto& band: error_bands)
+        {
+          //MnvResponse names its error bands after the universes' ShortName()s instead of the keys in error_bands
+          const bool lateral = (band.first != "cv") && !band.second.front()->IsVerticalOnly();
+          fBands.push_back(Band{band.first, band.second.front()->ShortName(), static_cast<int>(band.second.size()), lateral});
+          for(size_t whichUniv = 0; whichUniv < band.second.size(); ++whichUniv)
+          {
+            if(band.first == "cv") fCVIndex = fCells.size();
+            fUniverseIndex[band.second[whichUniv]] = fCells.size();
+            fCells.emplace_back();
+          }
+        }
+      }
+
+      //Same arguments as Hist2DWrapper::FillUniverse() for 1D variables
+      template <class UNIVERSE>
+      void FillUniverse(const UNIVERSE* univ, const double reco, const double truth, const double weight)
+      {
+        Fill(fUniverseIndex.at(univ), fRecoBinning->FindBin(reco), fTruthBinning->FindBin(truth), weight);
+      }
+
+      //Same arguments as MnvResponse::Fill() for 2D variables.  Only fills the CV just like MnvResponse::Fill().
+      void Fill(const double recoX, const double recoY, const double truthX, const double truthY, const double weight)
+      {
+        Fill(fCVIndex, fRecoBinning->FindBin(recoX, recoY), fTruthBinning->FindBin(truthX, truthY), weight);
+      }
+
+      //name is the name of the dense object this replaces, like pTmu_migration
+      void Write(TDirectory& dir) const
+      {
+        dir.cd();
+        dir.WriteTObject(fRecoBinning.get(), (fName + "_sparse_recoBinning").c_str());
+        dir.WriteTObject(fTruthBinning.get(), (fName + "_sparse_truthBinning").c_str());
+
+        std::stringstream bands;
+        for(const auto& band: fBands) bands << band.name << ":" << band.shortName << ":" << band.nUniverses << ":" << (band.lateral ? lateralTag : verticalTag) << ",";
+        TNamed bandList((fName + "_sparse_bands").c_str(), bands.str().c_str());
+        bandList.Write();
+
+        int universe, reco, truth;
+        double sumw, sumw2;
+        TTree cells((fName + "_sparse").c_str(), "Non-empty migration cells for each universe");
+        cells.SetDirectory(&dir);
+        cells.Branch("universe", &universe);
+        cells.Branch("reco", &reco);
+        cells.Branch("truth", &truth);
+        cells.Branch("sumw", &sumw);
+        cells.Branch("sumw2", &sumw2);
+        for(universe = 0; universe < static_cast<int>(fCells.size()); ++universe)
+        {
+          for(const auto& cell: fCells[universe])
+          {
+            reco = cell.first / fNTruthCells;
+            truth = cell.first % fNTruthCells;
+            sumw = cell.second.sumw;
+            sumw2 = cell.second.sumw2;
+            cells.Fill();
+          }
+        }
+        cells.Write();
+        cells.SetDirectory(nullptr);
+      }
+
+      //Read back a SparseMigration that Write() put in dir
+      static std::unique_ptr<SparseMigration> Read(TDirectoryFile& dir, const std::string& name)
+      {
+        std::unique_ptr<SparseMigration> migration(new SparseMigration(name, *GetIngredient<TH1>(dir, name + "_sparse_recoBinning"),
+                                                                       *GetIngredient<TH1>(dir, name + "_sparse_truthBinning")));
+
+        std::stringstream bands(GetIngredient<TNamed>(dir, name + "_sparse_bands")->GetTitle());
+        std::string band;
+        while(std::getline(bands, band, ','))
+        {
+          //Files from before lateral bands were kept apart don't say what kind each band is.  Their bands were all vertical.
+          bool lateral = false;
+          const size_t kind = band.rfind(':');
+          if(kind != std::string::npos && (band.substr(kind + 1) == lateralTag || band.substr(kind + 1) == verticalTag))
+          {
+            lateral = (band.substr(kind + 1) == lateralTag);
+            band.erase(kind);
+          }
+
+          const size_t first = band.find(':'), last = band.rfind(':');
+          if(first == std::string::npos || first == last) throw std::runtime_error("Malformed error band list for " + name + " in " + dir.GetName());
+          migration->fBands.push_back(Band{band.substr(0, first), band.substr(first + 1, last - first - 1), std::stoi(band.substr(last + 1)), lateral});
+          if(migration->fBands.back().name == "cv") migration->fCVIndex = migration->fCells.size();
+          migration->fCells.resize(migration->fCells.size() + migration->fBands.back().nUniverses);
+        }
+
+        auto cells = GetIngredient<TTree>(dir, name + "_sparse");
+        int universe, reco, truth;
+        double sumw, sumw2;
+        cells->SetBranchAddress("universe", &universe);
+        cells->SetBranchAddress("reco", &reco);
+        cells->SetBranchAddress("truth", &truth);
+        cells->SetBranchAddress("sumw", &sumw);
+        cells->SetBranchAddress("sumw2", &sumw2);
+        for(Long64_t entry = 0; entry < cells->GetEntries(); ++entry)
+        {
+          cells->GetEntry(entry);
+          //A merged file can have the same cell more than once
+          auto& cell = migration->fCells.at(universe)[static_cast<long>(reco) * migration->fNTruthCells + truth];
+          cell.sumw += sumw;
+          cell.sumw2 += sumw2;
+        }
+        cells->ResetBranchAddresses();
+
+        return migration;
+      }
+
+      //Adds the error bands in other that this doesn't have yet, like from a job that only ran some of the systematics
+      void AddMissingBands(const SparseMigration& other)
+      {
+        size_t otherUniverse = 0;
+        for(const auto& band: other.fBands)
+        {
+          if(std::none_of(fBands.begin(), fBands.end(), [&band](const Band& mine) { return mine.name == band.name; }))
+          {
+            fBands.push_back(band);
+            fCells.insert(fCells.end(), other.fCells.begin() + otherUniverse, other.fCells.begin() + otherUniverse + band.nUniverses);
+          }
+          otherUniverse += band.nUniverses;
+        }
+      }
+
+      //The MnvH2D, with reco on the x axis and truth on the y axis, that a Hist2DWrapper would have made for a 1D variable
+      PlotUtils::MnvH2D* ToMnvH2D() const
+      {
+        if(fRecoBinning->GetDimension() != 1) throw std::runtime_error(fName + " is the migration for a 2D variable.  Use ToMigrationObjects() instead.");
+
+        const auto recoEdges = binEdges(*fRecoBinning->GetXaxis()), truthEdges = binEdges(*fTruthBinning->GetXaxis());
+        TH2D cv(fName.c_str(), fRecoBinning->GetTitle(), recoEdges.size() - 1, recoEdges.data(), truthEdges.size() - 1, truthEdges.data());
+        cv.Sumw2();
+        FillDense(cv, fCells.at(fCVIndex));
+
+        auto migration = new PlotUtils::MnvH2D(cv);
+        migration->SetDirectory(nullptr);
+        size_t firstUniverse = 0;
+        for(const auto& band: fBands)
+        {
+          if(band.name != "cv")
+          {
+            if(band.lateral) migration->AddLatErrorBand(band.name, band.nUniverses);
+            else migration->AddVertErrorBand(band.name, band.nUniverses);
+            for(int whichUniv = 0; whichUniv < band.nUniverses; ++whichUniv)
+            {
+              auto& universe = UniverseHist(*migration, band, band.name, whichUniv);
+              universe.Reset(); //Only the cells this universe filled
+              FillDense(universe, fCells.at(firstUniverse + whichUniv));
+            }
+          }
+          firstUniverse += band.nUniverses;
+        }
+        return migration;
+      }
+
+      //The same migration, reco, and truth MnvH2Ds that MnvResponse::GetMigrationObjects() makes for a 2D variable.
+      //MnvResponse only provides the objects' names, binning, and error bands.  Every universe's bin contents and
+      //errors are copied from its sums of weights and squared weights, so nothing is refilled or approximated.
+      void ToMigrationObjects(PlotUtils::MnvH2D*& migration, PlotUtils::MnvH2D*& reco, PlotUtils::MnvH2D*& truth) const
+      {
+        if(fRecoBinning->GetDimension() != 2) throw std::runtime_error(fName + " is the migration for a 1D variable.  Use ToMnvH2D() instead.");
+
+        //MnvResponse makes the vertical error bands.  The lateral ones are added like a Hist2DWrapper would.
+        std::map<const std::string, int> response_bands;
+        for(const auto& band: fBands)
+        {
+          if(!band.lateral) response_bands[band.shortName] = band.nUniverses;
+        }
+
+        const auto migrationXBins = ProbeMigrationAxis(true), migrationYBins = ProbeMigrationAxis(false);
+        MinervaUnfold::MnvResponse response(ResponseName().c_str(), ResponseName().c_str(),
+                                            binEdges(*fRecoBinning->GetXaxis()), binEdges(*fRecoBinning->GetYaxis()), response_bands);
+        response.GetMigrationObjects(migration, reco, truth);
+        migration->SetDirectory(nullptr);
+        reco->SetDirectory(nullptr);
+        truth->SetDirectory(nullptr);
+        for(const auto& band: fBands)
+        {
+          if(!band.lateral) continue;
+          for(auto hist: {migration, reco, truth})
+          {
+            hist->AddLatErrorBand(band.shortName, band.nUniverses);
+            for(int whichUniv = 0; whichUniv < band.nUniverses; ++whichUniv) UniverseHist(*hist, band, band.shortName, whichUniv).Reset();
+          }
+        }
+
+        size_t firstUniverse = 0;
+        for(const auto& band: fBands)
+        {
+          for(int whichUniv = 0; whichUniv < band.nUniverses; ++whichUniv)
+          {
+            TH2D& universeMigration = UniverseHist(*migration, band, band.shortName, whichUniv);
+            TH2D& universeReco = UniverseHist(*reco, band, band.shortName, whichUniv);
+            TH2D& universeTruth = UniverseHist(*truth, band, band.shortName, whichUniv);
+
+            for(const auto& cell: fCells.at(firstUniverse + whichUniv))
+            {
+              const long recoCell = cell.first / fNTruthCells, truthCell = cell.first % fNTruthCells;
+              AddToBin(universeReco, recoCell, cell.second);
+              AddToBin(universeTruth, truthCell, cell.second);
+              if(migrationXBins[recoCell] >= 0 && migrationYBins[truthCell] >= 0)
+              {
+                AddToBin(universeMigration, universeMigration.GetBin(migrationXBins[recoCell], migrationYBins[truthCell]), cell.second);
+              }
+            }
+          }
+          firstUniverse += band.nUniverses;
+        }
+      }
+
+    private:
+      struct Band
+      {
+        std::string name;
+        std::string shortName;
+        int nUniverses;
+        bool lateral;
+      };
+
+      //What each band in the _sparse_bands list is
+      static constexpr const char* lateralTag = "lateral";
+      static constexpr const char* verticalTag = "vertical";
+
+      SparseMigration(const std::string& name, const TH1& recoBinning, const TH1& truthBinning): fName(name),
+                                                                                                   fRecoBinning(static_cast<TH1*>(recoBinning.Clone())),
+                                                                                                   fTruthBinning(static_cast<TH1*>(truthBinning.Clone())),
+                                                                                                   fNTruthCells(truthBinning.GetNcells()), fCVIndex(0)
+      {
+        fRecoBinning->SetDirectory(nullptr);
+        fRecoBinning->Reset();
+        fTruthBinning->SetDirectory(nullptr);
+        fTruthBinning->Reset();
+      }
+
+      void Fill(const size_t universe, const int recoCell, const int truthCell, const double weight)
+      {
+        auto& cell = fCells[universe][static_cast<long>(recoCell) * fNTruthCells + truthCell];
+        cell.sumw += weight;
+        cell.sumw2 += weight * weight;
+      }
+
+      //Copy sparse cells into a TH2D with reco on the x axis and truth on the y axis
+      void FillDense(TH1& dense, const std::unordered_map<long, Cell>& cells) const
+      {
+        for(const auto& cell: cells)
+        {
+          const int bin = dense.GetBin(cell.first / fNTruthCells, cell.first % fNTruthCells);
+          dense.SetBinContent(bin, cell.second.sumw);
+          dense.SetBinError(bin, std::sqrt(cell.second.sumw2));
+        }
+      }
+
+      //The CV itself for the cv band.  bandName is what hist calls the band.
+      static TH2D& UniverseHist(PlotUtils::MnvH2D& hist, const Band& band, const std::string& bandName, const int whichUniv)
+      {
+        if(band.name == "cv") return hist;
+        if(band.lateral) return *hist.GetLatErrorBand(bandName)->GetHist(whichUniv);
+        return *hist.GetVertErrorBand(bandName)->GetHist(whichUniv);
+      }
+
+      static std::vector<double> binEdges(const TAxis& axis)
+      {
+        std::vector<double> edges;
+        for(int bin = 1; bin <= axis.GetNbins() + 1; ++bin) edges.push_back(axis.GetBinLowEdge(bin));
+        return edges;
+      }
+
+      //Drop the "_migration" suffix because MnvResponse adds it back
+      std::string ResponseName() const
+      {
+        return fName.substr(0, fName.rfind("_migration"));
+      }
+
+      static void AddToBin(TH1& hist, const int bin, const Cell& cell)
+      {
+        const double error = hist.GetBinError(bin);
+        hist.SetBinContent(bin, hist.GetBinContent(bin) + cell.sumw);
+        hist.SetBinError(bin, std::sqrt(error * error + cell.sumw2));
+      }
+
+      //Which bin on the x (reco) or y (truth) axis of MnvResponse's migration matrix each reco or truth cell goes in, or
+      //-1 if MnvResponse leaves that cell out, like under/overflow when RooUnfold doesn't use it.  Fills an MnvResponse
+      //once per cell with the cell's number + 1 as the weight, so each weight says which cell it came from.  The other
+      //axis always gets the first bin.  Also makes sure that the reco or truth histogram uses the same bins as the cells.
+      std::vector<int> ProbeMigrationAxis(const bool isReco) const
+      {
+        const TH1& binning = isReco ? *fRecoBinning : *fTruthBinning;
+        const TH1& other = isReco ? *fTruthBinning : *fRecoBinning;
+        const int otherCell = other.GetBin(1, 1);
+        int x, y, z;
+        other.GetBinXYZ(otherCell, x, y, z);
+        const double otherX = binValue(*other.GetXaxis(), x), otherY = binValue(*other.GetYaxis(), y);
+
+        std::map<const std::string, int> noBands;
+        MinervaUnfold::MnvResponse probe(ResponseName().c_str(), ResponseName().c_str(),
+                                         binEdges(*fRecoBinning->GetXaxis()), binEdges(*fRecoBinning->GetYaxis()), noBands);
+        for(int cell = 0; cell < binning.GetNcells(); ++cell)
+        {
+          binning.GetBinXYZ(cell, x, y, z);
+          const double cellX = binValue(*binning.GetXaxis(), x), cellY = binValue(*binning.GetYaxis(), y);
+          if(isReco) probe.Fill(cellX, cellY, otherX, otherY, cell + 1);
+          else probe.Fill(otherX, otherY, cellX, cellY, cell + 1);
+        }
+
+        PlotUtils::MnvH2D *migration = nullptr, *reco = nullptr, *truth = nullptr;
+        probe.GetMigrationObjects(migration, reco, truth);
+        std::unique_ptr<PlotUtils::MnvH2D> ownMigration(migration), ownReco(reco), ownTruth(truth);
+        const TH1& projection = isReco ? *reco : *truth;
+        if(projection.GetNcells() != binning.GetNcells()) throw std::runtime_error("MnvResponse doesn't bin " + fName + " the way it was filled");
+
+        std::vector<int> axisBins(binning.GetNcells(), -1);
+        for(int cell = 0; cell < binning.GetNcells(); ++cell)
+        {
+          if(std::fabs(projection.GetBinContent(cell) - (cell + 1)) > 0.5) throw std::runtime_error("MnvResponse doesn't bin " + fName + " the way it was filled");
+        }
+        for(int bin = 0; bin < migration->GetNcells(); ++bin)
+        {
+          const long cell = std::lround(migration->GetBinContent(bin)) - 1;
+          if(cell < 0) continue;
+          if(cell >= binning.GetNcells() || axisBins[cell] != -1) throw std::runtime_error("MnvResponse combined cells of " + fName + " in its migration matrix");
+          migration->GetBinXYZ(bin, x, y, z);
+          axisBins[cell] = isReco ? x : y;
+        }
+        return axisBins;
+      }
+
+      //A value that falls in bin, including the underflow and overflow bins
+      static double binValue(const TAxis& axis, const int bin)
+      {
+        if(bin == 0) return axis.GetXmin() - 1.;
+        if(bin > axis.GetNbins()) return axis.GetXmax() + 1.;
+        return axis.GetBinCenter(bin);
+      }
+
+      std::string fName;
+      std::unique_ptr<TH1> fRecoBinning;
+      std::unique_ptr<TH1> fTruthBinning;
+      long fNTruthCells; //Including under/overflow
+
+      std::vector<Band> fBands;
+      size_t fCVIndex;
+      std::unordered_map<const void*, size_t> fUniverseIndex;
+
+      //Non-empty cells for each universe.  Key is reco cell * fNTruthCells + truth cell.
+      std::vector<std::unordered_map<long, Cell>> fCells;
+  };
+
+  //Get a 1D variable's migration MnvH2D from either the dense or the SparseMigration format
+  inline PlotUtils::MnvH2D* GetMigration(TDirectoryFile& dir, const std::string& name)
+  {
+    if(dir.Get(name.c_str())) return GetIngredient<PlotUtils::MnvH2D>(dir, name);
+    return SparseMigration::Read(dir, name)->ToMnvH2D();
+  }
+
+  inline PlotUtils::MnvH2D* GetMigration(TDirectoryFile& dir, const std::string& name, const std::string& prefix)
+  {
+    return GetMigration(dir, prefix + "_" + name);
+  }
+
+  //Get a 2D variable's migration, reco, and truth MnvH2Ds from either the dense or the SparseMigration format
+  inline void GetMigrationObjects(TDirectoryFile& dir, const std::string& prefix, PlotUtils::MnvH2D*& migration, PlotUtils::MnvH2D*& reco, PlotUtils::MnvH2D*& truth)
+  {
+    if(dir.Get((prefix + "_migration").c_str()))
+    {
+      migration = GetIngredient<PlotUtils::MnvH2D>(dir, "migration", prefix);
+      reco = GetIngredient<PlotUtils::MnvH2D>(dir, "reco", prefix);
+      truth = GetIngredient<PlotUtils::MnvH2D>(dir, "truth", prefix);
+    }
+    else SparseMigration::Read(dir, prefix + "_migration")->ToMigrationObjects(migration, reco, truth);
+  }
+}
+
+#endif //UTIL_SPARSEMIGRATION_H
@@ -0,0 +1,250 @@
+//File: TrackerAnalysis.h
+//Brief: The active tracker analysis from runEventLoopTracker: its cuts, its variables, and how they're filled and
+//       written for each daisy petal.  runEventLoopTracker runs it on its own.  runEventLoopTargets --tracker runs
+//       it alongside the nuclear targets so that both analyses share each read of the AnaTuples.
+
+#ifndef UTIL_TRACKERANALYSIS_H
+#define UTIL_TRACKERANALYSIS_H
+
+//util includes
+#include "util/Variable.h"
+#include "util/Variable2D.h"
+#include "util/NukeUtils.h"
+#include "util/GetFluxIntegral.h"
+
+//PlotUtils includes
+#include "PlotUtils/Cutter.h"
+#include "PlotUtils/TargetUtils.h"
+#include "PlotUtils/MnvH1D.h"
+#include "PlotUtils/MnvH2D.h"
+
+//ROOT includes
+#include "TFile.h"
+#include "TNamed.h"
+#include "TParameter.h"
+
+//c++ includes
+#include <vector>
+#include <string>
+#include <map>
+#include <memory>
+#include <functional>
+#include <cmath>
+
+namespace util
+{
+  inline PlotUtils::Cutter<CVUniverse, MichelEvent>::reco_t GetTrackerPreCuts(const int nupdg)
+  {
+    auto preCuts = util::GetAnalysisCuts(nupdg);
+    preCuts.emplace_back(new reco::ZRangeANN<CVUniverse, MichelEvent>("Z pos in active tracker", PlotUtils::TargetProp::Tracker::Face, PlotUtils::TargetProp::Tracker::Back));
+    return preCuts;
+  }
+
+  inline std::unique_ptr<PlotUtils::Cutter<CVUniverse, MichelEvent>> GetTrackerCuts(const int nupdg)
+  {
+    PlotUtils::Cutter<CVUniverse, MichelEvent>::reco_t sidebands, preCuts;
+    PlotUtils::Cutter<CVUniverse, MichelEvent>::truth_t signalDefinition, phaseSpace;
+
+    preCuts = GetTrackerPreCuts(nupdg);
+
+    if(nupdg > 0) signalDefinition.emplace_back(new truth::IsNeutrino<CVUniverse>());
+    else if(nupdg < 0) signalDefinition.emplace_back(new truth::IsAntiNeutrino<CVUniverse>());
+    signalDefinition.emplace_back(new truth::IsCC<CVUniverse>());
+
+    phaseSpace = util::GetPhaseSpace();
+    phaseSpace.emplace_back(new truth::ZRange<CVUniverse>("Z pos in active tracker", PlotUtils::TargetProp::Tracker::Face, PlotUtils::TargetProp::Tracker::Back));
+
+    return std::unique_ptr<PlotUtils::Cutter<CVUniverse, MichelEvent>>(new PlotUtils::Cutter<CVUniverse, MichelEvent>(std::move(preCuts), std::move(sidebands), std::move(signalDefinition), std::move(phaseSpace)));
+  }
+
+  //Daisy petal of the ANN vertex for selected events and of the true vertex for the efficiency denominator
+  inline int GetRecoDaisyPetal(const CVUniverse& univ)
+  {
+    static PlotUtils::TargetUtils targetInfo;
+    return targetInfo.GetDaisyPetal(univ.GetANNVertex().X(), univ.GetANNVertex().Y());
+  }
+
+  inline int GetTrueDaisyPetal(const CVUniverse& univ)
+  {
+    static PlotUtils::TargetUtils targetInfo;
+    return targetInfo.GetDaisyPetal(univ.GetTrueVertex().X(), univ.GetTrueVertex().Y());
+  }
+
+  //Every histogram the tracker analysis fills for one daisy petal.  The histograms belong to the output files once
+  //they're written, so make a new TrackerHists for each set of outputs.
+  class TrackerHists
+  {
+    public:
+      TrackerHists(const int petal): fPetal(petal)
+      {
+        std::vector<double> segmentBins, angleBins;
+        const double numsegments = 180;
+        for(double whichBin = 0; whichBin < numsegments; whichBin++) segmentBins.push_back(whichBin - 0.5);
+
+        const double nAngleBins = 170;
+        for(double whichBin = 0; whichBin < nAngleBins+1; whichBin++) angleBins.push_back(0.1*whichBin);
+
+        std::function<double(const CVUniverse&)> q0TrueGeV = [](const CVUniverse& univ) { return univ.Getq0True()/1000; };
+        std::function<double(const CVUniverse&)> muonAngleDegrees = [](const CVUniverse& univ) { return (univ.GetThetamu() * 180 / M_PI); };
+        std::function<double(const CVUniverse&)> muonAngleDegreesTruth = [](const CVUniverse& univ) { return (univ.GetDouble("truth_muon_theta")* 180 / M_PI); };
+
+        vars.push_back(new Variable("pTmu", "p_{T, #mu} [GeV/c]", util::PTBins, &CVUniverse::GetANNMuonPTGeV, &CVUniverse::GetMuonPTTrue));
+        vars.push_back(new Variable("pZmu", "p_{||, #mu} [GeV/c]", util::PzBins, &CVUniverse::GetANNMuonPzGeV, &CVUniverse::GetMuonPzTrue));
+        vars.push_back(new Variable("Emu", "E_{#mu} [GeV]", util::EmuBins, &CVUniverse::GetANNEmuGeV, &CVUniverse::GetElepTrueGeV));
+        vars.push_back(new Variable("Erecoil", "E_{recoil} [GeV]", util::Erecoilbins, &CVUniverse::GetANNRecoilEGeV, q0TrueGeV)); //TODO: q0 is not the same as recoil energy without a spline correction
+        vars.push_back(new Variable("BjorkenX", "X", util::bjorkenXbins, &CVUniverse::GetBjorkenX, &CVUniverse::GetBjorkenXTrue));
+        vars.push_back(new Variable("BjorkenY", "Y", util::bjorkenYbins, &CVUniverse::GetBjorkenY, &CVUniverse::GetBjorkenYTrue));
+        vars.push_back(new Variable("segment", "segmentNum", segmentBins, &CVUniverse::GetANNSegment, &CVUniverse::GetTruthSegment)); //Just used for plotting events by detector position - not for any actual physics
+        vars.push_back(new Variable("beamAngle", "Angle", angleBins, muonAngleDegrees, muonAngleDegreesTruth)); //Neutrino angle
+        vars2D.push_back(new Variable2D("pTmu_pZmu", *vars[0], *vars[1]));
+        vars2D.push_back(new Variable2D("Emu_Erecoil", *vars[2], *vars[3]));
+        vars2D.push_back(new Variable2D("BjorkenX_BjorkenY", *vars[4], *vars[5]));
+      }
+
+      TrackerHists(const TrackerHists&) = delete;
+      TrackerHists& operator=(const TrackerHists&) = delete;
+
+      ~TrackerHists()
+      {
+        for(auto var: vars2D) delete var;
+        for(auto var: vars) delete var;
+      }
+
+      int Petal() const { return fPetal; }
+
+      void InitializeHists(std::map<std::string, std::vector<CVUniverse*>>& error_bands,
+                           std::map<std::string, std::vector<CVUniverse*>>& truth_bands,
+                           std::vector<CVUniverse*>& data_band)
+      {
+        for(auto& var: vars) var->InitializeMCHists(error_bands, truth_bands);
+        for(auto& var: vars) var->InitializeDATAHists(data_band);
+
+        for(auto& var: vars2D) var->InitializeMCHists(error_bands, truth_bands);
+        for(auto& var: vars2D) var->InitializeDATAHists(data_band);
+      }
+
+      //An MC event that passed the tracker cuts in this petal
+      void FillSelected(CVUniverse* universe, const bool isSignal, const double weight)
+      {
+        for(auto& var: vars)
+        {
+          var->selectedMCReco->FillUniverse(universe, var->GetRecoValue(*universe), weight); //"Fake data" for closure
+          (*var->m_intChannels)[universe->GetInteractionType()].FillUniverse(universe, var->GetRecoValue(*universe), weight);
+        }
+        for(auto& var: vars2D)
+        {
+          var->selectedMCReco->FillUniverse(universe, var->GetRecoValueX(*universe), var->GetRecoValueY(*universe), weight); //"Fake data" for closure
+          (*var->m_intChannels)[universe->GetInteractionType()].FillUniverse(universe, var->GetRecoValueX(*universe), var->GetRecoValueY(*universe), weight);
+        }
+
+        if(isSignal)
+        {
+          for(auto& var: vars)
+          {
+            //Cross section components
+            var->efficiencyNumerator->FillUniverse(universe, var->GetTrueValue(*universe), weight);
+            var->migration->FillUniverse(universe, var->GetRecoValue(*universe), var->GetTrueValue(*universe), weight);
+            var->selectedSignalReco->FillUniverse(universe, var->GetRecoValue(*universe), weight); //Efficiency numerator in reco variables.  Useful for warping studies.
+          }
+          for(auto& var: vars2D)
+          {
+            var->efficiencyNumerator->FillUniverse(universe, var->GetTrueValueX(*universe), var->GetTrueValueY(*universe), weight);
+            var->migration->Fill(var->GetRecoValueX(*universe), var->GetRecoValueY(*universe), var->GetTrueValueX(*universe), var->GetTrueValueY(*universe), weight);
+            var->selectedSignalReco->FillUniverse(universe, var->GetRecoValueX(*universe), var->GetRecoValueY(*universe), weight); //Efficiency numerator in reco variables.  Useful for warping studies.
+          }
+        }
+        else
+        {
+          int bkgd_ID = -1;
+          if(universe->GetCurrent() == 2) bkgd_ID = 0;
+          else if(universe->GetTruthNuPDG() == -14) bkgd_ID = 1;
+          for(auto& var: vars) (*var->m_backgroundHists)[bkgd_ID].FillUniverse(universe, var->GetRecoValue(*universe), weight);
+          for(auto& var: vars2D) (*var->m_backgroundHists)[bkgd_ID].FillUniverse(universe, var->GetRecoValueX(*universe), var->GetRecoValueY(*universe), weight);
+        }
+      }
+
+      //A data event that passed the tracker cuts in this petal
+      void FillData(CVUniverse* universe, const MichelEvent& event)
+      {
+        for(auto& var: vars) var->dataHist->FillUniverse(universe, var->GetRecoValue(*universe, event.m_idx), 1);
+        for(auto& var: vars2D) var->dataHist->FillUniverse(universe, var->GetRecoValueX(*universe), var->GetRecoValueY(*universe), 1);
+      }
+
+      //A truth event in the tracker's efficiency denominator in this petal
+      void FillEffDenom(CVUniverse* universe, const double weight)
+      {
+        for(auto var: vars)
+        {
+          var->efficiencyDenominator->FillUniverse(universe, var->GetTrueValue(*universe), weight);
+          (*var->m_intChannelsEffDenom)[universe->GetInteractionType()].FillUniverse(universe, var->GetTrueValue(*universe), weight);
+        }
+        for(auto var: vars2D)
+        {
+          var->efficiencyDenominator->FillUniverse(universe, var->GetTrueValueX(*universe), var->GetTrueValueY(*universe), weight);
+          (*var->m_intChannelsEffDenom)[universe->GetInteractionType()].FillUniverse(universe, var->GetTrueValueX(*universe), var->GetTrueValueY(*universe), weight);
+        }
+      }
+
+      //cvUniv is the MC "cv" universe for the flux integrals
+      void WriteMC(TFile& file, const std::string& playlist, const double pot, const CVUniverse& cvUniv)
+      {
+        for(auto& var: vars) var->WriteMC(file);
+        for(auto& var: vars2D) var->WriteMC(file);
+
+        //Playlist name - Used for flux calculations later on
+        TNamed playlistStr("PlaylistUsed", playlist.c_str());
+        file.WriteTObject(&playlistStr);
+        //Protons On Target
+        TParameter<double> mcPOT("POTUsed", pot);
+        file.WriteTObject(&mcPOT);
+
+        //Always use MC number of nucleons for cross section
+        PlotUtils::TargetUtils targetInfo;
+        const double nNucleons = targetInfo.GetTrackerNNucleons(PlotUtils::TargetProp::Tracker::Face, PlotUtils::TargetProp::Tracker::Back, true, util::apothem);
+        for(const auto& var: vars)
+        {
+          std::unique_ptr<PlotUtils::MnvH1D> fluxIntegral(util::GetFluxIntegral(cvUniv, var->efficiencyNumerator->hist));
+          file.WriteTObject(fluxIntegral.get(), (var->GetName() + "_reweightedflux_integrated").c_str());
+          TParameter<double> nucleons((var->GetName() + "_fiducial_nucleons").c_str(), nNucleons);
+          file.WriteTObject(&nucleons);
+        }
+        for(const auto& var: vars2D)
+        {
+          std::unique_ptr<PlotUtils::MnvH2D> fluxIntegral(util::GetFluxIntegral(cvUniv, var->efficiencyNumerator->hist));
+          file.WriteTObject(fluxIntegral.get(), (var->GetName() + "_reweightedflux_integrated").c_str());
+          TParameter<double> nucleons((var->GetName() + "_fiducial_nucleons").c_str(), nNucleons);
+          file.WriteTObject(&nucleons);
+        }
+      }
+
+      void WriteData(TFile& file, const std::string& playlist, const double pot)
+      {
+        for(auto& var: vars) var->WriteData(file);
+        for(auto& var: vars2D) var->WriteData(file);
+
+        TNamed playlistStr("PlaylistUsed", playlist.c_str());
+        file.WriteTObject(&playlistStr);
+        TParameter<double> dataPOT("POTUsed", pot);
+        file.WriteTObject(&dataPOT);
+      }
+
+      //2D migrations go in their own file because they're huge
+      void WriteMigration(TFile& file)
+      {
+        for(auto& var: vars2D) var->WriteMigration(file);
+      }
+
+    private:
+      const int fPetal;
+      std::vector<Variable*> vars;
+      std::vector<Variable2D*> vars2D;
+  };
+
+  //Output file name for one petal.  subrun is the grid process number when the playlists were broken up.
+  inline std::string TrackerOutFileName(const std::string& base, const int petal, const std::string& suffix, const int subrun = -1)
+  {
+    return base + "_petal_" + std::to_string(petal) + suffix + (subrun < 0 ? "" : "_n" + std::to_string(subrun)) + ".root";
+  }
+}
+
+#endif //UTIL_TRACKERANALYSIS_H
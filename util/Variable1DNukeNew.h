@@ -4,7 +4,8 @@
 //Includes from this package
 #include "event/CVUniverse.h"
 #include "util/SafeROOTName.h"
-#include "util/Categorized.h"
+#include "util/LazyCategorized.h"
+#include "util/SparseMigration.h"
 
 //PlotUtils includes
 #include "PlotUtils/VariableBase.h"
@@ -28,15 +29,15 @@ class Variable1DNuke: public PlotUtils::VariableBase<CVUniverse>
                            std::map<std::string, std::vector<CVUniverse*>>& truth_error_bands)
     {
       
-      m_backgroundHists = new util::Categorized<Hist, int>((GetName() + "_background").c_str(),
+      m_backgroundHists = new util::LazyCategorized<Hist, int>((GetName() + "_background").c_str(),
 							   GetName().c_str(), util::BKGLabelsWithPlasticSidebands,
 							   GetBinVec(), mc_error_bands);
 
-      m_intChannelsEffDenom = new util::Categorized<Hist, int>((GetName() + "_efficiency_denominator_intChannels"),
+      m_intChannelsEffDenom = new util::LazyCategorized<Hist, int>((GetName() + "_efficiency_denominator_intChannels"),
               GetName().c_str(), util::GENIELabels,
               GetBinVec(), truth_error_bands);
 
-      m_interactionTypeHists = new util::Categorized<Hist, int>((GetName() + "_intType").c_str(),
+      m_interactionTypeHists = new util::LazyCategorized<Hist, int>((GetName() + "_intType").c_str(),
         GetName().c_str(), util::GENIELabels,
         GetBinVec(), mc_error_bands);
 
@@ -44,43 +45,48 @@ class Variable1DNuke: public PlotUtils::VariableBase<CVUniverse>
       efficiencyDenominator = new Hist((GetName() + "_efficiency_denominator").c_str(), GetName().c_str(), GetBinVec(), truth_error_bands);
       selectedSignalReco = new Hist((GetName() + "_selected_signal_reco").c_str(), GetName().c_str(), GetBinVec(), mc_error_bands);
       selectedMCReco = new Hist((GetName() + "_selected_mc_reco").c_str(), GetName().c_str(), GetBinVec(), mc_error_bands);
-      migration = new PlotUtils::Hist2DWrapper<CVUniverse>((GetName() + "_migration").c_str(), GetName().c_str(), GetBinVec(), GetBinVec(), mc_error_bands);
+      const auto bins = GetBinVec();
+      const TH1D binning(GetName().c_str(), GetName().c_str(), bins.size() - 1, bins.data());
+      migration = new util::SparseMigration(GetName() + "_migration", binning, binning, mc_error_bands);
     
-      m_sidebandHistSetUSMC = new util::Categorized<Hist, int>((GetName() + "_US_sideband").c_str(),
+      m_sidebandHistSetUSMC = new util::LazyCategorized<Hist, int>((GetName() + "_US_sideband").c_str(),
               GetName().c_str(), util::SidebandCategories,
               GetBinVec(), mc_error_bands);
-      m_sidebandHistSetDSMC = new util::Categorized<Hist, int>((GetName() + "_DS_sideband").c_str(),
+      m_sidebandHistSetDSMC = new util::LazyCategorized<Hist, int>((GetName() + "_DS_sideband").c_str(),
               GetName().c_str(), util::SidebandCategories,
               GetBinVec(), mc_error_bands);
     }
 
     //Histograms to be filled
-    util::Categorized<Hist, int>* m_backgroundHists;
-    Hist* dataHist;
-    Hist* efficiencyNumerator;
-    Hist* efficiencyDenominator;
-    Hist* selectedSignalReco; //Effectively "true background subtracted" distribution for warping studies.
+    util::LazyCategorized<Hist, int>* m_backgroundHists = nullptr;
+    Hist* dataHist = nullptr;
+    Hist* efficiencyNumerator = nullptr;
+    Hist* efficiencyDenominator = nullptr;
+    Hist* selectedSignalReco = nullptr; //Effectively "true background subtracted" distribution for warping studies.
                               //Also useful for a bakground breakdown plot that you'd use to start background subtraction studies.
-    Hist* selectedMCReco; //Treat the MC CV just like data for the closure test
-    PlotUtils::Hist2DWrapper<CVUniverse>* migration;
+    Hist* selectedMCReco = nullptr; //Treat the MC CV just like data for the closure test
+    util::SparseMigration* migration = nullptr; //Converted to the usual MnvH2D by util::GetMigration() when it's read back
 
     //These histograms plot the events that we reconstruct as being WITHIN a nuclear target
     //For each US or DS plane we want a set of hists to store where it really came from
     //For each event reconstructed within an US plane we store the real event vertex 
-    util::Categorized<Hist, int>* m_sidebandHistSetUSMC; ////-
+    util::LazyCategorized<Hist, int>* m_sidebandHistSetUSMC = nullptr; ////-
     //For each event reconstructed within an DS plane we store the real event vertex 
-    util::Categorized<Hist, int>* m_sidebandHistSetDSMC; ////-
+    util::LazyCategorized<Hist, int>* m_sidebandHistSetDSMC = nullptr; ////-
 
     //For each US or DS plane in reco/data we want to save just the events we see
     //These histograms plot the events that we reconstruct as being UPSTREAM of a nuclear target
-    Hist* m_US_Sideband_Data; ////-
+    Hist* m_US_Sideband_Data = nullptr; ////-
     //These histograms plot the events that we reconstruct as being DOWNSTREAM of a nuclear target
-    Hist* m_DS_Sideband_Data; ////-
+    Hist* m_DS_Sideband_Data = nullptr; ////-
     //No equivalent for MC since we can simply get all the MC upstream and downstream events by summing the m_sidebandHistSetUSMC and m_sidebandHistSetDSMC 
     
+    //Set this for variables whose sideband histograms other programs expect, like the segment sidebands for the plastic sideband fit
+    bool requireSidebands = false;
+
     //These histograms plot the distrubution of interaction channels
-    util::Categorized<Hist, int>*  m_interactionTypeHists;
-    util::Categorized<Hist, int>* m_intChannelsEffDenom;
+    util::LazyCategorized<Hist, int>*  m_interactionTypeHists = nullptr;
+    util::LazyCategorized<Hist, int>* m_intChannelsEffDenom = nullptr;
 
     void InitializeDATAHists(std::vector<CVUniverse*>& data_error_bands)
     {
@@ -128,11 +134,7 @@ class Variable1DNuke: public PlotUtils::VariableBase<CVUniverse>
         efficiencyDenominator->hist->Write();
       }
 
-      if(migration)
-      {
-        migration->hist->SetDirectory(&file); 
-        migration->hist->Write();
-      }
+      if(migration) migration->Write(file);
 
       if(selectedSignalReco)
       {
@@ -170,6 +172,26 @@ class Variable1DNuke: public PlotUtils::VariableBase<CVUniverse>
                                 categ.hist->Write(); //TODO: Or let the TFile destructor do this the "normal" way?                                                                                           
                               });
 
+      //The cross section extraction reads every background and interaction channel category, so they have to be
+      //in the file even if they were never filled.  Sideband categories are only written if something filled them
+      //unless requireSidebands is set.  Each empty category has a histogram for every universe, so write them one
+      //at a time and free each one before making the next.
+      const auto writeEmpty = [&file](Hist& categ)
+                              {
+                                categ.SyncCVHistos();
+                                categ.hist->SetDirectory(&file);
+                                categ.hist->Write();
+                                delete categ.hist; //Also takes it out of file
+                                categ.hist = nullptr;
+                              };
+      m_backgroundHists->visitUnused(writeEmpty);
+      m_interactionTypeHists->visitUnused(writeEmpty);
+      m_intChannelsEffDenom->visitUnused(writeEmpty);
+      if(requireSidebands)
+      {
+        m_sidebandHistSetUSMC->visitUnused(writeEmpty);
+        m_sidebandHistSetDSMC->visitUnused(writeEmpty);
+      }
     }
 
     //Only call this manually if you Draw(), Add(), or Divide() plots in this
@@ -190,7 +212,45 @@ class Variable1DNuke: public PlotUtils::VariableBase<CVUniverse>
       if(efficiencyDenominator) efficiencyDenominator->SyncCVHistos();
       if(selectedSignalReco) selectedSignalReco->SyncCVHistos();
       if(selectedMCReco) selectedMCReco->SyncCVHistos();
-      if(migration) migration->SyncCVHistos();
+    }
+
+    //Upper bound on the bytes InitializeMCHists() and InitializeDATAHists() allocate, bin contents and errors for every universe,
+    //if every category ends up being filled.
+    //Used to decide how many targets' histograms fit in memory at once.  nUniverses count the CV too.
+    double EstimateHistBytes(const size_t nMCUniverses, const size_t nTruthUniverses, const size_t nDataUniverses)
+    {
+      const double cells = GetBinVec().size() + 1; //Including under/overflow
+      const double bytesPerUniverse = 2 * sizeof(double) * cells;
+      //Every LazyCategorized<> has an Other category on top of its labels
+      const double nMCHists = (util::BKGLabelsWithPlasticSidebands.size() + 1) + (util::GENIELabels.size() + 1)
+                              + 2 * (util::SidebandCategories.size() + 1) + 3;
+      const double nTruthHists = (util::GENIELabels.size() + 1) + 1;
+      const double nDataHists = 3;
+      const double migrationBytes = 2 * sizeof(double) * cells * cells * nMCUniverses; //If every cell of the SparseMigration were filled
+
+      return bytesPerUniverse * (nMCHists * nMCUniverses + nTruthHists * nTruthUniverses + nDataHists * nDataUniverses) + migrationBytes;
+    }
+
+    //Free this target's histograms so the next InitializeMCHists()/InitializeDATAHists() doesn't pile a new set on top of them.
+    //Call this after the files they were written to are Close()d.  TFile::Close() already deleted the MnvH1Ds themselves,
+    //so this only deletes the HistWrappers and LazyCategorized<>s around them.
+    void ReleaseHists()
+    {
+      for(auto categorized: {&m_backgroundHists, &m_sidebandHistSetUSMC, &m_sidebandHistSetDSMC, &m_interactionTypeHists, &m_intChannelsEffDenom})
+      {
+        if(*categorized) (*categorized)->deleteHists();
+        delete *categorized;
+        *categorized = nullptr;
+      }
+
+      for(auto hist: {&dataHist, &efficiencyNumerator, &efficiencyDenominator, &selectedSignalReco, &selectedMCReco, &m_US_Sideband_Data, &m_DS_Sideband_Data})
+      {
+        delete *hist;
+        *hist = nullptr;
+      }
+
+      delete migration;
+      migration = nullptr;
     }
 };
 
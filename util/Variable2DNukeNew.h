@@ -3,16 +3,18 @@
 
 #include "util/SafeROOTName.h"
 #include "PlotUtils/Variable2DBase.h"
-#include "util/Categorized.h"
+#include "util/LazyCategorized.h"
 #include "PlotUtils/HistWrapper.h"
-#include "PlotUtils/Hist2DWrapper.h"
+#include "util/DeltaHistWrapper.h"
+#include "PlotUtils/MnvH2D.h"
 #include "util/NukeUtils.h"
-#include "MinervaUnfold/MnvResponse.h"
+#include "util/SparseMigration.h"
 
 class Variable2DNuke: public PlotUtils::Variable2DBase<CVUniverse>
 {
   private:
-    typedef PlotUtils::Hist2DWrapper<CVUniverse> Hist;
+    //Universes are kept as residuals from the CV until WriteMC() because these variables have so many bins
+    typedef util::DeltaHistWrapper<PlotUtils::MnvH2D, CVUniverse> Hist;
   public:
     template <class ...ARGS>
     Variable2DNuke(ARGS... args): PlotUtils::Variable2DBase<CVUniverse>(args...)
@@ -25,15 +27,15 @@ class Variable2DNuke: public PlotUtils::Variable2DBase<CVUniverse>
                            std::map<std::string, std::vector<CVUniverse*>>& truth_error_bands)
     {
       
-      m_backgroundHists = new util::Categorized<Hist, int>((GetName() + "_by_BKG_Label").c_str(),
+      m_backgroundHists = new util::LazyCategorized<Hist, int>((GetName() + "_by_BKG_Label").c_str(),
               GetName().c_str(), util::BKGLabelsWithPlasticSidebands,
               GetBinVecX(), GetBinVecY(), mc_error_bands);
               
-      m_intChannelsEffDenom = new util::Categorized<Hist, int>((GetName() + "_efficiency_denominator_intChannels"),
+      m_intChannelsEffDenom = new util::LazyCategorized<Hist, int>((GetName() + "_efficiency_denominator_intChannels"),
               GetName().c_str(), util::GENIELabels,
               GetBinVecX(), GetBinVecY(), truth_error_bands);
 
-      m_interactionTypeHists = new util::Categorized<Hist, int>((GetName() + "_intType").c_str(),
+      m_interactionTypeHists = new util::LazyCategorized<Hist, int>((GetName() + "_intType").c_str(),
               GetName().c_str(), util::GENIELabels,
               GetBinVecX(), GetBinVecY(), mc_error_bands);
 
@@ -43,58 +45,51 @@ class Variable2DNuke: public PlotUtils::Variable2DBase<CVUniverse>
       selectedSignalReco = new Hist((GetName() + "_selected_signal_reco").c_str(), GetName().c_str(), GetBinVecX(), GetBinVecY(), mc_error_bands);
 
     
-      m_sidebandHistSetUSMC = new util::Categorized<Hist, int>((GetName() + "_US_sideband").c_str(),
+      m_sidebandHistSetUSMC = new util::LazyCategorized<Hist, int>((GetName() + "_US_sideband").c_str(),
               GetName().c_str(), util::SidebandCategories,
               GetBinVecX(), GetBinVecY(), mc_error_bands);
-      m_sidebandHistSetDSMC = new util::Categorized<Hist, int>((GetName() + "_DS_sideband").c_str(),
+      m_sidebandHistSetDSMC = new util::LazyCategorized<Hist, int>((GetName() + "_DS_sideband").c_str(),
               GetName().c_str(), util::SidebandCategories,
               GetBinVecX(), GetBinVecY(), mc_error_bands);
 
-      // taken from Noah
-      // make a temp universe map to make Response happy
-      std::map<const std::string, int> response_bands; // necessary?
-      for (auto band : mc_error_bands){
-        std::string name = band.first;
-        const std::string realname = (band.second)[0]->ShortName();
-        int nuniv = band.second.size();
-
-        response_bands[realname] = nuniv;
-      }
-
-      migration  = new MinervaUnfold::MnvResponse(GetName().c_str(),
-        GetName().c_str(),
-        GetBinVecX(), GetBinVecY(), response_bands);
+      //Only the filled cells of the 4D response are kept until the cross section extraction turns it back into an MnvResponse
+      const auto binsX = GetBinVecX(), binsY = GetBinVecY();
+      const TH2D binning(GetName().c_str(), GetName().c_str(), binsX.size() - 1, binsX.data(), binsY.size() - 1, binsY.data());
+      migration = new util::SparseMigration(GetName() + "_migration", binning, binning, mc_error_bands);
     }
 
     //Histograms to be filled
-    util::Categorized<Hist, int>* m_backgroundHists;
-    Hist* dataHist;  
-    Hist* efficiencyNumerator;
-    Hist* efficiencyDenominator;
-    Hist* selectedSignalReco; //Effectively "true background subtracted" distribution for warping studies.
+    util::LazyCategorized<Hist, int>* m_backgroundHists = nullptr;
+    Hist* dataHist = nullptr;  
+    Hist* efficiencyNumerator = nullptr;
+    Hist* efficiencyDenominator = nullptr;
+    Hist* selectedSignalReco = nullptr; //Effectively "true background subtracted" distribution for warping studies.
                               //Also useful for a bakground breakdown plot that you'd use to start background subtraction studies.
-    Hist* selectedMCReco; //Treat the MC CV just like data for the closure test
+    Hist* selectedMCReco = nullptr; //Treat the MC CV just like data for the closure test
 
-    MinervaUnfold::MnvResponse* migration;
+    util::SparseMigration* migration = nullptr; //Read back with util::GetMigrationObjects()
 
 
     //These histograms plot the events that we reconstruct as being WITHIN a nuclear target
     //For each US or DS plane we want a set of hists to store where it really came from
     //For each event reconstructed within an US plane we store the real event vertex 
-    util::Categorized<Hist, int>* m_sidebandHistSetUSMC; ////-
+    util::LazyCategorized<Hist, int>* m_sidebandHistSetUSMC = nullptr; ////-
     //For each event reconstructed within an DS plane we store the real event vertex 
-    util::Categorized<Hist, int>* m_sidebandHistSetDSMC; ////-
+    util::LazyCategorized<Hist, int>* m_sidebandHistSetDSMC = nullptr; ////-
 
     //For each US or DS plane in reco/data we want to save just the events we see
     //These histograms plot the events that we reconstruct as being UPSTREAM of a nuclear target
-    Hist* m_US_Sideband_Data; ////-
+    Hist* m_US_Sideband_Data = nullptr; ////-
     //These histograms plot the events that we reconstruct as being DOWNSTREAM of a nuclear target
-    Hist* m_DS_Sideband_Data; ////-
+    Hist* m_DS_Sideband_Data = nullptr; ////-
     //No equivalent for MC since we can simply get all the MC upstream and downstream events by summing the m_sidebandHistSetUSMC and m_sidebandHistSetDSMC 
     
+    //Set this for variables whose sideband histograms other programs expect, like the segment sidebands for the plastic sideband fit
+    bool requireSidebands = false;
+
     //These histograms plot the distrubution of interaction channels
-    util::Categorized<Hist, int>*  m_interactionTypeHists;
-    util::Categorized<Hist, int>* m_intChannelsEffDenom;
+    util::LazyCategorized<Hist, int>*  m_interactionTypeHists = nullptr;
+    util::LazyCategorized<Hist, int>* m_intChannelsEffDenom = nullptr;
 
     void InitializeDATAHists(std::vector<CVUniverse*>& data_error_bands)
     {
@@ -178,6 +173,27 @@ class Variable2DNuke: public PlotUtils::Variable2DBase<CVUniverse>
                                 categ.hist->SetDirectory(&file);
                                 categ.hist->Write(); //TODO: Or let the TFile destructor do this the "normal" way?                                                                                           
                               });
+
+      //The cross section extraction reads every background and interaction channel category, so they have to be
+      //in the file even if they were never filled.  Sideband categories are only written if something filled them
+      //unless requireSidebands is set.  Each empty category has a histogram for every universe, so write them one
+      //at a time and free each one before making the next.
+      const auto writeEmpty = [&file](Hist& categ)
+                              {
+                                categ.SyncCVHistos();
+                                categ.hist->SetDirectory(&file);
+                                categ.hist->Write();
+                                delete categ.hist; //Also takes it out of file
+                                categ.hist = nullptr;
+                              };
+      m_backgroundHists->visitUnused(writeEmpty);
+      m_interactionTypeHists->visitUnused(writeEmpty);
+      m_intChannelsEffDenom->visitUnused(writeEmpty);
+      if(requireSidebands)
+      {
+        m_sidebandHistSetUSMC->visitUnused(writeEmpty);
+        m_sidebandHistSetDSMC->visitUnused(writeEmpty);
+      }
     }
 
 
@@ -188,17 +204,7 @@ class Variable2DNuke: public PlotUtils::Variable2DBase<CVUniverse>
     {
       //SyncCVHistos();
       std::cout<<"Writing 2D migration matrices\n";
-      //file->cd();
-      MnvH2D* migration_hist = NULL;
-      MnvH2D* reco_hist = NULL;
-      MnvH2D* truth_hist = NULL;
-      migration->GetMigrationObjects(migration_hist, reco_hist, truth_hist);
-      migration_hist->SetDirectory(&file); 
-      migration_hist->Write();
-      reco_hist->SetDirectory(&file); 
-      reco_hist->Write();
-      truth_hist->SetDirectory(&file); 
-      truth_hist->Write();
+      migration->Write(file);
     }
 
 
@@ -222,8 +228,52 @@ class Variable2DNuke: public PlotUtils::Variable2DBase<CVUniverse>
       if(efficiencyDenominator) efficiencyDenominator->SyncCVHistos();
       if(selectedSignalReco) selectedSignalReco->SyncCVHistos();
       if(selectedMCReco) selectedMCReco->SyncCVHistos();
-      //if(migration) migration->SyncCVHistos();
-      //How to do this for a MnvResponse object?
+    }
+
+    //Upper bound on the bytes InitializeMCHists() and InitializeDATAHists() allocate, bin contents and errors for every universe,
+    //if every category ends up being filled.
+    //Used to decide how many targets' histograms fit in memory at once.  nUniverses count the CV too.  nLateral are how
+    //many of them are lateral.
+    double EstimateHistBytes(const size_t nMCUniverses, const size_t nTruthUniverses, const size_t nDataUniverses,
+                             const size_t nMCLateral, const size_t nTruthLateral)
+    {
+      const double cells = (GetBinVecX().size() + 1) * (GetBinVecY().size() + 1); //Including under/overflow
+      const double bytesPerCV = 2 * sizeof(double) * cells;
+      const double bytesPerUniverse = 2 * sizeof(float) * cells; //Residuals from the CV until SyncCVHistos()
+      const double bytesPerLateral = bytesPerCV; //Filled directly into their error bands
+      //Every LazyCategorized<> has an Other category on top of its labels
+      const double nMCHists = (util::BKGLabelsWithPlasticSidebands.size() + 1) + (util::GENIELabels.size() + 1)
+                              + 2 * (util::SidebandCategories.size() + 1) + 3;
+      const double nTruthHists = (util::GENIELabels.size() + 1) + 1;
+      const double nDataHists = 3;
+      const double migrationBytes = 2 * sizeof(double) * cells * cells * nMCUniverses; //If every cell of the SparseMigration were filled
+
+      //Data universes are all CVs
+      return nMCHists * (bytesPerCV + bytesPerUniverse * (nMCUniverses - 1 - nMCLateral) + bytesPerLateral * nMCLateral)
+             + nTruthHists * (bytesPerCV + bytesPerUniverse * (nTruthUniverses - 1 - nTruthLateral) + bytesPerLateral * nTruthLateral)
+             + nDataHists * bytesPerCV + migrationBytes;
+    }
+
+    //Free this target's histograms so the next InitializeMCHists()/InitializeDATAHists() doesn't pile a new set on top of them.
+    //Call this after the files they were written to are Close()d.  TFile::Close() already deleted the MnvH2Ds themselves,
+    //so this only deletes the HistWrappers and LazyCategorized<>s around them along with the SparseMigration.
+    void ReleaseHists()
+    {
+      for(auto categorized: {&m_backgroundHists, &m_sidebandHistSetUSMC, &m_sidebandHistSetDSMC, &m_interactionTypeHists, &m_intChannelsEffDenom})
+      {
+        if(*categorized) (*categorized)->deleteHists();
+        delete *categorized;
+        *categorized = nullptr;
+      }
+
+      for(auto hist: {&dataHist, &efficiencyNumerator, &efficiencyDenominator, &selectedSignalReco, &selectedMCReco, &m_US_Sideband_Data, &m_DS_Sideband_Data})
+      {
+        delete *hist;
+        *hist = nullptr;
+      }
+
+      delete migration;
+      migration = nullptr;
     }
 };
 